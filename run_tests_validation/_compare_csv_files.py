@@ -0,0 +1,48 @@
+#! /usr/bin/env python
+
+#
+# Compare two output files of SWEET (csv format) value by value
+#
+# Usage:
+#	_compare_csv_files.py [max abs difference] [file A] [file B]
+#
+# Returns with a non-zero exit code if the files differ by more
+# than the given difference or if their sizes differ.
+#
+
+import sys
+
+
+def load_values(filename):
+	values = []
+	with open(filename) as f:
+		for line in f:
+			line = line.strip()
+			if line == '' or line.startswith('#'):
+				continue
+			values += [float(v) for v in line.replace(',', ' ').split()]
+	return values
+
+
+if len(sys.argv) != 4:
+	print("Usage: "+sys.argv[0]+" [max abs difference] [file A] [file B]")
+	sys.exit(1)
+
+max_diff = float(sys.argv[1])
+
+a = load_values(sys.argv[2])
+b = load_values(sys.argv[3])
+
+if len(a) != len(b):
+	print("Number of values differs: "+str(len(a))+" vs. "+str(len(b)))
+	sys.exit(1)
+
+diff = 0
+for i in range(len(a)):
+	diff = max(diff, abs(a[i]-b[i]))
+
+if diff > max_diff:
+	print("Max abs difference "+str(diff)+" exceeds "+str(max_diff)+" for "+sys.argv[2]+" and "+sys.argv[3])
+	sys.exit(1)
+
+sys.exit(0)
@@ -0,0 +1,71 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for batch jobs"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+
+cd ..
+
+TMPDIR_TEST="$(mktemp -d)"
+
+# The jobs run with fewer threads than the standalone runs,
+# hence results are only compared up to rounding
+MAX_DIFF=1e-10
+
+echo
+echo "***********************************************"
+echo "TEST SWE sphere: three batch jobs with two thread teams vs. standalone runs"
+echo "***********************************************"
+make clean
+scons --program=swe_sph_and_rexi --threading=omp --gui=disable --plane-spectral-space=disable --sphere-spectral-space=enable
+
+# jobs 0 and 1 share the resolution and hence the group, job 2 has its own group
+JOB_ARGS=(
+	"-M 32 -C -0.001"
+	"-M 32 -C -0.002"
+	"-M 16 -C -0.002"
+)
+
+rm -f "$TMPDIR_TEST/jobs.txt"
+for j in 0 1 2; do
+	echo "# job $j" >> "$TMPDIR_TEST/jobs.txt"
+	echo "${JOB_ARGS[$j]} -O $TMPDIR_TEST/job${j}_%s_t%020.8f.csv" >> "$TMPDIR_TEST/jobs.txt"
+done
+
+EXEC="$(ls -1 ./build/swe_sph_and_rexi_*_release) -g 1 -H 1 -f 0 -a 1 -s 3 -t 0.01 -o 0.01 --nonlinear=0 --timestepping-method=1 --timestepping-order=4"
+echo "$EXEC --batch-jobs=$TMPDIR_TEST/jobs.txt --batch-teams=2"
+
+$EXEC --batch-jobs="$TMPDIR_TEST/jobs.txt" --batch-teams=2 > "$TMPDIR_TEST/batch.txt" || { cat "$TMPDIR_TEST/batch.txt"; exit 1; }
+cat "$TMPDIR_TEST/batch.txt" | grep -E "^Batch|^BATCH|^SPH config"
+
+grep -q "Batch thread teams: 2" "$TMPDIR_TEST/batch.txt" || { echo "Batch jobs were not run by two thread teams"; exit 1; }
+
+grep -q "^BATCH GROUP M32x32_.*: 2 jobs" "$TMPDIR_TEST/batch.txt" || { echo "Batch jobs 0 and 1 are not in the same group"; exit 1; }
+grep -q "^BATCH GROUP M16x16_.*: 1 jobs" "$TMPDIR_TEST/batch.txt" || { echo "Batch job 2 is not in its own group"; exit 1; }
+
+# the SPH configs are set up once per group
+[ "$(grep -c "^SPH config string" "$TMPDIR_TEST/batch.txt")" = "2" ] || { echo "Setup is not shared by the jobs of a group"; exit 1; }
+
+for j in 0 1 2; do
+	grep -q "BATCH JOB $j FINISHED" "$TMPDIR_TEST/batch.txt" || { echo "Batch job $j did not finish"; exit 1; }
+	ls "$TMPDIR_TEST"/job${j}_h_*.csv > /dev/null || { echo "No output of batch job $j"; exit 1; }
+
+	echo "$EXEC ${JOB_ARGS[$j]}"
+	$EXEC ${JOB_ARGS[$j]} -O "$TMPDIR_TEST/single${j}_%s_t%020.8f.csv" > /dev/null || exit 1
+
+	for f in "$TMPDIR_TEST"/single${j}_*.csv; do
+		./run_tests_validation/_compare_csv_files.py $MAX_DIFF "$f" "${f/single${j}_/job${j}_}" || { echo "Batch job $j differs from standalone run"; exit 1; }
+	done
+done
+
+rm -rf "$TMPDIR_TEST"
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
@@ -0,0 +1,65 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for checkpoint/restart"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+
+cd ..
+
+TMPDIR_TEST="$(mktemp -d)"
+
+echo
+echo "***********************************************"
+echo "TEST SWE SL-REXI: single run vs. checkpoint + restart"
+echo "***********************************************"
+make clean
+scons --program=swe_rexi --threading=omp --gui=disable --plane-spectral-space=enable --libfft=enable
+# The threaded REXI sum is bitwise reproducible with a fixed assignment of
+# poles to ranks. Rebalancing the poles between MPI ranks changes the
+# order of the sum, hence it's explicitly disabled.
+EXEC="$(ls -1 ./build/swe_rexi_*_release) -N 64 -s 2 -H 1 -g 1 -f 1 -C -0.01 -o 0.5 -v 1 --timestepping-mode=1 --nonlinear=1 --rexi-rebalance-ranks=0"
+echo "$EXEC"
+
+$EXEC -t 2 -O "$TMPDIR_TEST/single_%s_t%020.8f.csv" > /dev/null || exit 1
+$EXEC -t 1 -O "$TMPDIR_TEST/first_%s_t%020.8f.csv" --checkpoint-file="$TMPDIR_TEST/checkpoint.bin" > /dev/null || exit 1
+$EXEC -t 2 -O "$TMPDIR_TEST/restart_%s_t%020.8f.csv" --restart-file="$TMPDIR_TEST/checkpoint.bin" > /dev/null || exit 1
+
+ls "$TMPDIR_TEST"/restart_h_*.csv > /dev/null || { echo "No output of restarted run"; exit 1; }
+
+# restarted simulations have to be bitwise identical
+for f in "$TMPDIR_TEST"/restart_*.csv; do
+	cmp "$f" "${f/restart_/single_}" || { echo "Output file $f of single run and restarted run differ"; exit 1; }
+done
+
+
+echo
+echo "***********************************************"
+echo "TEST SWE sphere RK4: single run vs. checkpoint + restart"
+echo "***********************************************"
+make clean
+scons --program=swe_sph_and_rexi --threading=omp --gui=disable --plane-spectral-space=disable --sphere-spectral-space=enable
+EXEC="$(ls -1 ./build/swe_sph_and_rexi_*_release) -g 1 -H 1 -f 0 -a 1 -M 32 -s 3 -C -0.001 -o 0.05 --nonlinear=0 --timestepping-method=1 --timestepping-order=4"
+echo "$EXEC"
+
+$EXEC -t 0.1 -O "$TMPDIR_TEST/single_%s_t%020.8f.csv" > /dev/null || exit 1
+$EXEC -t 0.05 -O "$TMPDIR_TEST/first_%s_t%020.8f.csv" --checkpoint-file="$TMPDIR_TEST/checkpoint_sphere.bin" > /dev/null || exit 1
+$EXEC -t 0.1 -O "$TMPDIR_TEST/restart_%s_t%020.8f.csv" --restart-file="$TMPDIR_TEST/checkpoint_sphere.bin" > /dev/null || exit 1
+
+ls "$TMPDIR_TEST"/restart_h_*.csv > /dev/null || { echo "No output of restarted run"; exit 1; }
+
+# restarted simulations have to be bitwise identical
+for f in "$TMPDIR_TEST"/restart_*.csv; do
+	cmp "$f" "${f/restart_/single_}" || { echo "Output file $f of single run and restarted run differ"; exit 1; }
+done
+
+rm -rf "$TMPDIR_TEST"
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
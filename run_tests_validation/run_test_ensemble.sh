@@ -0,0 +1,44 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for SWE ensembles"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+
+cd ..
+
+TMPDIR_TEST="$(mktemp -d)"
+
+FILTER="DIAGNOSTICS ANALYTICAL"
+
+echo
+echo "***********************************************"
+echo "TEST SWE REXI: single run vs. unperturbed ensemble member"
+echo "***********************************************"
+make clean
+scons --program=swe_rexi --threading=omp --gui=disable --plane-spectral-space=enable --libfft=enable
+EXEC="$(ls -1 ./build/swe_rexi_*_release) -N 64 -s 2 -H 1 -g 1 -f 1 -C -0.01 -t 1 -v 0 --nonlinear=0 --timestepping-mode=2 --compute-error 1"
+echo "$EXEC"
+
+$EXEC | grep -E "$FILTER" > "$TMPDIR_TEST/single.txt" || exit 1
+$EXEC --ensemble-members=4 --ensemble-perturbation=1e-3 | grep -E "^\[0\] $FILTER" | sed -E 's/^\[0\] //' > "$TMPDIR_TEST/ensemble.txt" || exit 1
+
+# transformations in batches may differ in round-off errors
+paste "$TMPDIR_TEST/single.txt" "$TMPDIR_TEST/ensemble.txt" | awk -F'\t' '
+	{
+		d = $2-$4; if (d < 0) d = -d;
+		if (d > 1e-10) { print "Mismatch: " $0; err = 1 }
+	}
+	END { if (NR == 0) { print "No results"; err = 1 }; exit err }
+' || { echo "Results of single run and ensemble member differ"; exit 1; }
+
+rm -rf "$TMPDIR_TEST"
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
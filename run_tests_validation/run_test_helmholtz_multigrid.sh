@@ -0,0 +1,42 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for Helmholtz multigrid solver"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+cd ../
+
+echo
+echo "***********************************************"
+echo "TEST HELMHOLTZ MULTIGRID (release)"
+echo "***********************************************"
+make clean
+SCONS="scons --threading=omp --unit-test=test_helmholtz_multigrid --gui=disable --plane-spectral-space=disable --plane-spectral-dealiasing=disable --mode=release"
+echo "$SCONS"
+$SCONS
+
+EXEC="./build/test_helmholtz_multigrid_*_release -n 32 -m 32 -X 1 -Y 1"
+echo "$EXEC"
+$EXEC || exit 1
+
+echo
+echo "***********************************************"
+echo "TEST HELMHOLTZ MULTIGRID WITH SPECTRAL SPACE (release)"
+echo "***********************************************"
+make clean
+SCONS="scons --threading=omp --unit-test=test_helmholtz_multigrid --gui=disable --plane-spectral-space=enable --mode=release"
+echo "$SCONS"
+$SCONS
+
+EXEC="./build/test_helmholtz_multigrid_*_release -n 32 -m 32 -X 1 -Y 1"
+echo "$EXEC"
+$EXEC || exit 1
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
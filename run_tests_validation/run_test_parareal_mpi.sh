@@ -0,0 +1,51 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for MPI Parareal controller"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+
+cd ..
+
+TMPDIR_TEST="$(mktemp -d)"
+
+# filter output which has to be identical for serial and MPI controller
+# (output of different ranks is interleaved, hence it's sorted)
+FILTER="Solution|ERROR|convergence:|Convergence reached"
+PARAMS="-N 16 --parareal-fine-dt=0.0001 --parareal-enabled=1 --parareal-coarse-slices=10 -t 10 --parareal-max-simulation-time=10 --parareal-convergence-threshold=0.0001 --parareal-function-param-a=0.3 --parareal-function-param-b=1.0 --parareal-function-param-y0=0.123"
+
+echo
+echo "***********************************************"
+echo "TEST Parareal ODE: serial controller"
+echo "***********************************************"
+make clean
+scons --program=parareal_ode --parareal=serial --gui=disable --plane-spectral-space=disable
+EXEC="$(ls -1 ./build/parareal_ode_*_release) $PARAMS"
+echo "$EXEC"
+$EXEC | grep -E "$FILTER" | sed -E 's/^\[[0-9A-Z]+\] *//' | sort > "$TMPDIR_TEST/serial.txt" || exit 1
+
+
+echo
+echo "***********************************************"
+echo "TEST Parareal ODE: MPI controller"
+echo "***********************************************"
+make clean
+scons --program=parareal_ode --parareal=mpi --sweet-mpi=enable --gui=disable --plane-spectral-space=disable
+EXEC="$(ls -1 ./build/parareal_ode_*_release) $PARAMS"
+
+for NP in 1 2 3 10; do
+	echo "mpirun -n $NP $EXEC"
+	mpirun -n $NP $EXEC | grep -E "$FILTER" | sed -E 's/^\[[0-9A-Z]+\] *//' | sort > "$TMPDIR_TEST/mpi.txt" || exit 1
+	diff "$TMPDIR_TEST/serial.txt" "$TMPDIR_TEST/mpi.txt" || { echo "Results of serial and MPI controller differ for $NP ranks"; exit 1; }
+done
+
+rm -rf "$TMPDIR_TEST"
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
@@ -0,0 +1,55 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for threaded Parareal controller"
+echo "***********************************************"
+
+# spread time slices over the cores
+export OMP_PROC_BIND=spread,close
+
+
+cd ..
+
+TMPDIR_TEST="$(mktemp -d)"
+
+# filter output which has to be identical for serial and threaded controller
+FILTER="Solution|ERROR|convergence:|Convergence reached|Total energy"
+
+echo
+echo "***********************************************"
+echo "TEST Parareal ODE: serial vs. threaded controller"
+echo "***********************************************"
+make clean
+scons --program=parareal_ode --parareal=serial --threading=omp --gui=disable --plane-spectral-space=disable
+EXEC="$(ls -1 ./build/parareal_ode_*_release) -N 16 --parareal-fine-dt=0.0001 --parareal-enabled=1 --parareal-coarse-slices=10 -t 10 --parareal-max-simulation-time=10 --parareal-convergence-threshold=0.0001 --parareal-function-param-a=0.3 --parareal-function-param-b=1.0 --parareal-function-param-y0=0.123"
+echo "$EXEC"
+
+$EXEC --parareal-threaded=0 | grep -E "$FILTER" | sed -E 's/^\[[0-9A-Z]+\] ?//' > "$TMPDIR_TEST/ode_serial.txt" || exit 1
+$EXEC --parareal-threaded=1 | grep -E "$FILTER" | sed -E 's/^\[[0-9A-Z]+\] ?//' > "$TMPDIR_TEST/ode_threaded.txt" || exit 1
+diff "$TMPDIR_TEST/ode_serial.txt" "$TMPDIR_TEST/ode_threaded.txt" || { echo "Results of serial and threaded controller differ"; exit 1; }
+
+
+echo
+echo "***********************************************"
+echo "TEST Burgers: serial vs. threaded controller"
+echo "***********************************************"
+make clean
+scons --program=burgers --parareal=serial --threading=omp --gui=disable --plane-spectral-space=enable
+EXEC="$(ls -1 ./build/burgers_*_release) -N 32 -s 54 -u 0.1 -C -0.0001 --timestepping-method=1 --timestepping-order=4 --timestepping-method2=1 --timestepping-order2=1 -t 0.01 --parareal-enabled=1 --parareal-coarse-slices=8 --parareal-max-simulation-time=0.01 --parareal-convergence-threshold=1e-10"
+echo "$EXEC"
+
+$EXEC --parareal-threaded=0 -O "$TMPDIR_TEST/serial" | grep -E "$FILTER" | sed -E 's/^\[[0-9A-Z]+\] ?//' > "$TMPDIR_TEST/burgers_serial.txt" || exit 1
+$EXEC --parareal-threaded=1 -O "$TMPDIR_TEST/threaded" | grep -E "$FILTER" | sed -E 's/^\[[0-9A-Z]+\] ?//' > "$TMPDIR_TEST/burgers_threaded.txt" || exit 1
+diff "$TMPDIR_TEST/burgers_serial.txt" "$TMPDIR_TEST/burgers_threaded.txt" || { echo "Results of serial and threaded controller differ"; exit 1; }
+
+for f in "$TMPDIR_TEST"/serial_iter*.csv; do
+	cmp "$f" "${f/serial_iter/threaded_iter}" || { echo "Output file $f differs"; exit 1; }
+done
+
+rm -rf "$TMPDIR_TEST"
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
@@ -0,0 +1,51 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for REXI distributed over MPI ranks"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+
+cd ..
+
+TMPDIR_TEST="$(mktemp -d)"
+
+# The summation order of the REXI terms depends on the distribution
+# of the poles to the ranks, hence results are only compared up to rounding
+MAX_DIFF=1e-8
+
+echo
+echo "***********************************************"
+echo "TEST SWE REXI: single rank vs. several ranks with and without rebalancing of poles"
+echo "***********************************************"
+make clean
+scons --program=swe_rexi --sweet-mpi=enable --threading=omp --gui=disable --plane-spectral-space=enable --libfft=enable
+EXEC="$(ls -1 ./build/swe_rexi_*_release) -N 32 -s 2 -H 1 -g 1 -f 1 -C -0.1 -t 1 -o 0.5 -v 1 --timestepping-mode=1 --nonlinear=0"
+
+echo "mpirun -n 1 $EXEC"
+mpirun -n 1 $EXEC -O "$TMPDIR_TEST/ref_%s_t%020.8f.csv" > /dev/null || exit 1
+
+ls "$TMPDIR_TEST"/ref_h_*.csv > /dev/null || { echo "No output of reference run"; exit 1; }
+
+for NP in 2 3; do
+	for REBALANCE in 0 1; do
+		echo "mpirun -n $NP $EXEC --rexi-rebalance-ranks=$REBALANCE"
+		mpirun -n $NP $EXEC --rexi-rebalance-ranks=$REBALANCE -O "$TMPDIR_TEST/mpi_%s_t%020.8f.csv" > /dev/null || exit 1
+
+		for f in "$TMPDIR_TEST"/ref_*.csv; do
+			./run_tests_validation/_compare_csv_files.py $MAX_DIFF "$f" "${f/ref_/mpi_}" || { echo "Results differ for $NP ranks with rebalancing $REBALANCE"; exit 1; }
+		done
+
+		rm -f "$TMPDIR_TEST"/mpi_*.csv
+	done
+done
+
+rm -rf "$TMPDIR_TEST"
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
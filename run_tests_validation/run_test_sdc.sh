@@ -0,0 +1,27 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for SDC / PFASST"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+
+cd ..
+
+echo
+echo "***********************************************"
+echo "TEST SDC: convergence order and PFASST iterations"
+echo "***********************************************"
+make clean
+scons --unit-test=test_sdc --gui=disable
+EXEC="./build/test_sdc_*_release"
+echo "$EXEC"
+$EXEC || exit
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
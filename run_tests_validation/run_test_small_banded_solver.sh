@@ -0,0 +1,23 @@
+#! /bin/bash
+
+
+echo "***********************************************"
+echo "Running tests for small bandwidth solver"
+echo "***********************************************"
+
+# set close affinity of threads
+export OMP_PROC_BIND=close
+
+cd ../
+
+make clean
+SCONS="scons --unit-test=test_small_banded_solver --gui=disable --plane-spectral-space=disable --sphere-spectral-space=enable --mode=debug"
+echo "$SCONS"
+$SCONS
+
+./build/test_small_banded_solver*_debug || exit
+
+
+echo "***********************************************"
+echo "***************** FIN *************************"
+echo "***********************************************"
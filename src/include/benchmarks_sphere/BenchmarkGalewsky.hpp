@@ -12,6 +12,7 @@
 #include <sweet/SimulationVariables.hpp>
 #include <sweet/sphere/SphereDataConfig.hpp>
 #include <sweet/sphere/SphereData.hpp>
+#include <vector>
 
 class BenchmarkGalewsky
 {
@@ -47,18 +48,6 @@ public:
 
 
 private:
-	static BenchmarkGalewsky** getPtrT()
-	{
-		// use this static pointer to allow using an existing quadrature code
-		static BenchmarkGalewsky *t;
-		return &t;
-	}
-
-	static BenchmarkGalewsky* T()
-	{
-		return *getPtrT();
-	}
-
 	double initial_condition_u(double lon, double phi)
 	{
 		if (phi <= phi0 || phi >= phi1)
@@ -73,14 +62,12 @@ private:
 	};
 
 
-	static double to_int_fun(double phi)
+	double to_int_fun(double phi)
 	{
-		BenchmarkGalewsky* t = T();
+		double u_phi = initial_condition_u(0, phi);
 
-		double u_phi = t->initial_condition_u(0, phi);
-
-		return t->simVars.sim.earth_radius*u_phi*
-				(2.0*t->simVars.sim.coriolis_omega*std::sin(phi)+(std::tan(phi)/t->simVars.sim.earth_radius)*u_phi);
+		return simVars.sim.earth_radius*u_phi*
+				(2.0*simVars.sim.coriolis_omega*std::sin(phi)+(std::tan(phi)/simVars.sim.earth_radius)*u_phi);
 	};
 
 	double error_threshold = 1.e-13;
@@ -90,13 +77,12 @@ private:
 			double int_end
 	)
 	{
-#if 0
-		static AdaptiveIntegrator<double(const double)> integration_helper;
-		return integration_helper.integrate(to_int_fun, int_start, int_end, error_threshold);
-#else
-		return GaussQuadrature::integrate5_intervals_adaptive_linear<double>(int_start, int_end, to_int_fun, error_threshold);
-//		return GaussQuadrature::integrate5_intervals(int_start, int_end, to_int_fun, 5);
-#endif
+		return GaussQuadrature::integrate5_intervals_adaptive_linear<double>(
+				int_start,
+				int_end,
+				[this](double phi) -> double { return to_int_fun(phi); },
+				error_threshold
+			);
 	}
 
 
@@ -105,100 +91,68 @@ public:
 	{
 		assert(h_avg == 10000);
 
-		// use this static pointer to allow using an existing quadrature code
-		*getPtrT() = this;
 		const SphereDataConfig *sphereDataConfig = o_h.sphereDataConfig;
 
 
 		/*
-		 * Initialization of U and V
+		 * Initialization of H
+		 *
+		 * Metric correction terms based on John Thuburn's code
+		 */
+		const int nlat = sphereDataConfig->physical_num_lat;
+
+		/*
+		 * Boundaries of the integration intervals from the south to the north pole,
+		 * the inner boundaries are given by the Gaussian latitudes
+		 */
+		std::vector<double> int_bounds(nlat+2);
+		int_bounds[0] = -M_PI*0.5;
+		for (int k = 1; k <= nlat; k++)
+			int_bounds[k] = sphereDataConfig->lat[nlat-k];
+		int_bounds[nlat+1] = M_PI*0.5;
+
+		for (int k = 0; k <= nlat; k++)
+			assert(int_bounds[k+1] - int_bounds[k] > 0);
+
+		/*
+		 * The integrals over the intervals are independent of each other
+		 * and are computed in parallel.
 		 */
+		std::vector<double> int_values(nlat+1);
 
+#if SWEET_THREADING
+#pragma omp parallel for schedule(dynamic)
+#endif
+		for (int k = 0; k <= nlat; k++)
+			int_values[k] = integrate_fun(int_bounds[k], int_bounds[k+1]);
 
 		/*
-		 * Initialization of H
-		 *
-		 * Metric correction terms based on John Thuburn's code
+		 * Prefix sum over the intervals starting at the south pole,
+		 * the last interval ending at the north pole is only used for the average
 		 */
-		const unsigned short nlat = sphereDataConfig->physical_num_lat;
-		double *hg_cached =  new double[nlat];
+		std::vector<double> hg_cached(nlat);
 
 		double h_area = 0;
 		double hg_sum = 0;
-		double int_start, int_end, int_delta;
+		double hg = 0;
 
-		int j = sphereDataConfig->physical_num_lat-1;
-
-		// start/end of first integration interval
+		for (int k = 0; k <= nlat; k++)
 		{
-			assert(sphereDataConfig->lat[j] < 0);
-
-			// start at the south pole
-			int_start = -M_PI*0.5;
-			// first latitude gaussian point
-			int_end = sphereDataConfig->lat[j];
-			// 1d area of integration
-			int_delta = int_end - int_start;
-
-			assert(int_delta > 0);
-			assert(int_delta < 1);
+			hg -= int_values[k];
 
-			double hg = -integrate_fun(int_start, int_end);
-			//hg = (int_end+int_start)*0.5;
-			hg_cached[j] = hg;
+			if (k < nlat)
+				hg_cached[nlat-1-k] = hg;
 
 			/*
 			 * cos scaling is required for 2D sphere coverage at this latitude
 			 *
 			 * metric term which computes the area coverage of each point
 			 */
-			// use integrated average as below instead of the following formulation
-			// double mterm = cos((int_start+int_end)*0.5);
-			double mterm = (sin(int_end)-sin(int_start))*2.0*M_PI;
+			double mterm = (sin(int_bounds[k+1])-sin(int_bounds[k]))*2.0*M_PI;
 			assert(mterm > 0);
 
 			hg_sum += hg*mterm;
 			h_area += mterm;
-
-			int_start = int_end;
-		}
-		j--;
-
-		for (; j >= 0; j--)
-		{
-			double int_end = sphereDataConfig->lat[j];
-			int_delta = int_end - int_start;
-			assert(int_delta > 0);
-
-			double hg = hg_cached[j+1] - integrate_fun(int_start, int_end);
-			//hg = (int_end+int_start)*0.5;
-			hg_cached[j] = hg;
-
-			// metric term which computes the area coverage of each point
-			double mterm = (sin(int_end)-sin(int_start))*2.0*M_PI;
-
-			hg_sum += hg*mterm;
-			h_area += mterm;
-
-			// continue at the end of the last integration interval
-			int_start = int_end;
-		}
-
-		// last integration interval
-		{
-			assert(int_start > 0);
-			int_end = M_PI*0.5;
-
-			int_delta = int_end - int_start;
-			assert(int_delta > 0);
-
-			// metric term which computes the area coverage of each point
-			double mterm = (sin(int_end)-sin(int_start))*2.0*M_PI;
-
-			double hg = hg_cached[0] - integrate_fun(int_start, int_end);
-			//hg = (int_end+int_start)*0.5;
-			hg_sum += hg*mterm;
-			h_area += mterm;
 		}
 		assert(h_area > 0);
 
@@ -210,14 +164,13 @@ public:
 			hg_cached[j] = hg_cached[j]/simVars.sim.gravitation + (h_avg-h_comp_avg);
 
 		// update data
+		o_h.physical_alloc_buffer();
 		for (int i = 0; i < sphereDataConfig->physical_num_lon; i++)
 			for (int j = 0; j < sphereDataConfig->physical_num_lat; j++)
 				o_h.physical_space_data[i*sphereDataConfig->physical_num_lat + j] = hg_cached[j];
 
 		o_h.physical_space_data_valid = true;
 		o_h.spectral_space_data_valid = false;
-
-		delete [] hg_cached;
 	}
 
 
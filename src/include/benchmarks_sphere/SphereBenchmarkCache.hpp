@@ -0,0 +1,300 @@
+/*
+ * SphereBenchmarkCache.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_BENCHMARKS_SPHERE_SPHEREBENCHMARKCACHE_HPP_
+#define SRC_INCLUDE_BENCHMARKS_SPHERE_SPHEREBENCHMARKCACHE_HPP_
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <unistd.h>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/sphere/SphereData.hpp>
+
+
+
+/**
+ * Cache for generated initial conditions of benchmarks on the sphere
+ *
+ * Some initial conditions (e.g. the balanced height of the Galewsky benchmark)
+ * require numerical integrations which take a significant amount of time
+ * for high resolutions. These have to be computed for each simulation instance,
+ * e.g. for each ensemble member or Parareal time slice.
+ *
+ * The physical data of the h, u, v fields is cached
+ *  - in memory for the lifetime of the process and
+ *  - optionally in binary files in a cache directory,
+ *    storing the fields as raw binary double values one after the other.
+ *
+ * All parameters which have an influence on the initial conditions
+ * are part of the key.
+ */
+class SphereBenchmarkCache
+{
+public:
+	class Key
+	{
+	public:
+		int benchmark_scenario_id;
+		int physical_num_lon;
+		int physical_num_lat;
+
+		double coriolis_omega;
+		double gravitation;
+		double earth_radius;
+		double h0;
+
+		Key(
+				const SimulationVariables &i_simVars,
+				const SphereDataConfig *i_sphereDataConfig
+		)
+		{
+			// avoid uninitialized padding bytes in memcmp/hash
+			std::memset(this, 0, sizeof(Key));
+
+			benchmark_scenario_id = i_simVars.setup.benchmark_scenario_id;
+			physical_num_lon = i_sphereDataConfig->physical_num_lon;
+			physical_num_lat = i_sphereDataConfig->physical_num_lat;
+
+			coriolis_omega = i_simVars.sim.coriolis_omega;
+			gravitation = i_simVars.sim.gravitation;
+			earth_radius = i_simVars.sim.earth_radius;
+			h0 = i_simVars.sim.h0;
+		}
+
+		bool operator==(const Key &i_key)	const
+		{
+			// compare bitwise to avoid any rounding issues
+			return std::memcmp(this, &i_key, sizeof(Key)) == 0;
+		}
+
+
+		/**
+		 * FNV-1a hash of the key
+		 */
+		uint64_t hash()	const
+		{
+			uint64_t hash = 14695981039346656037ULL;
+
+			const unsigned char *d = (const unsigned char*)this;
+			for (std::size_t i = 0; i < sizeof(Key); i++)
+			{
+				hash ^= d[i];
+				hash *= 1099511628211ULL;
+			}
+
+			return hash;
+		}
+	};
+
+
+private:
+	class Entry
+	{
+	public:
+		Key key;
+		std::vector<double> data;
+	};
+
+	std::vector<Entry> entries;
+
+	static
+	SphereBenchmarkCache& getSingletonRef()
+	{
+		static SphereBenchmarkCache cache;
+		return cache;
+	}
+
+
+	/**
+	 * Return the filename of the cache file for the given key
+	 */
+	static
+	std::string p_getCacheFilename(
+			const std::string &i_cache_directory,
+			const Key &i_key
+	)
+	{
+		std::ostringstream ss;
+		ss << i_cache_directory << "/sphere_benchmark" << i_key.benchmark_scenario_id << "_" << i_key.physical_num_lon << "x" << i_key.physical_num_lat << "_";
+		ss << std::hex << i_key.hash() << ".bin";
+		return ss.str();
+	}
+
+
+	static
+	bool p_loadFile(
+			const std::string &i_filename,
+			std::vector<double> &io_data
+	)
+	{
+		std::ifstream file(i_filename, std::ios::binary);
+		if (!file)
+			return false;
+
+		file.seekg(0, std::ios::end);
+		std::size_t size = file.tellg();
+		file.seekg(0, std::ios::beg);
+
+		if (size != io_data.size()*sizeof(double))
+		{
+			std::cerr << "WARNING: Ignoring invalid benchmark cache file " << i_filename << std::endl;
+			return false;
+		}
+
+		return (bool)file.read((char*)io_data.data(), size);
+	}
+
+
+	/**
+	 * Write data to file.
+	 *
+	 * The data is first written to a temporary file which is then renamed.
+	 * This avoids reading partially written files from other processes.
+	 */
+	static
+	void p_writeFile(
+			const std::string &i_filename,
+			const std::vector<double> &i_data
+	)
+	{
+		std::ostringstream ss;
+		ss << i_filename << ".tmp." << getpid();
+		std::string tmp_filename = ss.str();
+
+		bool ok;
+		{
+			std::ofstream file(tmp_filename, std::ios::binary | std::ios::trunc);
+			file.write((const char*)i_data.data(), i_data.size()*sizeof(double));
+			ok = file.good();
+		}
+
+		if (ok)
+			ok = std::rename(tmp_filename.c_str(), i_filename.c_str()) == 0;
+
+		if (!ok)
+		{
+			std::cerr << "WARNING: Unable to write benchmark cache file " << i_filename << std::endl;
+			std::remove(tmp_filename.c_str());
+		}
+	}
+
+
+public:
+	/**
+	 * Lookup initial conditions in the in-memory cache and, if not available,
+	 * in the cache directory.
+	 *
+	 * \return true if the initial conditions were found
+	 */
+	static
+	bool load(
+			const Key &i_key,
+			const std::string &i_cache_directory,
+			SphereData &o_h,
+			SphereData &o_u,
+			SphereData &o_v
+	)
+	{
+		SphereBenchmarkCache &c = getSingletonRef();
+
+		std::size_t N = o_h.sphereDataConfig->physical_array_data_number_of_elements;
+		std::vector<double> data;
+		bool found = false;
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp critical (SphereBenchmarkCache)
+#endif
+		{
+			for (auto &e : c.entries)
+			{
+				if (!(e.key == i_key))
+					continue;
+
+				data = e.data;
+				found = true;
+				break;
+			}
+
+			if (!found && i_cache_directory != "")
+			{
+				data.resize(3*N);
+				found = p_loadFile(p_getCacheFilename(i_cache_directory, i_key), data);
+
+				if (found)
+					c.entries.push_back(Entry{i_key, data});
+			}
+		}
+
+		if (!found)
+			return false;
+
+		SphereData* fields[3] = {&o_h, &o_u, &o_v};
+		for (int i = 0; i < 3; i++)
+		{
+			fields[i]->physical_alloc_buffer();
+			std::memcpy(fields[i]->physical_space_data, data.data()+i*N, N*sizeof(double));
+			fields[i]->physical_space_data_valid = true;
+			fields[i]->spectral_space_data_valid = false;
+		}
+
+		return true;
+	}
+
+
+	/**
+	 * Store initial conditions in the in-memory cache and in the cache directory
+	 */
+	static
+	void store(
+			const Key &i_key,
+			const std::string &i_cache_directory,
+			const SphereData &i_h,
+			const SphereData &i_u,
+			const SphereData &i_v
+	)
+	{
+		SphereBenchmarkCache &c = getSingletonRef();
+
+		std::size_t N = i_h.sphereDataConfig->physical_array_data_number_of_elements;
+
+		std::vector<double> data(3*N);
+		const SphereData* fields[3] = {&i_h, &i_u, &i_v};
+		for (int i = 0; i < 3; i++)
+		{
+			fields[i]->request_data_physical();
+			std::memcpy(data.data()+i*N, fields[i]->physical_space_data, N*sizeof(double));
+		}
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp critical (SphereBenchmarkCache)
+#endif
+		{
+			bool found = false;
+			for (auto &e : c.entries)
+				if (e.key == i_key)
+					found = true;
+
+			if (!found)
+			{
+				c.entries.push_back(Entry{i_key, data});
+
+				if (i_cache_directory != "")
+					p_writeFile(p_getCacheFilename(i_cache_directory, i_key), data);
+			}
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_BENCHMARKS_SPHERE_SPHEREBENCHMARKCACHE_HPP_ */
@@ -13,6 +13,7 @@
 #include <sweet/SimulationVariables.hpp>
 #include <benchmarks_sphere/BenchmarkGalewsky.hpp>
 #include <benchmarks_sphere/BenchmarkGaussianDam.hpp>
+#include <benchmarks_sphere/SphereBenchmarkCache.hpp>
 
 class SphereBenchmarksCombined
 {
@@ -49,12 +50,20 @@ public:
 		}
 		else if (io_simVars.setup.benchmark_scenario_id == 1)
 		{
-			benchmarkGalewsky.setup_initial_h(o_h);
-//			o_h.spat_set_zero();
-			benchmarkGalewsky.setup_initial_h_add_bump(o_h);
+			// the initial conditions depend on the parameters before they are overridden below
+			SphereBenchmarkCache::Key key(io_simVars, o_h.sphereDataConfig);
 
-			benchmarkGalewsky.setup_initial_u(o_u);
-			benchmarkGalewsky.setup_initial_v(o_v);
+			if (!SphereBenchmarkCache::load(key, io_simVars.setup.benchmark_cache_dir, o_h, o_u, o_v))
+			{
+				benchmarkGalewsky.setup_initial_h(o_h);
+//				o_h.spat_set_zero();
+				benchmarkGalewsky.setup_initial_h_add_bump(o_h);
+
+				benchmarkGalewsky.setup_initial_u(o_u);
+				benchmarkGalewsky.setup_initial_v(o_v);
+
+				SphereBenchmarkCache::store(key, io_simVars.setup.benchmark_cache_dir, o_h, o_u, o_v);
+			}
 
 			std::cout << "!!! WARNING !!!" << std::endl;
 			std::cout << "!!! WARNING: Overriding simulation parameters for this benchmark !!!" << std::endl;
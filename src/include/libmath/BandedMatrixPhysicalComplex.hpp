@@ -8,6 +8,8 @@
 #ifndef SRC_INCLUDE_SPH_SPHMATRIX_COMPLEX_HPP_
 #define SRC_INCLUDE_SPH_SPHMATRIX_COMPLEX_HPP_
 
+#include <vector>
+#include <algorithm>
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/sphere/SphereDataConfig.hpp>
 
@@ -34,29 +36,75 @@ class BandedMatrixPhysicalComplex
 	 *
 	 * The the Vector P is given by
 	 *   P = (P_0^0, P_1^0, P_2^0, P_3^0, P_1^1, P_2^1, P_3^1, P_2^2, P_3^2, P_3^3)^T
+	 *
+	 * Each block is directly stored in the LAPACK general band storage
+	 * (column-major, see zgbtrf) with KL=KU=halosize_off_diagonal and
+	 * LDAB=2*KL+KU+1. The first KL rows are workspace for the fill-in of the
+	 * LU decomposition. Hence, a block can be directly handed over to LAPACK.
+	 *
+	 * Element (i,j) of a block is stored at AB[(KL+KU+i-j) + j*LDAB].
+	 *
+	 * Each block starts at a 64 byte aligned address.
 	 */
 public:
 	T *data;
 
-public:
 	/**
-	 * Data storage format for Fortran
+	 * Size of data in bytes
+	 */
+	std::size_t data_size;
+
+	/**
+	 * Offset of the block for mode m in data, stored at index m+m_max
 	 */
-	T *fortran_data;
+	std::vector<std::size_t> block_offset;
 
 public:
 	int halosize_off_diagonal;
 	int num_diagonals;
 
+	/**
+	 * Leading dimension of the band storage
+	 */
+	int LDAB;
+
 	SphereDataConfig *sphConfig;
 
 
+public:
+	/**
+	 * Zero-copy view to the band storage of a single block
+	 */
+	class BlockView
+	{
+	public:
+		T *AB;			///< band storage
+		int size;		///< number of rows and columns
+		int kl;			///< number of subdiagonals
+		int ku;			///< number of superdiagonals
+		int LDAB;		///< leading dimension of AB
+
+		/**
+		 * Return element (i,j) of this block
+		 */
+		T &operator()(int i, int j)	const
+		{
+			assert(i >= 0 && i < size);
+			assert(j >= 0 && j < size);
+			assert(j-ku <= i && i <= j+kl);
+
+			return AB[(kl+ku+i-j) + j*LDAB];
+		}
+	};
+
+
 public:
 	BandedMatrixPhysicalComplex()	:
 		data(nullptr),
-		fortran_data(nullptr),
+		data_size(0),
 		halosize_off_diagonal(-1),
 		num_diagonals(-1),
+		LDAB(-1),
 		sphConfig(nullptr)
 	{
 	}
@@ -67,7 +115,9 @@ public:
 	 */
 	void zeroAll()
 	{
-		for (int i = 0; i < sphConfig->spectral_complex_array_data_number_of_elements*num_diagonals; i++)
+		std::size_t num_elements = data_size/sizeof(T);
+
+		for (std::size_t i = 0; i < num_elements; i++)
 			data[i] = T(0);
 	}
 
@@ -87,28 +137,75 @@ public:
 
 		halosize_off_diagonal = i_halosize_offdiagonal;
 		num_diagonals = 2*halosize_off_diagonal+1;
+		LDAB = 3*halosize_off_diagonal+1;
+
+		/*
+		 * Align each block to 64 bytes
+		 */
+		std::size_t align = std::max<std::size_t>(1, 64/sizeof(T));
 
-		data = MemBlockAlloc::alloc<T>( sizeof(T)*sphConfig->spectral_complex_array_data_number_of_elements*num_diagonals );
+		block_offset.resize(2*sphConfig->spectral_modes_m_max+1);
+
+		std::size_t offset = 0;
+		for (int m = -sphConfig->spectral_modes_m_max; m <= sphConfig->spectral_modes_m_max; m++)
+		{
+			block_offset[m+sphConfig->spectral_modes_m_max] = offset;
+
+			std::size_t size = (std::size_t)LDAB*(sphConfig->spectral_modes_n_max+1-std::abs(m));
+			offset += (size+align-1)/align*align;
+		}
+
+		data_size = sizeof(T)*offset;
+		data = MemBlockAlloc::alloc<T>(data_size);
 
 		zeroAll();
 	}
 
 
 
+	/**
+	 * Return view to the band storage of the block for mode m
+	 */
+	BlockView getBlockView(
+			int m		///< Fourier mode m
+	)	const
+	{
+		BlockView v;
+		v.AB = data + block_offset[m+sphConfig->spectral_modes_m_max];
+		v.size = sphConfig->spectral_modes_n_max+1-std::abs(m);
+		v.kl = halosize_off_diagonal;
+		v.ku = halosize_off_diagonal;
+		v.LDAB = LDAB;
+		return v;
+	}
+
+
+
 	/**
 	 * Return matrix row  which is related to the specified modes
+	 *
+	 * The returned pointer points to the diagonal element.
+	 * Elements of the row are accessed with the rowElement_* methods.
 	 */
 	T *getMatrixRow(
 			int n,		///< row related to P Legendre mode n
 			int m		///< row related to P Fourier mode n
 	)
 	{
-		std::size_t idx = sphConfig->getArrayIndexByModes_Complex_NCompact(n, m);
-		return data+idx*num_diagonals;
+		int j = n-std::abs(m);
+		return data + block_offset[m+sphConfig->spectral_modes_m_max] + 2*halosize_off_diagonal + (std::size_t)j*LDAB;
 	}
 
 
 
+	/**
+	 * Return the offset between two consecutive elements in a row
+	 */
+	int rowElementStride()	const
+	{
+		return LDAB-1;
+	}
+
 
 
 	/**
@@ -135,11 +232,9 @@ public:
 		if (n < 0 || n < std::abs(i_row_m) || n > sphConfig->spectral_modes_n_max)
 			return dummy;
 
-		int idx = rel_n + halosize_off_diagonal;
+		assert(std::abs(rel_n) <= halosize_off_diagonal);
 
-		assert(idx >= 0 && idx < num_diagonals);
-
-		return io_row[idx];
+		return io_row[rel_n*rowElementStride()];
 	}
 
 
@@ -164,14 +259,12 @@ public:
 
 		int n = i_row_n+rel_n;
 
-		if (n < 0 || n < i_row_m || n > sphConfig->spectral_modes_n_max)
+		if (n < 0 || n < std::abs(i_row_m) || n > sphConfig->spectral_modes_n_max)
 			return;
 
-		int idx = rel_n + halosize_off_diagonal;
-
-		assert(idx >= 0 && idx < num_diagonals);
+		assert(std::abs(rel_n) <= halosize_off_diagonal);
 
-		io_row[idx] = i_value;
+		io_row[rel_n*rowElementStride()] = i_value;
 	}
 
 
@@ -195,14 +288,12 @@ public:
 
 		int n = i_row_n+rel_n;
 
-		if (n < 0 || n < i_row_m || n > sphConfig->spectral_modes_n_max)
+		if (n < 0 || n < std::abs(i_row_m) || n > sphConfig->spectral_modes_n_max)
 			return;
 
-		int idx = rel_n + halosize_off_diagonal;
-
-		assert(idx >= 0 && idx < num_diagonals);
+		assert(std::abs(rel_n) <= halosize_off_diagonal);
 
-		io_row[idx] += i_value;
+		io_row[rel_n*rowElementStride()] += i_value;
 	}
 
 
@@ -210,14 +301,9 @@ public:
 	{
 		if (data != nullptr)
 		{
-			MemBlockAlloc::free(data, sizeof(T)*sphConfig->spectral_complex_array_data_number_of_elements*num_diagonals);
+			MemBlockAlloc::free(data, data_size);
 			data = nullptr;
-		}
-
-		if (fortran_data != nullptr)
-		{
-			MemBlockAlloc::free(fortran_data, sizeof(T)*sphConfig->spectral_complex_array_data_number_of_elements*num_diagonals);
-			fortran_data = nullptr;
+			data_size = 0;
 		}
 	}
 
@@ -230,141 +316,44 @@ public:
 
 
 
-	void convertToFortranArray()
-	{
-		if (fortran_data == nullptr)
-			fortran_data = MemBlockAlloc::alloc<T>(sizeof(T)*sphConfig->spectral_complex_array_data_number_of_elements*num_diagonals);
-
-		for (int j = 0; j < sphConfig->spectral_complex_array_data_number_of_elements; j++)
-			for (int i = 0; i < num_diagonals; i++)
-				fortran_data[i*sphConfig->spectral_complex_array_data_number_of_elements + j] = data[j*num_diagonals + i];
-	}
-
-
-
 	void print()
 	{
-		std::size_t idx = 0;
 		for (int m = -sphConfig->spectral_modes_m_max; m <= sphConfig->spectral_modes_m_max; m++)
-		{
-			std::cout << "Meridional block M=" << m << " with N=[" << m << ", " << sphConfig->spectral_modes_n_max << "]" << std::endl;
-
-			for (int n = std::abs(m); n <= sphConfig->spectral_modes_n_max; n++)
-			{
-				if (n == m)
-				{
-					for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
-					{
-						std::cout << hn;
-						if (hn != n+halosize_off_diagonal)
-							std::cout << "\t";
-					}
-					std::cout << std::endl;
-					for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
-					{
-						std::cout << "*******";
-						if (hn != n+halosize_off_diagonal)
-							std::cout << "\t";
-					}
-					std::cout << std::endl;
-				}
-
-				for (int i = 0; i < num_diagonals; i++)
-				{
-					std::cout << data[idx*num_diagonals+i];
-					if (i != num_diagonals-1)
-						std::cout << "\t";
-				}
-				std::cout << std::endl;
-
-				idx++;
-			}
-		}
+			print_mblock(m);
 	}
 
 	void print_mblock(int m)
 	{
-//		std::size_t idx = 0;
-//		for (int m = 0; m <= sphConfig->spec_m_max; m++)
-		{
-			std::size_t idx = sphConfig->getArrayIndexByModes_Complex_NCompact(std::abs(m), m);
-			std::cout << "Meridional block M=" << m << " with N=[" << m << ", " << sphConfig->spectral_modes_n_max << "]" << std::endl;
+		std::cout << "Meridional block M=" << m << " with N=[" << m << ", " << sphConfig->spectral_modes_n_max << "]" << std::endl;
 
-			for (int n = std::abs(m); n <= sphConfig->spectral_modes_n_max; n++)
+		for (int n = std::abs(m); n <= sphConfig->spectral_modes_n_max; n++)
+		{
+			if (n == std::abs(m))
 			{
-				if (n == m)
-				{
-					for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
-					{
-						std::cout << hn;
-						if (hn != n+halosize_off_diagonal)
-							std::cout << "\t";
-					}
-					std::cout << std::endl;
-					for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
-					{
-						std::cout << "*******";
-						if (hn != n+halosize_off_diagonal)
-							std::cout << "\t";
-					}
-					std::cout << std::endl;
-				}
-
-				for (int i = 0; i < num_diagonals; i++)
+				for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
 				{
-					std::cout << data[idx*num_diagonals+i];
-					if (i != num_diagonals-1)
+					std::cout << hn;
+					if (hn != n+halosize_off_diagonal)
 						std::cout << "\t";
 				}
 				std::cout << std::endl;
-
-				idx++;
-			}
-		}
-	}
-
-
-
-	void printFortran()
-	{
-		assert(fortran_data != nullptr);
-
-		std::size_t idx = 0;
-		for (int m = -sphConfig->spectral_modes_m_max; m <= sphConfig->spectral_modes_m_max; m++)
-		{
-			std::cout << "Meridional block M=" << m << " with N=[" << m << ", " << sphConfig->spectral_modes_n_max << "]" << std::endl;
-
-			for (int n = std::abs(m); n <= sphConfig->spectral_modes_n_max; n++)
-			{
-				if (n == std::abs(m))
+				for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
 				{
-					for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
-					{
-						std::cout << hn;
-						if (hn != n+halosize_off_diagonal)
-							std::cout << "\t";
-					}
-
-					std::cout << std::endl;
-					for (int hn = n-halosize_off_diagonal; hn < n+halosize_off_diagonal+1; hn++)
-					{
-						std::cout << "*******";
-						if (hn != n+halosize_off_diagonal)
-							std::cout << "\t";
-					}
-					std::cout << std::endl;
-				}
-
-				for (int i = 0; i < num_diagonals; i++)
-				{
-					std::cout << fortran_data[idx+i*sphConfig->spectral_complex_array_data_number_of_elements];
-					if (i != num_diagonals-1)
+					std::cout << "*******";
+					if (hn != n+halosize_off_diagonal)
 						std::cout << "\t";
 				}
 				std::cout << std::endl;
+			}
 
-				idx++;
+			T *row = getMatrixRow(n, m);
+			for (int i = -halosize_off_diagonal; i <= halosize_off_diagonal; i++)
+			{
+				std::cout << rowElement_getRef(row, n, m, i);
+				if (i != halosize_off_diagonal)
+					std::cout << "\t";
 			}
+			std::cout << std::endl;
 		}
 	}
 };
@@ -71,6 +71,31 @@ extern "C"
 			const int &LDB,
 			int &INFO
 	);
+
+	void zgbtrf_(
+			const int &M,
+			const int &N,
+			const int &KL,
+			const int &KU,
+			std::complex<double> *AB,
+			const int &LDAB,
+			int *IPIV,
+			int &INFO
+	);
+
+	void zgbtrs_(
+			const char *TRANS,
+			const int &N,
+			const int &KL,
+			const int &KU,
+			const int &NRHS,
+			const std::complex<double> *AB,
+			const int &LDAB,
+			const int *IPIV,
+			std::complex<double> *B,
+			const int &LDB,
+			int &INFO
+	);
 #if 0
 	void zlapmr_(
 			int &forward,
@@ -219,6 +244,62 @@ class LapackBandedMatrixSolver<std::complex<double>>	:
 {
 	typedef std::complex<double> T;
 
+public:
+	/**
+	 * Compute the LU decomposition of a matrix which is already given
+	 * in the LAPACK band storage with KL additional rows (see zgbtrf).
+	 *
+	 * The decomposition is computed in place.
+	 *
+	 * \return false if the matrix is singular
+	 */
+	static
+	bool factorize_BandedLapackArray_inplace(
+		std::complex<double>* io_AB,	///< band storage, overwritten with LU decomposition
+		int i_LDAB,						///< leading dimension, at least 2*KL+KU+1
+		int i_size,						///< size of matrix
+		int i_kl,						///< number of subdiagonals
+		int i_ku,						///< number of superdiagonals
+		int *o_IPIV						///< pivot indices, i_size values
+	)
+	{
+		assert(i_LDAB >= 2*i_kl+i_ku+1);
+
+		int info;
+		zgbtrf_(i_size, i_size, i_kl, i_ku, io_AB, i_LDAB, o_IPIV, info);
+
+		return info == 0;
+	}
+
+
+
+	/**
+	 * Solve with a LU decomposition computed by factorize_BandedLapackArray_inplace()
+	 */
+	static
+	void solve_BandedLapackArray_factorized(
+		const std::complex<double>* i_LU,	///< LU decomposition in band storage
+		int i_LDAB,							///< leading dimension
+		int i_size,							///< size of matrix
+		int i_kl,							///< number of subdiagonals
+		int i_ku,							///< number of superdiagonals
+		const int *i_IPIV,					///< pivot indices
+		std::complex<double>* io_b_x		///< rhs and solution x
+	)
+	{
+		int info;
+		zgbtrs_("N", i_size, i_kl, i_ku, 1, i_LU, i_LDAB, i_IPIV, io_b_x, i_size, info);
+
+		if (info != 0)
+		{
+			std::cerr << "zgbtrs returned INFO != 0: " << info << std::endl;
+			assert(false);
+			exit(1);
+		}
+	}
+
+
+
 	/**
 	 * Solve for input matrix
 	 *
@@ -0,0 +1,338 @@
+/*
+ * SmallBandedMatrixSolver.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_LIBMATH_SMALLBANDEDMATRIXSOLVER_HPP_
+#define SRC_INCLUDE_LIBMATH_SMALLBANDEDMATRIXSOLVER_HPP_
+
+#include <complex>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+
+/**
+ * Solver for banded matrices with a small bandwidth (up to 4 off-diagonals)
+ *
+ * The matrices are given in the LAPACK general band storage
+ * (see BandedMatrixPhysicalComplex): Element (i,j) is stored
+ * at AB[(KL+KU+i-j) + j*LDAB].
+ *
+ * Many of the SPH matrices only couple modes n and n+-2.
+ * Then, the system decouples into two independent chains (even and odd rows)
+ * which are solved separately by using a stride of 2.
+ * With a bandwidth of 1 within a chain this is the Thomas algorithm.
+ *
+ * The LU decomposition is computed once without pivoting and stored
+ * in a separate array. If a pivot element is (close to) zero or
+ * the elimination leads to a large pivot growth,
+ * the factorization of this block is reported as failed and a
+ * pivoting solver (e.g. LAPACK) has to be used.
+ */
+template <typename T>
+class SmallBandedMatrixSolver
+{
+	/// real type of the magnitude of T, e.g. float for std::complex<float>
+	typedef decltype(std::abs(T())) TMag;
+
+
+	/**
+	 * Relative size of a pivot below which it's considered to be zero
+	 */
+	static
+	TMag p_pivotTolerance()
+	{
+		return TMag(500)*std::numeric_limits<TMag>::epsilon();
+	}
+
+
+	/**
+	 * Maximum growth of the entries of U relative to the entries of the matrix.
+	 * With a larger growth, about half of the digits would be lost.
+	 */
+	static
+	TMag p_maxPivotGrowth()
+	{
+		return TMag(1)/std::sqrt(std::numeric_limits<TMag>::epsilon());
+	}
+
+	/**
+	 * Return element (j,j+d) of the band storage
+	 */
+	static
+	const T &p_element(
+			const T *i_AB,
+			int i_LDAB,
+			int i_kl,
+			int i_ku,
+			int j,
+			int d
+	)
+	{
+		return i_AB[(i_kl+i_ku-d) + (j+d)*i_LDAB];
+	}
+
+
+public:
+	/**
+	 * Determine the bandwidth and the coupling of odd offsets of one block
+	 */
+	static
+	void analyzeBlock(
+			const T *i_AB,				///< band storage of block
+			int i_LDAB,					///< leading dimension of band storage
+			int i_kl,					///< number of subdiagonals
+			int i_ku,					///< number of superdiagonals
+			int i_size,					///< number of rows in block
+			int &io_bandwidth,			///< maximum offset with nonzero value
+			bool &io_odd_coupling		///< true if any odd offset is nonzero
+	)
+	{
+		for (int j = 0; j < i_size; j++)
+		{
+			for (int d = -i_kl; d <= i_ku; d++)
+			{
+				if (j+d < 0 || j+d >= i_size)
+					continue;
+
+				if (p_element(i_AB, i_LDAB, i_kl, i_ku, j, d) == T(0))
+					continue;
+
+				io_bandwidth = std::max(io_bandwidth, std::abs(d));
+
+				if (d & 1)
+					io_odd_coupling = true;
+			}
+		}
+	}
+
+
+
+	/**
+	 * Compute LU decomposition without pivoting.
+	 *
+	 * The result is stored with 2*KB+1 values per row, where KB is the bandwidth
+	 * within each chain. The main diagonal is stored inverted.
+	 *
+	 * \return false if a pivot is too small or the pivot growth too large
+	 * to be used without pivoting
+	 */
+	template <int KB>
+	static
+	bool factorizeBlock(
+			const T *i_AB,				///< band storage of block
+			int i_LDAB,					///< leading dimension of band storage
+			int i_kl,					///< number of subdiagonals
+			int i_ku,					///< number of superdiagonals
+			int i_size,					///< number of rows in block
+			int i_stride,				///< 1: fully coupled, 2: decoupled even/odd chains
+			T *o_LU						///< LU decomposition, (2*KB+1)*i_size values
+	)
+	{
+		const int W = 2*KB+1;
+
+		if (KB*i_stride > std::min(i_kl, i_ku))
+			return false;
+
+		TMag max_abs_A = 0;
+
+		for (int j = 0; j < i_size; j++)
+		{
+			for (int d = -KB; d <= KB; d++)
+			{
+				int jj = j+d*i_stride;
+
+				if (jj < 0 || jj >= i_size)
+					o_LU[j*W+d+KB] = 0;
+				else
+					o_LU[j*W+d+KB] = p_element(i_AB, i_LDAB, i_kl, i_ku, j, d*i_stride);
+
+				max_abs_A = std::max(max_abs_A, std::abs(o_LU[j*W+d+KB]));
+			}
+		}
+
+		TMag max_abs_U_limit = p_maxPivotGrowth()*max_abs_A;
+
+		for (int j = 0; j < i_size; j++)
+		{
+			T *row = &o_LU[j*W];
+
+			// this row of U is final
+			TMag max_abs = 0;
+			for (int d = 0; d <= KB; d++)
+				max_abs = std::max(max_abs, std::abs(row[d+KB]));
+
+			if (max_abs > max_abs_U_limit)
+				return false;
+
+			T pivot = row[KB];
+			if (std::abs(pivot) <= p_pivotTolerance()*max_abs || pivot == T(0))
+				return false;
+
+			T inv_pivot = T(1.0)/pivot;
+			row[KB] = inv_pivot;
+
+			// eliminate entries in rows below within the same chain
+			for (int i = 1; i <= KB; i++)
+			{
+				int jr = j+i*i_stride;
+				if (jr >= i_size)
+					break;
+
+				T *row_below = &o_LU[jr*W];
+
+				T l = row_below[-i+KB]*inv_pivot;
+				row_below[-i+KB] = l;
+
+				for (int q = 1; q <= KB; q++)
+					row_below[q-i+KB] -= l*row[q+KB];
+			}
+		}
+
+		return true;
+	}
+
+
+
+	/**
+	 * Solve with the LU decomposition computed by factorizeBlock()
+	 */
+	template <int KB>
+	static
+	void solveBlock(
+			const T *i_LU,				///< LU decomposition
+			int i_size,					///< number of rows in block
+			int i_stride,				///< 1: fully coupled, 2: decoupled even/odd chains
+			const T *i_b,				///< rhs
+			T *o_x						///< solution
+	)
+	{
+		const int W = 2*KB+1;
+
+		// forward substitution with L (unit diagonal)
+		for (int j = 0; j < i_size; j++)
+		{
+			const T *row = &i_LU[j*W];
+			T x = i_b[j];
+
+			for (int i = 1; i <= KB; i++)
+			{
+				int jp = j-i*i_stride;
+				if (jp >= 0)
+					x -= row[-i+KB]*o_x[jp];
+			}
+
+			o_x[j] = x;
+		}
+
+		// backward substitution with U
+		for (int j = i_size-1; j >= 0; j--)
+		{
+			const T *row = &i_LU[j*W];
+			T x = o_x[j];
+
+			for (int q = 1; q <= KB; q++)
+			{
+				int jn = j+q*i_stride;
+				if (jn < i_size)
+					x -= row[q+KB]*o_x[jn];
+			}
+
+			o_x[j] = x*row[KB];
+		}
+	}
+
+
+
+	/**
+	 * Wrapper to call factorizeBlock with a runtime bandwidth
+	 */
+	static
+	bool factorizeBlock(
+			int i_chain_bandwidth,
+			const T *i_AB,
+			int i_LDAB,
+			int i_kl,
+			int i_ku,
+			int i_size,
+			int i_stride,
+			T *o_LU
+	)
+	{
+		switch(i_chain_bandwidth)
+		{
+		case 0:	return factorizeBlock<0>(i_AB, i_LDAB, i_kl, i_ku, i_size, i_stride, o_LU);
+		case 1:	return factorizeBlock<1>(i_AB, i_LDAB, i_kl, i_ku, i_size, i_stride, o_LU);
+		case 2:	return factorizeBlock<2>(i_AB, i_LDAB, i_kl, i_ku, i_size, i_stride, o_LU);
+		case 3:	return factorizeBlock<3>(i_AB, i_LDAB, i_kl, i_ku, i_size, i_stride, o_LU);
+		case 4:	return factorizeBlock<4>(i_AB, i_LDAB, i_kl, i_ku, i_size, i_stride, o_LU);
+		}
+		return false;
+	}
+
+
+
+	/**
+	 * Wrapper to call solveBlock with a runtime bandwidth
+	 */
+	static
+	void solveBlock(
+			int i_chain_bandwidth,
+			const T *i_LU,
+			int i_size,
+			int i_stride,
+			const T *i_b,
+			T *o_x
+	)
+	{
+		switch(i_chain_bandwidth)
+		{
+		case 0:	solveBlock<0>(i_LU, i_size, i_stride, i_b, o_x);	return;
+		case 1:	solveBlock<1>(i_LU, i_size, i_stride, i_b, o_x);	return;
+		case 2:	solveBlock<2>(i_LU, i_size, i_stride, i_b, o_x);	return;
+		case 3:	solveBlock<3>(i_LU, i_size, i_stride, i_b, o_x);	return;
+		case 4:	solveBlock<4>(i_LU, i_size, i_stride, i_b, o_x);	return;
+		}
+		assert(false);
+	}
+
+
+
+	/**
+	 * Compute the residual r = b - A*x for a block in band storage
+	 */
+	static
+	void residualBlock(
+			const T *i_AB,				///< band storage of block
+			int i_LDAB,					///< leading dimension of band storage
+			int i_kl,					///< number of subdiagonals
+			int i_ku,					///< number of superdiagonals
+			int i_size,					///< number of rows in block
+			const T *i_b,				///< rhs
+			const T *i_x,				///< approximate solution
+			T *o_r						///< residual
+	)
+	{
+		for (int j = 0; j < i_size; j++)
+		{
+			T r = i_b[j];
+
+			int d_start = std::max(-i_kl, -j);
+			int d_end = std::min(i_ku, i_size-1-j);
+
+			for (int d = d_start; d <= d_end; d++)
+				r -= p_element(i_AB, i_LDAB, i_kl, i_ku, j, d)*i_x[j+d];
+
+			o_r[j] = r;
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_LIBMATH_SMALLBANDEDMATRIXSOLVER_HPP_ */
@@ -25,12 +25,15 @@ template <class T> class PararealDataInherited	: public T {};
 
 #	include <parareal/Parareal_SimulationInstance.hpp>
 #	include <parareal/Parareal_Controller_Serial.hpp>
+#	include <parareal/Parareal_Controller_Threaded.hpp>
 #	include <parareal/Parareal_Data_PlaneData.hpp>
 
 
 #elif SWEET_PARAREAL==2
 
-#	error "Parareal with MPI not yet supported"
+#	include <parareal/Parareal_SimulationInstance.hpp>
+#	include <parareal/Parareal_Controller_MPI.hpp>
+#	include <parareal/Parareal_Data_PlaneData.hpp>
 
 #endif
 
@@ -0,0 +1,443 @@
+/*
+ * Parareal_Controller_MPI.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_PARAREAL_PARAREAL_CONTROLLER_MPI_HPP_
+#define SRC_INCLUDE_PARAREAL_PARAREAL_CONTROLLER_MPI_HPP_
+
+#if !SWEET_MPI
+#	error "MPI required for distributed Parareal controller"
+#endif
+
+#include <mpi.h>
+#include <parareal/Parareal_SimulationInstance.hpp>
+#include <parareal/Parareal_SimulationVariables.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+
+
+/**
+ * Distributed memory Parareal controller.
+ *
+ * The time slices are distributed block-wise to the MPI ranks,
+ * each rank owns one or more consecutive time slices.
+ * Only the data at the boundaries of these blocks is communicated
+ * by non-blocking point-to-point communication of packed data
+ * (see Parareal_Data::pack()).
+ *
+ * The fine time steps of iteration k+1 are started directly after
+ * the new start data of iteration k arrived at the time slice,
+ * hence overlapping with the coarse corrections of the following ranks.
+ *
+ * The convergence is detected by the rank owning the last time slice
+ * which sends its decision for iteration k to all other ranks.
+ * The coarse corrections of iteration k+1 are only computed after this
+ * decision arrived, so that the output is the same as for Parareal_Controller_Serial.
+ * The fine time steps of the next iteration are executed speculatively.
+ *
+ * \param t_SimulationInstance	class which implements the Parareal_SimulationInstance interfaces
+ */
+template <class t_SimulationInstance>
+class Parareal_Controller_MPI
+{
+	enum
+	{
+		TAG_DATA = 0,
+		TAG_DECISION = 1
+	};
+
+	/**
+	 * Array with instantiations of the local time slices
+	 */
+	t_SimulationInstance *simulationInstances = nullptr;
+
+	/**
+	 * Pointers to interfaces of simulationInstances
+	 */
+	Parareal_SimulationInstance **parareal_simulationInstances = nullptr;
+
+	/**
+	 * Simulation instance which holds the data received from the previous rank.
+	 * Simulation instances might keep references to the data given to
+	 * sim_set_data(), therefore we need some persistent storage for it.
+	 */
+	t_SimulationInstance *ghostInstance = nullptr;
+
+	/**
+	 * Pointer to parareal simulation variables.
+	 */
+	PararealSimulationVariables *pVars = nullptr;
+
+	int mpi_rank = 0;
+	int mpi_size = 1;
+
+	/**
+	 * Local time slices [slice_start, slice_end)
+	 */
+	int slice_start = 0;
+	int slice_end = 0;
+
+	/**
+	 * Communication buffers:
+	 * [0]: accumulated convergence value, [1...]: packed data
+	 */
+	std::vector<double> send_buffer;
+	std::vector<double> recv_buffer;
+
+	MPI_Request send_request = MPI_REQUEST_NULL;
+	MPI_Request recv_request = MPI_REQUEST_NULL;
+
+	/**
+	 * Convergence decisions which are sent by the owner of the last time slice
+	 */
+	std::vector<int> decision_buffer;
+	std::vector<MPI_Request> decision_requests;
+
+
+public:
+	Parareal_Controller_MPI()
+	{
+	}
+
+
+	~Parareal_Controller_MPI()
+	{
+		cleanup();
+	}
+
+
+	void cleanup()
+	{
+		if (simulationInstances != nullptr)
+		{
+			delete [] simulationInstances;
+			delete [] parareal_simulationInstances;
+
+			simulationInstances = nullptr;
+			parareal_simulationInstances = nullptr;
+		}
+
+		delete ghostInstance;
+		ghostInstance = nullptr;
+	}
+
+
+
+private:
+	inline
+	Parareal_SimulationInstance* p_instance(
+			int i_slice
+	)
+	{
+		assert(i_slice >= slice_start && i_slice < slice_end);
+		return parareal_simulationInstances[i_slice-slice_start];
+	}
+
+
+	/**
+	 * Start sending data of last local slice to the next rank
+	 */
+	void p_send_next(
+			Parareal_Data &i_data,
+			double i_convergence
+	)
+	{
+		// make sure that the previous message was sent
+		MPI_Wait(&send_request, MPI_STATUS_IGNORE);
+
+		send_buffer[0] = i_convergence;
+		i_data.pack(send_buffer.data()+1);
+
+		MPI_Isend(send_buffer.data(), send_buffer.size(), MPI_DOUBLE, mpi_rank+1, TAG_DATA, MPI_COMM_WORLD, &send_request);
+	}
+
+
+	/**
+	 * Post receive of data from the previous rank
+	 */
+	void p_post_recv_prev()
+	{
+		MPI_Irecv(recv_buffer.data(), recv_buffer.size(), MPI_DOUBLE, mpi_rank-1, TAG_DATA, MPI_COMM_WORLD, &recv_request);
+	}
+
+
+	/**
+	 * Finish receiving data from the previous rank and store it in the ghost instance
+	 *
+	 * \return accumulated convergence value
+	 */
+	double p_finish_recv_prev()
+	{
+		MPI_Wait(&recv_request, MPI_STATUS_IGNORE);
+
+		double convergence = recv_buffer[0];
+		ghostInstance->get_reference_to_output_data().unpack(recv_buffer.data()+1);
+
+		// overlap receiving the next message with computations
+		p_post_recv_prev();
+
+		return convergence;
+	}
+
+
+
+public:
+	void setup(
+			PararealSimulationVariables *i_pararealSimVars
+	)
+	{
+		cleanup();
+
+		pVars = i_pararealSimVars;
+
+		if (!pVars->enabled)
+			return;
+
+		if (pVars->coarse_slices <= 0)
+		{
+			std::cerr << "Invalid number of coarse slices" << std::endl;
+			exit(1);
+		}
+
+		if (pVars->max_simulation_time <= 0)
+		{
+			std::cerr << "Invalid simulation time" << std::endl;
+			exit(1);
+		}
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+		MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+		int num_slices = pVars->coarse_slices;
+
+		if (mpi_size > num_slices)
+		{
+			std::cerr << "More MPI ranks (" << mpi_size << ") than time slices (" << num_slices << ")" << std::endl;
+			exit(1);
+		}
+
+		/*
+		 * Block-wise distribution of time slices
+		 */
+		slice_start = (int)(((long long)num_slices*mpi_rank)/mpi_size);
+		slice_end = (int)(((long long)num_slices*(mpi_rank+1))/mpi_size);
+
+		int num_local_slices = slice_end - slice_start;
+
+		if (pVars->verbosity > 0)
+			std::cout << "[RANK " << mpi_rank << "] time slices [" << slice_start << ", " << slice_end << ")" << std::endl;
+
+		simulationInstances = new t_SimulationInstance[num_local_slices];
+		parareal_simulationInstances = new Parareal_SimulationInstance*[num_local_slices];
+
+		for (int i = 0; i < num_local_slices; i++)
+			parareal_simulationInstances[i] = &(Parareal_SimulationInstance&)(simulationInstances[i]);
+
+		if (slice_start > 0)
+			ghostInstance = new t_SimulationInstance;
+
+		/*
+		 * SETUP time frame
+		 */
+		double coarse_timestep_size = pVars->max_simulation_time / num_slices;
+
+		for (int i = slice_start; i < slice_end; i++)
+		{
+			if (i == num_slices-1)
+				p_instance(i)->sim_set_timeframe(pVars->max_simulation_time-coarse_timestep_size, pVars->max_simulation_time);
+			else
+				p_instance(i)->sim_set_timeframe(coarse_timestep_size*i, coarse_timestep_size*(i+1));
+		}
+
+		/*
+		 * Setup first simulation instance
+		 */
+		if (slice_start == 0)
+			p_instance(0)->sim_setup_initial_data();
+
+		/*
+		 * Communication buffers
+		 */
+		std::size_t buffer_size = 1 + p_instance(slice_start)->get_reference_to_output_data().get_pack_size();
+
+		send_buffer.resize(buffer_size);
+		recv_buffer.resize(buffer_size);
+	}
+
+
+
+	void run()
+	{
+		int num_slices = pVars->coarse_slices;
+		int last_rank = mpi_size-1;
+
+		// pending sends refer to these buffers
+		decision_buffer.reserve(num_slices);
+
+		if (slice_start > 0)
+			p_post_recv_prev();
+
+		/**
+		 * Initial propagation
+		 */
+		for (int i = slice_start; i < slice_end; i++)
+		{
+			if (i > 0)
+			{
+				if (i == slice_start)
+				{
+					p_finish_recv_prev();
+					p_instance(i)->sim_set_data(ghostInstance->get_reference_to_output_data());
+				}
+				else
+				{
+					p_instance(i)->sim_set_data(p_instance(i-1)->get_reference_to_data_timestep_coarse());
+				}
+			}
+
+			p_instance(i)->run_timestep_coarse();
+
+			if (i == slice_end-1 && i < num_slices-1)
+				p_send_next(p_instance(i)->get_reference_to_data_timestep_coarse(), -2);
+		}
+
+
+		/**
+		 * Parareal iterations
+		 */
+		for (int k = 0; k < num_slices; k++)
+		{
+			if (mpi_rank == 0)
+				std::cout << "[MAIN] Iteration Nr. " << k << std::endl;
+
+			/**
+			 * Fine time stepping and difference between coarse and fine solution.
+			 *
+			 * The start data was already received during the previous iteration.
+			 */
+			for (int i = std::max(k, slice_start); i < slice_end; i++)
+			{
+				p_instance(i)->run_timestep_fine();
+				p_instance(i)->compute_difference();
+			}
+
+			/**
+			 * Wait for convergence decision of the previous iteration
+			 */
+			if (k > 0 && mpi_rank != last_rank)
+			{
+				int converged;
+				MPI_Recv(&converged, 1, MPI_INT, last_rank, TAG_DECISION, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+				if (converged)
+					break;
+			}
+
+			/**
+			 * 1) Coarse time stepping
+			 * 2) Compute output + convergence check
+			 * 3) Forward to next frame
+			 */
+			double max_convergence = -2;
+			bool converged = false;
+
+			for (int i = slice_start; i < slice_end; i++)
+			{
+				if (i > 0)
+				{
+					if (i == slice_start)
+					{
+						max_convergence = p_finish_recv_prev();
+						p_instance(i)->sim_set_data(ghostInstance->get_reference_to_output_data());
+					}
+					else
+					{
+						p_instance(i)->sim_set_data(p_instance(i-1)->get_reference_to_output_data());
+					}
+				}
+
+				p_instance(i)->run_timestep_coarse();
+
+				// compute convergence
+				double convergence = p_instance(i)->compute_output_data(true);
+				std::cout << "[" << i << "]                         iteration " << k << ", time slice " << i << ", convergence: " << convergence << std::endl;
+				if (max_convergence != -1)
+					max_convergence = (convergence==-1)?(convergence):(std::max(max_convergence,convergence));
+
+				p_instance(i)->output_data_file(
+						p_instance(i)->get_reference_to_output_data(),
+						k,
+						i
+					);
+
+				p_instance(i)->output_data_console(
+						p_instance(i)->get_reference_to_output_data(),
+						k,
+						i
+					);
+
+				// last coarse time step slice?
+				if (i == num_slices-1)
+				{
+					// convergence check activated?
+					if (pVars->convergence_error_threshold >= 0 && max_convergence >= 0)
+					{
+						// convergence given?
+						if (max_convergence < pVars->convergence_error_threshold)
+						{
+							std::cout << "[MAIN] Convergence reached at iteration " << k << " with convergence value " << max_convergence << std::endl;
+							converged = true;
+						}
+					}
+
+					// send decision to all other ranks if there's another iteration
+					if (k < num_slices-1)
+					{
+						decision_buffer.push_back(converged);
+						for (int r = 0; r < last_rank; r++)
+						{
+							decision_requests.push_back(MPI_REQUEST_NULL);
+							MPI_Isend(&decision_buffer.back(), 1, MPI_INT, r, TAG_DECISION, MPI_COMM_WORLD, &decision_requests.back());
+						}
+					}
+				}
+				else if (i == slice_end-1)
+				{
+					p_send_next(p_instance(i)->get_reference_to_output_data(), max_convergence);
+				}
+			}
+
+			if (converged)
+				break;
+		}
+
+		/*
+		 * Finish pending communication
+		 */
+		MPI_Wait(&send_request, MPI_STATUS_IGNORE);
+
+		if (recv_request != MPI_REQUEST_NULL)
+		{
+			// there's no matching message for the last posted receive
+			MPI_Cancel(&recv_request);
+			MPI_Wait(&recv_request, MPI_STATUS_IGNORE);
+		}
+
+		if (decision_requests.size() > 0)
+			MPI_Waitall(decision_requests.size(), decision_requests.data(), MPI_STATUSES_IGNORE);
+
+		decision_requests.clear();
+		decision_buffer.clear();
+	}
+};
+
+
+
+
+#endif /* SRC_INCLUDE_PARAREAL_PARAREAL_CONTROLLER_MPI_HPP_ */
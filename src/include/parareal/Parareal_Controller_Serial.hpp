@@ -15,6 +15,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <algorithm>
 
 
 /**
@@ -198,20 +199,27 @@ public:
 		 */
 //		int start_slice = 0;
 
+		/*
+		 * First time slice which is not yet converged.
+		 * Only used if the active window is enabled.
+		 */
+		int window_start = 0;
+
 		int k = 0;
 		for (; k < pVars->coarse_slices; k++)
 		{
 			CONSOLEPREFIX_start("[MAIN] ");
 			std::cout << "Iteration Nr. " << k << std::endl;
+
 			/*
-			 * All the following loops should start with 0.
-			 * For debugging reasons, we leave it here at 0
+			 * All slices before k are converged by construction of Parareal
 			 */
+			window_start = std::max(window_start, k);
 
 			/**
 			 * Fine time stepping
 			 */
-			for (int i = k; i < pVars->coarse_slices; i++)
+			for (int i = window_start; i < pVars->coarse_slices; i++)
 			{
 				CONSOLEPREFIX_start(i);
 				parareal_simulationInstances[i]->run_timestep_fine();
@@ -221,7 +229,7 @@ public:
 			/**
 			 * Compute difference between coarse and fine solution
 			 */
-			for (int i = k; i < pVars->coarse_slices; i++)
+			for (int i = window_start; i < pVars->coarse_slices; i++)
 			{
 				CONSOLEPREFIX_start(i);
 				parareal_simulationInstances[i]->compute_difference();
@@ -234,11 +242,27 @@ public:
 			 * 3) Forward to next frame
 			 */
 			double max_convergence = -2;
-//			for (int i = k; i < pVars->coarse_slices; i++)
-			for (int i = 0; i < pVars->coarse_slices; i++)
+
+			/*
+			 * All the following loops should start with 0.
+			 * For debugging reasons, we leave it here at 0
+			 * unless the active window is enabled.
+			 */
+			int coarse_start = (pVars->active_window ? window_start : 0);
+
+			// new start of active window
+			int next_window_start = window_start;
+
+			for (int i = coarse_start; i < pVars->coarse_slices; i++)
 			{
 				CONSOLEPREFIX_start(i);
-				parareal_simulationInstances[i]->run_timestep_coarse();
+
+				/*
+				 * The start data of the first slice in the active window was not modified
+				 * since its last coarse time step, hence the coarse solution is still valid.
+				 */
+				if (!pVars->active_window || i != window_start)
+					parareal_simulationInstances[i]->run_timestep_coarse();
 
 				// compute convergence
 				double convergence = parareal_simulationInstances[i]->compute_output_data(true);
@@ -246,18 +270,39 @@ public:
 				if (max_convergence != -1)
 					max_convergence = (convergence==-1)?(convergence):(std::max(max_convergence,convergence));
 
-				parareal_simulationInstances[i]->output_data_file(
-						parareal_simulationInstances[i]->get_reference_to_output_data(),
-						k,
-						i
-					);
+				/*
+				 * Extend converged prefix:
+				 * The first slice of the window is exact after its fine time step,
+				 * following ones are converged if their increment is small enough.
+				 */
+				if (pVars->active_window && i == next_window_start)
+				{
+					if (
+						i == window_start ||
+						(
+							pVars->convergence_error_threshold >= 0 &&
+							convergence >= 0 &&
+							convergence < pVars->convergence_error_threshold
+						)
+					)
+						next_window_start = i+1;
+				}
 
-				CONSOLEPREFIX.start(i);
-				parareal_simulationInstances[i]->output_data_console(
-						parareal_simulationInstances[i]->get_reference_to_output_data(),
-						k,
-						i
-					);
+				if (pVars->output_all_iterations)
+				{
+					parareal_simulationInstances[i]->output_data_file(
+							parareal_simulationInstances[i]->get_reference_to_output_data(),
+							k,
+							i
+						);
+
+					CONSOLEPREFIX.start(i);
+					parareal_simulationInstances[i]->output_data_console(
+							parareal_simulationInstances[i]->get_reference_to_output_data(),
+							k,
+							i
+						);
+				}
 
 				// last coarse time step slice?
 				if (i == pVars->coarse_slices-1)
@@ -289,11 +334,45 @@ public:
 				}
 
 			}
+
+			window_start = next_window_start;
+
+			if (window_start == pVars->coarse_slices)
+			{
+				CONSOLEPREFIX_start("[MAIN] ");
+				std::cout << "All time slices converged at iteration " << k << std::endl;
+				goto converged;
+			}
 ///			start_slice++;
 		}
 
+		// we finished the last iteration
+		k--;
+
 converged:
 
+		/*
+		 * Write output of last iteration
+		 */
+		if (!pVars->output_all_iterations)
+		{
+			for (int i = 0; i < pVars->coarse_slices; i++)
+			{
+				CONSOLEPREFIX_start(i);
+				parareal_simulationInstances[i]->output_data_file(
+						parareal_simulationInstances[i]->get_reference_to_output_data(),
+						k,
+						i
+					);
+
+				parareal_simulationInstances[i]->output_data_console(
+						parareal_simulationInstances[i]->get_reference_to_output_data(),
+						k,
+						i
+					);
+			}
+		}
+
 		CONSOLEPREFIX_end();
 	}
 };
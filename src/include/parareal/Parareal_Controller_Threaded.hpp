@@ -0,0 +1,526 @@
+/*
+ * Parareal_Controller_Threaded.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_PARAREAL_PARAREAL_CONTROLLER_THREADED_HPP_
+#define SRC_INCLUDE_PARAREAL_PARAREAL_CONTROLLER_THREADED_HPP_
+
+
+#include <parareal/Parareal_SimulationInstance.hpp>
+#include <parareal/Parareal_SimulationVariables.hpp>
+#include <sweet/MemBlockAlloc.hpp>
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <new>
+
+#if SWEET_THREADING
+#	include <omp.h>
+#endif
+
+
+
+/**
+ * Parareal controller which runs the fine time steps of all
+ * active time slices concurrently on a shared memory system.
+ *
+ * This controller provides the same interfaces and computes
+ * the same results as Parareal_Controller_Serial.
+ *
+ * Threads are split into
+ *  - one thread executing the sequential coarse time stepping
+ *    (initial propagation + Parareal corrections) and
+ *  - one team of threads per group of time slices which executes
+ *    the fine time steps (nested OpenMP parallelism).
+ *
+ * Time slice i is always processed by the team i % num_teams.
+ * The simulation instances are constructed by the thread of this team,
+ * hence all data of a time slice is allocated in the NUMA domain
+ * of its team (see MemBlockAlloc::setThreadLocalDomainId).
+ *
+ * There is no barrier between the Parareal iterations.
+ * Instead, each task waits only for the data it depends on:
+ *  - fine time step of slice i in iteration k
+ *    requires the coarse correction of slice i in iteration k-1
+ *  - the coarse correction of slice i in iteration k
+ *    requires the fine time step of slice i in iteration k
+ *  - forwarding the output of slice i to slice i+1 in iteration k
+ *    requires the fine time step of slice i+1 in iteration k to be finished
+ *    since this overwrites its start data.
+ *
+ * Therefore, the coarse corrections are pipelined behind the fine time steps
+ * and fine time steps of the next iteration are started as soon
+ * as the corrected start data is available.
+ *
+ * Without threading support, all tasks are executed by a single thread
+ * in the order of the serial controller.
+ *
+ * \param t_SimulationInstance	class which implements the Parareal_SimulationInstance interfaces
+ */
+template <class t_SimulationInstance>
+class Parareal_Controller_Threaded
+{
+	/**
+	 * Array with instantiations of PararealSimulations
+	 */
+	t_SimulationInstance *simulationInstances = nullptr;
+
+	/**
+	 * Pointers to interfaces of simulationInstances
+	 */
+	Parareal_SimulationInstance **parareal_simulationInstances = nullptr;
+
+	/**
+	 * Pointer to parareal simulation variables.
+	 */
+	PararealSimulationVariables *pVars = nullptr;
+
+	/**
+	 * Number of thread teams for fine time stepping.
+	 * If this is 0, everything is executed by the coarse thread.
+	 */
+	int num_teams = 0;
+
+	/**
+	 * Number of threads in each team
+	 */
+	int threads_per_team = 1;
+
+	/**
+	 * Last iteration for which the fine time step of each slice was finished
+	 */
+	std::vector<std::atomic<int>> fine_done;
+
+	/**
+	 * Last iteration for which the coarse correction of each slice was finished.
+	 * -1: initial propagation
+	 */
+	std::vector<std::atomic<int>> coarse_done;
+
+	/**
+	 * Stop all fine time stepping teams (e.g. after convergence)
+	 */
+	std::atomic<bool> stop;
+
+
+public:
+	Parareal_Controller_Threaded()	:
+		stop(false)
+	{
+	}
+
+
+	~Parareal_Controller_Threaded()
+	{
+		cleanup();
+	}
+
+
+	void cleanup()
+	{
+		if (simulationInstances != nullptr)
+		{
+			for (int i = 0; i < pVars->coarse_slices; i++)
+				simulationInstances[i].~t_SimulationInstance();
+
+			::operator delete(simulationInstances);
+			delete [] parareal_simulationInstances;
+
+			simulationInstances = nullptr;
+			parareal_simulationInstances = nullptr;
+		}
+	}
+
+
+
+private:
+	/**
+	 * Run the coarse thread and the fine time stepping teams.
+	 *
+	 * The coarse thread is the master thread.
+	 * Team t is executed by thread t+1 of the outer parallel region
+	 * which spawns threads_per_team threads for nested parallel regions.
+	 */
+	template <typename T_CoarseFun, typename T_TeamFun>
+	void p_run_teams(
+			T_CoarseFun i_coarse_fun,
+			T_TeamFun i_team_fun
+	)
+	{
+#if SWEET_THREADING
+		if (num_teams == 0)
+		{
+			i_coarse_fun();
+			return;
+		}
+
+		int max_active_levels = omp_get_max_active_levels();
+		omp_set_max_active_levels(std::max(2, max_active_levels));
+
+#pragma omp parallel num_threads(num_teams+1) proc_bind(spread)
+		{
+			int outer_id = omp_get_thread_num();
+
+			if (outer_id == 0)
+			{
+				omp_set_num_threads(1);
+				MemBlockAlloc::setThreadLocalDomainId(0);
+
+				i_coarse_fun();
+			}
+			else
+			{
+				int team_id = outer_id-1;
+
+				omp_set_num_threads(threads_per_team);
+
+				/*
+				 * Assign the threads of this team to their allocation domains.
+				 * We rely on the OpenMP runtime to reuse the same threads
+				 * for subsequent nested parallel regions of this team.
+				 */
+#pragma omp parallel num_threads(threads_per_team) proc_bind(close)
+				MemBlockAlloc::setThreadLocalDomainId(1 + team_id*threads_per_team + omp_get_thread_num());
+
+				i_team_fun(team_id);
+			}
+		}
+
+		omp_set_max_active_levels(max_active_levels);
+
+		// restore allocation domains for non-nested parallel regions
+		MemBlockAlloc::setThreadLocalDomainId(0);
+#pragma omp parallel
+		MemBlockAlloc::setThreadLocalDomainId(omp_get_thread_num());
+
+#else
+		i_coarse_fun();
+#endif
+	}
+
+
+
+	/**
+	 * Fine time step of slice i in iteration k
+	 */
+	void p_run_fine(
+			int i,
+			int k
+	)
+	{
+		parareal_simulationInstances[i]->run_timestep_fine();
+		parareal_simulationInstances[i]->compute_difference();
+
+		fine_done[i].store(k);
+	}
+
+
+
+	/**
+	 * Wait for the fine time step of slice i in iteration k to be finished
+	 */
+	void p_wait_fine(
+			int i,
+			int k
+	)
+	{
+		if (num_teams == 0)
+		{
+			// execute it on our own
+			if (fine_done[i].load() < k)
+				p_run_fine(i, k);
+
+			return;
+		}
+
+		while (fine_done[i].load() < k)
+			std::this_thread::yield();
+	}
+
+
+
+	/**
+	 * Wait for the coarse correction of slice i in iteration k to be finished
+	 *
+	 * \return false if the Parareal iterations were stopped
+	 */
+	bool p_wait_coarse(
+			int i,
+			int k
+	)
+	{
+		while (coarse_done[i].load() < k)
+		{
+			if (stop.load())
+				return false;
+
+			std::this_thread::yield();
+		}
+
+		return !stop.load();
+	}
+
+
+
+	/**
+	 * Fine time stepping of all slices assigned to a team
+	 */
+	void p_team_fine_timestepping(
+			int i_team_id
+	)
+	{
+		for (int k = 0; k < pVars->coarse_slices; k++)
+		{
+			for (int i = k; i < pVars->coarse_slices; i++)
+			{
+				if (i % num_teams != i_team_id)
+					continue;
+
+				if (!p_wait_coarse(i, k-1))
+					return;
+
+				p_run_fine(i, k);
+			}
+		}
+	}
+
+
+
+public:
+	void setup(
+			PararealSimulationVariables *i_pararealSimVars
+	)
+	{
+		cleanup();
+
+		pVars = i_pararealSimVars;
+
+		if (!pVars->enabled)
+			return;
+
+		if (pVars->coarse_slices <= 0)
+		{
+			std::cerr << "Invalid number of coarse slices" << std::endl;
+			exit(1);
+		}
+
+		if (pVars->max_simulation_time <= 0)
+		{
+			std::cerr << "Invalid simulation time" << std::endl;
+			exit(1);
+		}
+
+		if (pVars->active_window)
+		{
+			std::cerr << "The active window is only supported by the serial Parareal controller (--parareal-threaded=0)" << std::endl;
+			exit(1);
+		}
+
+		int num_slices = pVars->coarse_slices;
+
+		// the allocator has to be set up outside of parallel regions
+		MemBlockAlloc::setup();
+
+		/*
+		 * Distribute threads to teams
+		 */
+#if SWEET_THREADING
+		// one thread is reserved for the coarse time stepping
+		int num_fine_threads = omp_get_max_threads()-1;
+
+		if (num_fine_threads <= 0)
+		{
+			num_teams = 0;
+			threads_per_team = 1;
+		}
+		else
+		{
+			if (pVars->threads_per_slice > 0)
+				num_teams = std::max(1, num_fine_threads / pVars->threads_per_slice);
+			else
+				num_teams = num_fine_threads;
+
+			num_teams = std::min(num_teams, num_slices);
+			threads_per_team = num_fine_threads / num_teams;
+		}
+#else
+		num_teams = 0;
+		threads_per_team = 1;
+#endif
+
+		std::cout << "[MAIN] Threaded Parareal: " << num_slices << " time slices, " << num_teams << " teams with " << threads_per_team << " threads each" << std::endl;
+
+		fine_done = std::vector<std::atomic<int>>(num_slices);
+		coarse_done = std::vector<std::atomic<int>>(num_slices);
+
+		/*
+		 * Allocate simulation instances by the threads of their team
+		 * to allocate all data in the team's NUMA domain.
+		 * Instances are constructed one after another since
+		 * we can't assume their constructors to be thread safe.
+		 */
+		simulationInstances = (t_SimulationInstance*)::operator new(sizeof(t_SimulationInstance)*num_slices);
+		parareal_simulationInstances = new Parareal_SimulationInstance*[num_slices];
+
+		std::atomic<int> next_slice(0);
+
+		p_run_teams(
+				[&]()
+				{
+					if (num_teams == 0)
+					{
+						for (int i = 0; i < num_slices; i++)
+							new (&simulationInstances[i]) t_SimulationInstance;
+						return;
+					}
+
+					while (next_slice.load() < num_slices)
+						std::this_thread::yield();
+				},
+				[&](int i_team_id)
+				{
+					for (int i = i_team_id; i < num_slices; i += num_teams)
+					{
+						while (next_slice.load() != i)
+							std::this_thread::yield();
+
+						new (&simulationInstances[i]) t_SimulationInstance;
+
+						next_slice.store(i+1);
+					}
+				}
+			);
+
+		for (int i = 0; i < num_slices; i++)
+			parareal_simulationInstances[i] = &(Parareal_SimulationInstance&)(simulationInstances[i]);
+
+		/*
+		 * SETUP time frame
+		 */
+		double coarse_timestep_size = pVars->max_simulation_time / num_slices;
+
+		parareal_simulationInstances[0]->sim_set_timeframe(0, coarse_timestep_size);
+
+		for (int k = 1; k < num_slices-1; k++)
+			parareal_simulationInstances[k]->sim_set_timeframe(coarse_timestep_size*k, coarse_timestep_size*(k+1));
+
+		parareal_simulationInstances[num_slices-1]->sim_set_timeframe(pVars->max_simulation_time-coarse_timestep_size, pVars->max_simulation_time);
+
+		/*
+		 * Setup first simulation instance
+		 */
+		parareal_simulationInstances[0]->sim_setup_initial_data();
+	}
+
+
+
+	void run()
+	{
+		int num_slices = pVars->coarse_slices;
+
+		for (int i = 0; i < num_slices; i++)
+		{
+			fine_done[i].store(-1);
+			coarse_done[i].store(-2);
+		}
+		stop.store(false);
+
+		p_run_teams(
+				[&]()
+				{
+					/**
+					 * Initial propagation
+					 */
+					std::cout << "[MAIN] Initial propagation" << std::endl;
+
+					for (int i = 0; i < num_slices; i++)
+					{
+						if (i > 0)
+							parareal_simulationInstances[i]->sim_set_data(
+									parareal_simulationInstances[i-1]->get_reference_to_data_timestep_coarse()
+								);
+
+						parareal_simulationInstances[i]->run_timestep_coarse();
+						coarse_done[i].store(-1);
+					}
+
+					/**
+					 * Coarse corrections
+					 */
+					for (int k = 0; k < num_slices; k++)
+					{
+						std::cout << "[MAIN] Iteration Nr. " << k << std::endl;
+
+						double max_convergence = -2;
+						for (int i = 0; i < num_slices; i++)
+						{
+							if (i >= k)
+								p_wait_fine(i, k);
+
+							parareal_simulationInstances[i]->run_timestep_coarse();
+
+							// compute convergence
+							double convergence = parareal_simulationInstances[i]->compute_output_data(true);
+							std::cout << "                        iteration " << k << ", time slice " << i << ", convergence: " << convergence << std::endl;
+							if (max_convergence != -1)
+								max_convergence = (convergence==-1)?(convergence):(std::max(max_convergence,convergence));
+
+							parareal_simulationInstances[i]->output_data_file(
+									parareal_simulationInstances[i]->get_reference_to_output_data(),
+									k,
+									i
+								);
+
+							parareal_simulationInstances[i]->output_data_console(
+									parareal_simulationInstances[i]->get_reference_to_output_data(),
+									k,
+									i
+								);
+
+							// this slice can be used for the next fine time step
+							coarse_done[i].store(k);
+
+							// last coarse time step slice?
+							if (i == num_slices-1)
+							{
+								if (pVars->convergence_error_threshold >= 0 && max_convergence >= 0)
+								{
+									if (max_convergence < pVars->convergence_error_threshold)
+									{
+										std::cout << "[MAIN] Convergence reached at iteration " << k << " with convergence value " << max_convergence << std::endl;
+										stop.store(true);
+										return;
+									}
+								}
+							}
+							else
+							{
+								// the fine time step of the next slice has to be finished before overwriting its start data
+								if (i+1 >= k)
+									p_wait_fine(i+1, k);
+
+								parareal_simulationInstances[i+1]->sim_set_data(
+										parareal_simulationInstances[i]->get_reference_to_output_data()
+									);
+							}
+						}
+					}
+
+					stop.store(true);
+				},
+				[&](int i_team_id)
+				{
+					p_team_fine_timestepping(i_team_id);
+				}
+			);
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_PARAREAL_PARAREAL_CONTROLLER_THREADED_HPP_ */
@@ -8,6 +8,8 @@
 #ifndef SRC_INCLUDE_PARAREAL_PARAREAL_DATA_HPP_
 #define SRC_INCLUDE_PARAREAL_PARAREAL_DATA_HPP_
 
+#include <cstddef>
+
 
 /**
  * These interfaces have to be supported by the data
@@ -17,19 +19,28 @@ class Parareal_Data
 {
 public:
 	/**
-	 * send data to given MPI rank
+	 * Return the number of doubles which are required
+	 * to pack the data into a contiguous buffer.
+	 *
+	 * This has to be the same value for all instances
+	 * since it's used to allocate MPI receive buffers.
+	 */
+	virtual std::size_t get_pack_size() = 0;
+
+
+	/**
+	 * Pack data into buffer, e.g. to send it to another MPI rank
 	 */
-	virtual void send(
-			int i_mpi_rank,
-			int i_mpi_comm
+	virtual void pack(
+			double *o_buffer
 	) = 0;
 
+
 	/**
-	 * receive data from given MPI rank
+	 * Unpack data from buffer which was generated by pack()
 	 */
-	virtual void recv(
-			int i_mpi_rank,
-			int i_mpi_comm
+	virtual void unpack(
+			const double *i_buffer
 	) = 0;
 
 
@@ -9,7 +9,10 @@
 #define SRC_INCLUDE_PARAREAL_PARAREAL_DATA_PLANEDATA_HPP_
 
 #include <assert.h>
+#include <cstring>
+#include <algorithm>
 #include <parareal/Parareal_Data.hpp>
+#include <sweet/plane/PlaneData.hpp>
 
 
 
@@ -46,50 +49,129 @@ public:
 	}
 
 
+private:
 	/**
-	 * Send data to rank
+	 * Number of doubles to store a single PlaneData array.
+	 *
+	 * With spectral space, only the spectral coefficients within the
+	 * spectral iteration ranges are stored. All other modes are zeroed
+	 * before transformations to physical space (dealiasing) or don't exist.
 	 */
-	void send(
-			int i_mpi_rank,
-			int i_mpi_comm
+	static
+	std::size_t p_array_pack_size(
+			const PlaneDataConfig *i_planeDataConfig
 	)
 	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		std::size_t num_modes = 0;
+		for (int r = 0; r < 2; r++)
+			num_modes +=
+				(i_planeDataConfig->spectral_data_iteration_ranges[r][0][1] - i_planeDataConfig->spectral_data_iteration_ranges[r][0][0])*
+				(i_planeDataConfig->spectral_data_iteration_ranges[r][1][1] - i_planeDataConfig->spectral_data_iteration_ranges[r][1][0]);
+
+		return 2*num_modes;
+#else
+		return i_planeDataConfig->physical_array_data_number_of_elements;
+#endif
+	}
+
+
+public:
+	std::size_t get_pack_size()
+	{
+		return N*p_array_pack_size(data_arrays[0]->planeDataConfig);
+	}
+
+
+	/**
+	 * Pack data arrays.
+	 *
+	 * With spectral space, the data is converted to spectral space
+	 * and only the resolved spectral coefficients are packed.
+	 */
+	void pack(
+			double *o_buffer
+	)
+	{
+		std::size_t array_size = p_array_pack_size(data_arrays[0]->planeDataConfig);
+
 		for (int i = 0; i < N; i++)
 		{
-//			MPI_Isend(...)
+			PlaneData &d = *data_arrays[i];
+			double *buffer = o_buffer + i*array_size;
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+			d.request_data_spectral();
+
+			const PlaneDataConfig *c = d.planeDataConfig;
+			std::complex<double> *spec_buffer = (std::complex<double>*)buffer;
+
+			for (int r = 0; r < 2; r++)
+			{
+				std::size_t num_i = c->spectral_data_iteration_ranges[r][0][1] - c->spectral_data_iteration_ranges[r][0][0];
+
+				for (std::size_t jj = c->spectral_data_iteration_ranges[r][1][0]; jj < c->spectral_data_iteration_ranges[r][1][1]; jj++)
+				{
+					std::memcpy(spec_buffer, d.spectral_space_data + jj*c->spectral_data_size[0] + c->spectral_data_iteration_ranges[r][0][0], sizeof(std::complex<double>)*num_i);
+					spec_buffer += num_i;
+				}
+			}
+#else
+			std::memcpy(buffer, d.physical_space_data, sizeof(double)*d.planeDataConfig->physical_array_data_number_of_elements);
+#endif
 		}
-
-		std::cout << "TODO: implement me!" << std::endl;
-		assert(false);
 	}
 
-	const Parareal_Data&
-	operator=(const Parareal_Data &i_data)
+
+	void unpack(
+			const double *i_buffer
+	)
 	{
+		std::size_t array_size = p_array_pack_size(data_arrays[0]->planeDataConfig);
+
 		for (int i = 0; i < N; i++)
 		{
-			PlaneData** i_data_arrays = ((Parareal_Data_PlaneData&)i_data).data_arrays;
-			data_arrays[i] = i_data_arrays[i];
+			PlaneData &d = *data_arrays[i];
+			const double *buffer = i_buffer + i*array_size;
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+			const PlaneDataConfig *c = d.planeDataConfig;
+			const std::complex<double> *spec_buffer = (const std::complex<double>*)buffer;
+
+			d.spectral_alloc_buffer();
+			std::fill(d.spectral_space_data, d.spectral_space_data + c->spectral_array_data_number_of_elements, std::complex<double>(0));
+
+			for (int r = 0; r < 2; r++)
+			{
+				std::size_t num_i = c->spectral_data_iteration_ranges[r][0][1] - c->spectral_data_iteration_ranges[r][0][0];
+
+				for (std::size_t jj = c->spectral_data_iteration_ranges[r][1][0]; jj < c->spectral_data_iteration_ranges[r][1][1]; jj++)
+				{
+					std::memcpy(d.spectral_space_data + jj*c->spectral_data_size[0] + c->spectral_data_iteration_ranges[r][0][0], spec_buffer, sizeof(std::complex<double>)*num_i);
+					spec_buffer += num_i;
+				}
+			}
+
+			d.spectral_space_data_valid = true;
+			d.physical_space_data_valid = false;
+#else
+			d.physical_alloc_buffer();
+			std::memcpy(d.physical_space_data, buffer, sizeof(double)*d.planeDataConfig->physical_array_data_number_of_elements);
+#endif
 		}
-
-		return *this;
 	}
 
-	/**
-	 * Receive data from rank
-	 */
-	void recv(
-			int i_mpi_rank,
-			int i_mpi_comm
-	)
+
+	const Parareal_Data&
+	operator=(const Parareal_Data &i_data)
 	{
 		for (int i = 0; i < N; i++)
 		{
-//				MPI_Irecv(...)
+			PlaneData** i_data_arrays = ((Parareal_Data_PlaneData&)i_data).data_arrays;
+			data_arrays[i] = i_data_arrays[i];
 		}
 
-		std::cout << "TODO: implement me!" << std::endl;
-		assert(false);
+		return *this;
 	}
 
 	virtual ~Parareal_Data_PlaneData()
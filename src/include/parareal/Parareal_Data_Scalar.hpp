@@ -44,22 +44,28 @@ public:
 	}
 
 
-	/**
-	 * Send data to rank
-	 */
-	void send(
-			int i_mpi_rank,
-			int i_mpi_comm
+	std::size_t get_pack_size()
+	{
+		return 1;
+	}
+
+
+	void pack(
+			double *o_buffer
 	)
 	{
-		{
-//			MPI_Isend(...)
-		}
+		o_buffer[0] = data;
+	}
 
-		std::cout << "TODO: implement me!" << std::endl;
-		assert(false);
+
+	void unpack(
+			const double *i_buffer
+	)
+	{
+		data = i_buffer[0];
 	}
 
+
 	const Parareal_Data&
 	operator=(const Parareal_Data &i_data)
 	{
@@ -68,22 +74,6 @@ public:
 		return *this;
 	}
 
-	/**
-	 * Receive data from rank
-	 */
-	void recv(
-			int i_mpi_rank,
-			int i_mpi_comm
-	)
-	{
-		{
-//				MPI_Irecv(...)
-		}
-
-		std::cout << "TODO: implement me!" << std::endl;
-		assert(false);
-	}
-
 	virtual ~Parareal_Data_Scalar()
 	{
 	}
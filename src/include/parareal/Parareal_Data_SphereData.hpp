@@ -0,0 +1,134 @@
+/*
+ * Parareal_Data_SphereData.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_PARAREAL_PARAREAL_DATA_SPHEREDATA_HPP_
+#define SRC_INCLUDE_PARAREAL_PARAREAL_DATA_SPHEREDATA_HPP_
+
+#include <assert.h>
+#include <cstring>
+#include <algorithm>
+#include <parareal/Parareal_Data.hpp>
+#include <sweet/sphere/SphereData.hpp>
+
+
+
+template <int N>
+class Parareal_Data_SphereData	:
+		public Parareal_Data
+{
+public:
+	SphereData* data_arrays[N];
+
+	Parareal_Data_SphereData()
+	{
+
+	}
+
+
+	Parareal_Data_SphereData(
+			SphereData* i_data_arrays[N]
+	)
+	{
+		setup(i_data_arrays);
+	}
+
+
+	/**
+	 * Setup data
+	 */
+	void setup(
+			SphereData* i_data_arrays[N]
+	)
+	{
+		for (int i = 0; i < N; i++)
+			data_arrays[i] = i_data_arrays[i];
+	}
+
+
+private:
+	/**
+	 * Number of doubles to store a single SphereData array
+	 */
+	static
+	std::size_t p_array_pack_size(
+			const SphereDataConfig *i_sphereDataConfig
+	)
+	{
+		return i_sphereDataConfig->spectral_array_data_number_of_elements*2;
+	}
+
+
+public:
+	std::size_t get_pack_size()
+	{
+		return N*p_array_pack_size(data_arrays[0]->sphereDataConfig);
+	}
+
+
+	/**
+	 * Pack data arrays.
+	 *
+	 * Only the spectral coefficients are packed
+	 * since they require less memory than the physical data.
+	 */
+	void pack(
+			double *o_buffer
+	)
+	{
+		std::size_t array_size = p_array_pack_size(data_arrays[0]->sphereDataConfig);
+
+		for (int i = 0; i < N; i++)
+		{
+			SphereData &d = *data_arrays[i];
+			double *buffer = o_buffer + i*array_size;
+
+			d.request_data_spectral();
+			std::memcpy(buffer, d.spectral_space_data, sizeof(std::complex<double>)*d.sphereDataConfig->spectral_array_data_number_of_elements);
+		}
+	}
+
+
+	void unpack(
+			const double *i_buffer
+	)
+	{
+		std::size_t array_size = p_array_pack_size(data_arrays[0]->sphereDataConfig);
+
+		for (int i = 0; i < N; i++)
+		{
+			SphereData &d = *data_arrays[i];
+			const double *buffer = i_buffer + i*array_size;
+
+			d.spectral_alloc_buffer();
+			std::memcpy(d.spectral_space_data, buffer, sizeof(std::complex<double>)*d.sphereDataConfig->spectral_array_data_number_of_elements);
+			d.spectral_space_data_valid = true;
+			d.physical_space_data_valid = false;
+		}
+	}
+
+
+	const Parareal_Data&
+	operator=(const Parareal_Data &i_data)
+	{
+		for (int i = 0; i < N; i++)
+		{
+			SphereData** i_data_arrays = ((Parareal_Data_SphereData&)i_data).data_arrays;
+			data_arrays[i] = i_data_arrays[i];
+		}
+
+		return *this;
+	}
+
+	virtual ~Parareal_Data_SphereData()
+	{
+	}
+};
+
+
+
+
+#endif /* SRC_INCLUDE_PARAREAL_PARAREAL_DATA_SPHEREDATA_HPP_ */
@@ -49,6 +49,35 @@ public:
 	 */
 	double max_simulation_time = -1;
 
+	/**
+	 * Run fine time steps of all time slices concurrently
+	 * on separate thread teams (see Parareal_Controller_Threaded)
+	 */
+	bool threaded = false;
+
+	/**
+	 * Number of threads for each time slice in threaded mode.
+	 *
+	 * If set to -1, the threads are distributed evenly over the time slices.
+	 */
+	int threads_per_slice = -1;
+
+	/**
+	 * Only iterate over the active window of time slices which are not yet converged.
+	 *
+	 * Slices up to the iteration number are converged by construction of Parareal,
+	 * further slices are treated as converged if their increment is
+	 * below the convergence threshold and all previous slices are converged.
+	 */
+	bool active_window = false;
+
+	/**
+	 * Write output data of all Parareal iterations.
+	 *
+	 * If disabled, only the output of the last iteration is written.
+	 */
+	bool output_all_iterations = true;
+
 
 	/**
 	 * setup long options for program arguments
@@ -75,6 +104,18 @@ public:
 		io_long_options[io_next_free_program_option] = {"parareal-max-simulation-time", required_argument, 0, (int)256+io_next_free_program_option};
 		io_next_free_program_option++;
 
+		io_long_options[io_next_free_program_option] = {"parareal-threaded", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-threads-per-slice", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-active-window", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-output-all-iterations", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
 		if (io_next_free_program_option > i_max_options)
 		{
 			std::cerr << "Max number of program options exceeded" << std::endl;
@@ -95,6 +136,10 @@ public:
 		std::cout << "	--parareal-verbosity=[int]                  Verbosity level (default=0)" << std::endl;
 		std::cout << "	--parareal-enabled=[0/1]                    Enable Parareal method (default=0)" << std::endl;
 		std::cout << "	--parareal-max-simulation-time=[float]      Overall simulation time (default=-1)" << std::endl;
+		std::cout << "	--parareal-threaded=[0/1]                   Run fine time steps of time slices concurrently (default=0)" << std::endl;
+		std::cout << "	--parareal-threads-per-slice=[int]          Threads for each time slice in threaded mode (default=-1, auto define)" << std::endl;
+		std::cout << "	--parareal-active-window=[0/1]              Skip converged time slices, serial controller only (default=0)" << std::endl;
+		std::cout << "	--parareal-output-all-iterations=[0/1]      Write output of each iteration, serial controller only (default=1)" << std::endl;
 		std::cout << std::endl;
 	}
 
@@ -109,6 +154,10 @@ public:
 		std::cout << " + verbosity: " << verbosity << std::endl;
 		std::cout << " + convergence_error_threshold: " << convergence_error_threshold << std::endl;
 		std::cout << " + max_simulation_time: " << max_simulation_time << std::endl;
+		std::cout << " + threaded: " << threaded << std::endl;
+		std::cout << " + threads_per_slice: " << threads_per_slice << std::endl;
+		std::cout << " + active_window: " << active_window << std::endl;
+		std::cout << " + output_all_iterations: " << output_all_iterations << std::endl;
 		std::cout << std::endl;
 	}
 
@@ -145,6 +194,22 @@ public:
 			max_simulation_time = atof(i_value);
 			break;
 
+		case 5:
+			threaded = atoi(i_value);
+			break;
+
+		case 6:
+			threads_per_slice = atoi(i_value);
+			break;
+
+		case 7:
+			active_window = atoi(i_value);
+			break;
+
+		case 8:
+			output_all_iterations = atoi(i_value);
+			break;
+
 		default:
 			std::cerr << "Unknown long option with id " << i_option_index << std::endl;
 			break;
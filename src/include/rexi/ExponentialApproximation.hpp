@@ -65,6 +65,10 @@ public:
 
 		b.resize(i_M*2+1);
 
+		// coefficients are independent of each other
+#if SWEET_THREADING
+#pragma omp parallel for schedule(static)
+#endif
 		for (int m = -i_M; m < i_M+1; m++)
 		{
 			/*
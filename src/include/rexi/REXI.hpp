@@ -17,6 +17,7 @@
 #include "ExponentialApproximation.hpp"
 #include "GaussianApproximation.hpp"
 #include "Phi1Approximation.hpp"
+#include "REXICoefficientCache.hpp"
 
 
 
@@ -108,6 +109,18 @@ public:
 		int N = i_M+ga.L;
 		int M = i_M;
 
+		REXICoefficientCache::Key cache_key;
+		cache_key.phi_id = i_phi_id;
+		cache_key.h = (double)i_h;
+		cache_key.M = i_M;
+		cache_key.L = L;
+		cache_key.reduce_to_half = i_reduce_to_half;
+		cache_key.normalization = i_normalization;
+		cache_key.evaluation_bytes = sizeof(TEvaluation);
+
+		if (p_cacheLoad(cache_key, alpha, beta_re, beta_im))
+			return;
+
 		alpha.resize(2*N+1);
 		beta_re.resize(2*N+1);
 		beta_im.resize(2*N+1);
@@ -133,20 +146,26 @@ public:
 
 
 #if 1
-		for (int n = 0; n < 2*N+1; n++)
+		/*
+		 * Each pole n accumulates the contributions of all (l, m) with l+m = n.
+		 * The loop over l is kept in ascending order to get the same
+		 * rounding as the sum over the full (l, m) range.
+		 */
+#if SWEET_THREADING
+#pragma omp parallel for schedule(static)
+#endif
+		for (int n = -N; n < N+1; n++)
 		{
-			alpha[n] = {0,0};
-			beta_re[n] = {0,0};
-			beta_im[n] = {0,0};
-		}
+			alpha[n+N] = i_h*(ga.mu + complexProcessingAndStorage(0, n));
+			beta_re[n+N] = {0,0};
+			beta_im[n+N] = {0,0};
 
-		for (int l = -L; l < L+1; l++)
-		{
-			for (int m = -M; m < M+1; m++)
-			{
-				int n = l+m;
-				alpha[n+N] = i_h*(ga.mu + complexProcessingAndStorage(0, n));
+			int l1 = std::max(-L, n-M);
+			int l2 = std::min(L, n+M);
 
+			for (int l = l1; l < l2+1; l++)
+			{
+				int m = n-l;
 				beta_re[n+N] += b[m+M].real()*i_h*ga.a[l+L];
 				beta_im[n+N] += b[m+M].imag()*i_h*ga.a[l+L];
 			}
@@ -236,9 +255,66 @@ public:
 					beta_re[n] /= normalization;
 			}
 		}
+
+		p_cacheStore(cache_key, alpha, beta_re, beta_im);
 	}
 
 
+
+private:
+	/**
+	 * Coefficients can be only cached if they are stored in double precision
+	 */
+	static
+	bool p_cacheLoad(
+			const REXICoefficientCache::Key &i_key,
+			std::vector<std::complex<double>> &o_alpha,
+			std::vector<std::complex<double>> &o_beta_re,
+			std::vector<std::complex<double>> &o_beta_im
+	)
+	{
+		return REXICoefficientCache::load(i_key, o_alpha, o_beta_re, o_beta_im);
+	}
+
+	template <typename T>
+	static
+	bool p_cacheLoad(
+			const REXICoefficientCache::Key &i_key,
+			std::vector<std::complex<T>> &o_alpha,
+			std::vector<std::complex<T>> &o_beta_re,
+			std::vector<std::complex<T>> &o_beta_im
+	)
+	{
+		return false;
+	}
+
+
+	static
+	void p_cacheStore(
+			const REXICoefficientCache::Key &i_key,
+			const std::vector<std::complex<double>> &i_alpha,
+			const std::vector<std::complex<double>> &i_beta_re,
+			const std::vector<std::complex<double>> &i_beta_im
+	)
+	{
+		REXICoefficientCache::store(i_key, i_alpha, i_beta_re, i_beta_im);
+	}
+
+	template <typename T>
+	static
+	void p_cacheStore(
+			const REXICoefficientCache::Key &i_key,
+			const std::vector<std::complex<T>> &i_alpha,
+			const std::vector<std::complex<T>> &i_beta_re,
+			const std::vector<std::complex<T>> &i_beta_im
+	)
+	{
+	}
+
+
+public:
+
+
 	/**
 	 * \return \f$ cos(x) + i*sin(x) \f$
 	 */
@@ -0,0 +1,384 @@
+/*
+ * REXICoefficientCache.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_REXI_REXICOEFFICIENTCACHE_HPP_
+#define SRC_INCLUDE_REXI_REXICOEFFICIENTCACHE_HPP_
+
+#include <complex>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <cstring>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+
+/**
+ * Cache for REXI coefficients
+ *
+ * Computing the coefficients (in particular for large M, quad precision
+ * or phi1) can take a significant amount of time and has to be done on
+ * each MPI rank and whenever a REXI instance is set up again.
+ *
+ * Coefficients are cached
+ *  - in memory for the lifetime of the process and
+ *  - optionally in binary files in a cache directory, storing the
+ *    coefficients as exact binary double values.
+ *
+ * All parameters which have an influence on the coefficients
+ * are part of the key.
+ *
+ * Only coefficients with double precision storage can be cached.
+ */
+class REXICoefficientCache
+{
+public:
+	class Key
+	{
+	public:
+		int phi_id;
+		double h;
+		int M;
+		int L;
+		int reduce_to_half;
+		int normalization;
+
+		/// size of evaluation type in bytes (double / quad precision)
+		int evaluation_bytes;
+
+		bool operator==(const Key &i_key)	const
+		{
+			// compare h bitwise to avoid any rounding issues
+			return	phi_id == i_key.phi_id &&
+					std::memcmp(&h, &i_key.h, sizeof(double)) == 0 &&
+					M == i_key.M &&
+					L == i_key.L &&
+					reduce_to_half == i_key.reduce_to_half &&
+					normalization == i_key.normalization &&
+					evaluation_bytes == i_key.evaluation_bytes;
+		}
+
+
+		/**
+		 * FNV-1a hash of the key
+		 */
+		uint64_t hash()	const
+		{
+			uint64_t hash = 14695981039346656037ULL;
+
+			auto add = [&](const void *i_data, std::size_t i_size)
+			{
+				const unsigned char *d = (const unsigned char*)i_data;
+				for (std::size_t i = 0; i < i_size; i++)
+				{
+					hash ^= d[i];
+					hash *= 1099511628211ULL;
+				}
+			};
+
+			add(&phi_id, sizeof(phi_id));
+			add(&h, sizeof(h));
+			add(&M, sizeof(M));
+			add(&L, sizeof(L));
+			add(&reduce_to_half, sizeof(reduce_to_half));
+			add(&normalization, sizeof(normalization));
+			add(&evaluation_bytes, sizeof(evaluation_bytes));
+
+			return hash;
+		}
+	};
+
+
+	/**
+	 * Header of cache files, followed by the alpha, beta_re and beta_im
+	 * coefficients, each of them stored as num_coefficients complex doubles
+	 */
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t sizeof_header;
+		Key key;
+		uint64_t hash;
+		uint64_t num_coefficients;
+	};
+
+
+private:
+	class Entry
+	{
+	public:
+		Key key;
+		std::vector<std::complex<double>> alpha;
+		std::vector<std::complex<double>> beta_re;
+		std::vector<std::complex<double>> beta_im;
+	};
+
+	std::vector<Entry> entries;
+
+	/// directory for cache files, empty to disable file cache
+	std::string cache_directory;
+
+	static
+	REXICoefficientCache& getSingletonRef()
+	{
+		static REXICoefficientCache cache;
+		return cache;
+	}
+
+
+	static
+	void p_setupFileHeader(
+			const Key &i_key,
+			std::size_t i_num_coefficients,
+			FileHeader &o_header
+	)
+	{
+		std::memset(&o_header, 0, sizeof(FileHeader));
+		std::memcpy(o_header.magic, "SWREXI\0", 8);
+		o_header.version = 1;
+		o_header.sizeof_header = sizeof(FileHeader);
+		o_header.key = i_key;
+		o_header.hash = i_key.hash();
+		o_header.num_coefficients = i_num_coefficients;
+	}
+
+
+public:
+	/**
+	 * Set the directory for the cache files.
+	 * Use an empty string to only use the in-memory cache.
+	 */
+	static
+	void setCacheDirectory(
+			const std::string &i_cache_directory
+	)
+	{
+		getSingletonRef().cache_directory = i_cache_directory;
+	}
+
+
+	/**
+	 * Return the filename of the cache file for the given key
+	 */
+	static
+	std::string getCacheFilename(
+			const std::string &i_cache_directory,
+			const Key &i_key
+	)
+	{
+		std::ostringstream ss;
+		ss << i_cache_directory << "/rexi_coeffs_phi" << i_key.phi_id << "_M" << i_key.M << "_L" << i_key.L << "_";
+		ss << std::hex << i_key.hash() << ".bin";
+		return ss.str();
+	}
+
+
+	/**
+	 * Load the coefficients from the given file.
+	 *
+	 * The file is mapped into memory and the header is validated against the key.
+	 *
+	 * \return true if the coefficients were loaded
+	 */
+	static
+	bool loadFile(
+			const std::string &i_filename,
+			const Key &i_key,
+			std::vector<std::complex<double>> &o_alpha,
+			std::vector<std::complex<double>> &o_beta_re,
+			std::vector<std::complex<double>> &o_beta_im
+	)
+	{
+		int fd = open(i_filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat s;
+		if (fstat(fd, &s) != 0 || (std::size_t)s.st_size < sizeof(FileHeader))
+		{
+			close(fd);
+			return false;
+		}
+
+		void *data = mmap(nullptr, s.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		const FileHeader *header = (const FileHeader*)data;
+
+		FileHeader ref_header;
+		p_setupFileHeader(i_key, header->num_coefficients, ref_header);
+
+		std::size_t N = header->num_coefficients;
+		bool valid =	std::memcmp(header->magic, ref_header.magic, 8) == 0 &&
+						header->version == ref_header.version &&
+						header->sizeof_header == ref_header.sizeof_header &&
+						header->hash == ref_header.hash &&
+						header->key == i_key &&
+						(std::size_t)s.st_size == sizeof(FileHeader) + 3*N*sizeof(std::complex<double>);
+
+		if (valid)
+		{
+			const std::complex<double> *c = (const std::complex<double>*)((const char*)data + sizeof(FileHeader));
+
+			o_alpha.assign(c, c+N);
+			o_beta_re.assign(c+N, c+2*N);
+			o_beta_im.assign(c+2*N, c+3*N);
+		}
+		else
+		{
+			std::cerr << "WARNING: Ignoring invalid REXI coefficient cache file " << i_filename << std::endl;
+		}
+
+		munmap(data, s.st_size);
+		return valid;
+	}
+
+
+	/**
+	 * Write the coefficients to the given file.
+	 *
+	 * The data is first written to a temporary file which is then renamed.
+	 * This avoids reading partially written files from other processes.
+	 */
+	static
+	bool writeFile(
+			const std::string &i_filename,
+			const Key &i_key,
+			const std::vector<std::complex<double>> &i_alpha,
+			const std::vector<std::complex<double>> &i_beta_re,
+			const std::vector<std::complex<double>> &i_beta_im
+	)
+	{
+		std::size_t N = i_alpha.size();
+		assert(i_beta_re.size() == N);
+		assert(i_beta_im.size() == N);
+
+		FileHeader header;
+		p_setupFileHeader(i_key, N, header);
+
+		std::ostringstream ss;
+		ss << i_filename << ".tmp." << getpid();
+		std::string tmp_filename = ss.str();
+
+		FILE *f = fopen(tmp_filename.c_str(), "wb");
+		if (f == nullptr)
+		{
+			std::cerr << "WARNING: Unable to write REXI coefficient cache file " << tmp_filename << std::endl;
+			return false;
+		}
+
+		bool ok = fwrite(&header, sizeof(FileHeader), 1, f) == 1;
+		if (N > 0)
+		{
+			ok = ok && fwrite(i_alpha.data(), sizeof(std::complex<double>), N, f) == N;
+			ok = ok && fwrite(i_beta_re.data(), sizeof(std::complex<double>), N, f) == N;
+			ok = ok && fwrite(i_beta_im.data(), sizeof(std::complex<double>), N, f) == N;
+		}
+		ok = (fclose(f) == 0) && ok;
+
+		if (ok)
+			ok = std::rename(tmp_filename.c_str(), i_filename.c_str()) == 0;
+
+		if (!ok)
+		{
+			std::cerr << "WARNING: Unable to write REXI coefficient cache file " << i_filename << std::endl;
+			std::remove(tmp_filename.c_str());
+		}
+
+		return ok;
+	}
+
+
+	/**
+	 * Lookup coefficients in the in-memory cache and, if not available,
+	 * in the cache directory.
+	 *
+	 * \return true if the coefficients were found
+	 */
+	static
+	bool load(
+			const Key &i_key,
+			std::vector<std::complex<double>> &o_alpha,
+			std::vector<std::complex<double>> &o_beta_re,
+			std::vector<std::complex<double>> &o_beta_im
+	)
+	{
+		REXICoefficientCache &c = getSingletonRef();
+		bool found = false;
+
+#pragma omp critical (REXICoefficientCache)
+		{
+			for (auto &e : c.entries)
+			{
+				if (!(e.key == i_key))
+					continue;
+
+				o_alpha = e.alpha;
+				o_beta_re = e.beta_re;
+				o_beta_im = e.beta_im;
+				found = true;
+				break;
+			}
+
+			if (!found && c.cache_directory != "")
+			{
+				found = loadFile(getCacheFilename(c.cache_directory, i_key), i_key, o_alpha, o_beta_re, o_beta_im);
+
+				if (found)
+					c.entries.push_back(Entry{i_key, o_alpha, o_beta_re, o_beta_im});
+			}
+		}
+
+		return found;
+	}
+
+
+	/**
+	 * Store coefficients in the in-memory cache and in the cache directory
+	 */
+	static
+	void store(
+			const Key &i_key,
+			const std::vector<std::complex<double>> &i_alpha,
+			const std::vector<std::complex<double>> &i_beta_re,
+			const std::vector<std::complex<double>> &i_beta_im
+	)
+	{
+		REXICoefficientCache &c = getSingletonRef();
+
+#pragma omp critical (REXICoefficientCache)
+		{
+			bool found = false;
+			for (auto &e : c.entries)
+				if (e.key == i_key)
+					found = true;
+
+			if (!found)
+			{
+				c.entries.push_back(Entry{i_key, i_alpha, i_beta_re, i_beta_im});
+
+				if (c.cache_directory != "")
+					writeFile(getCacheFilename(c.cache_directory, i_key), i_key, i_alpha, i_beta_re, i_beta_im);
+			}
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_REXI_REXICOEFFICIENTCACHE_HPP_ */
@@ -0,0 +1,345 @@
+/*
+ * REXIPoleScheduler.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_REXI_REXIPOLESCHEDULER_HPP_
+#define SRC_INCLUDE_REXI_REXIPOLESCHEDULER_HPP_
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+#include <sweet/Stopwatch.hpp>
+#include <sweet/FatalError.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
+
+
+/**
+ * Dynamic scheduler for the poles of the REXI sum
+ *
+ * Each MPI rank owns a contiguous range of poles.
+ * This range is split into a fixed number of chunks and the threads pull
+ * chunks until all of them are processed. Hence, threads which are slowed down
+ * (e.g. by sharing cores with other threads) simply process less chunks.
+ *
+ * The poles of a chunk are accumulated into the accumulator of this chunk
+ * (not of the thread) and the accumulators are reduced in chunk order.
+ * This keeps the REXI sum bitwise reproducible regardless of which thread
+ * processed which chunk.
+ *
+ * Optionally, the time spent on the poles is measured for each rank and
+ * the ranges are rebalanced between time steps according to the measured cost
+ * per pole. Since this changes the poles summed up on each rank and therefore
+ * the summation order across ranks, results are then no longer bitwise reproducible.
+ *
+ * Usage for each time step:
+ *
+ *   scheduler.startStep();
+ *
+ *   (in parallel region)
+ *   while (scheduler.getNextChunk(chunk_id, start, end))
+ *   {
+ *   	(zero accumulator of chunk_id and add poles [start, end) to it)
+ *   	scheduler.addWorkTime(thread_id, seconds);
+ *   }
+ *
+ *   (reduce accumulators of all chunks, e.g. with treeReduction)
+ *
+ *   scheduler.rebalance();	// collective over all ranks
+ */
+class REXIPoleScheduler
+{
+	/// total number of poles
+	std::size_t num_poles;
+
+	/// number of threads on this rank
+	int num_local_threads;
+
+	int mpi_rank;
+	int num_mpi_ranks;
+
+	/// number of chunks of poles on each rank
+	std::size_t num_chunks;
+
+	/// rebalance the pole ranges across ranks
+	bool rebalance_ranks;
+
+	/// start of pole range for each rank, the last entry is num_poles
+	std::vector<std::size_t> rank_poles_start;
+
+	/// next chunk to be processed on this rank
+	std::atomic<std::size_t> next_chunk;
+
+	/// accumulated time for solving the poles of each thread.
+	/// padded to avoid false sharing
+	std::vector<double> thread_work_time;
+
+	static const int thread_work_time_padding = 8;
+
+
+public:
+	REXIPoleScheduler()	:
+		num_poles(0),
+		num_local_threads(1),
+		mpi_rank(0),
+		num_mpi_ranks(1),
+		num_chunks(1),
+		rebalance_ranks(false),
+		next_chunk(0)
+	{
+	}
+
+
+
+	/**
+	 * Setup the scheduler with an even distribution of the poles across all ranks
+	 */
+	void setup(
+			std::size_t i_num_poles,		///< total number of poles
+			int i_num_local_threads,		///< number of threads on this rank
+			int i_mpi_rank,
+			int i_num_mpi_ranks,
+			bool i_rebalance_ranks = false,	///< rebalance pole ranges across ranks (not bitwise reproducible)
+			int i_chunks_per_thread = 2		///< number of chunks per thread
+	)
+	{
+		num_poles = i_num_poles;
+		num_local_threads = i_num_local_threads;
+		mpi_rank = i_mpi_rank;
+		num_mpi_ranks = i_num_mpi_ranks;
+		rebalance_ranks = i_rebalance_ranks;
+
+		rank_poles_start.resize(num_mpi_ranks+1);
+		for (int r = 0; r < num_mpi_ranks+1; r++)
+			rank_poles_start[r] = (num_poles*r)/num_mpi_ranks;
+
+		/*
+		 * Use several chunks per thread to compensate for load imbalances.
+		 * Each chunk requires its own accumulator, hence we keep their number small.
+		 *
+		 * The number of chunks is independent of the pole range of this rank
+		 * to keep the number of accumulators fixed if ranges are rebalanced.
+		 */
+		num_chunks = std::max(1, i_chunks_per_thread*num_local_threads);
+
+		thread_work_time.resize(num_local_threads*thread_work_time_padding);
+		startStep();
+	}
+
+
+
+	/**
+	 * Return the number of chunks, hence the number of accumulators
+	 */
+	std::size_t getNumChunks()	const
+	{
+		return num_chunks;
+	}
+
+
+
+	/**
+	 * Return the first pole of this rank
+	 */
+	std::size_t getLocalStart()	const
+	{
+		return rank_poles_start[mpi_rank];
+	}
+
+
+	/**
+	 * Return the end of the range of poles of this rank
+	 */
+	std::size_t getLocalEnd()	const
+	{
+		return rank_poles_start[mpi_rank+1];
+	}
+
+
+
+	/**
+	 * Prepare the next time step.
+	 *
+	 * This must not be called from a parallel region.
+	 */
+	void startStep()
+	{
+		next_chunk = 0;
+
+		for (std::size_t i = 0; i < thread_work_time.size(); i++)
+			thread_work_time[i] = 0;
+	}
+
+
+
+	/**
+	 * Get the next chunk of poles to be processed by the calling thread
+	 *
+	 * The range of poles of a chunk may be empty.
+	 *
+	 * \return false if all chunks were already processed
+	 */
+	bool getNextChunk(
+			std::size_t &o_chunk_id,
+			std::size_t &o_start,
+			std::size_t &o_end
+	)
+	{
+		o_chunk_id = next_chunk++;
+		if (o_chunk_id >= num_chunks)
+			return false;
+
+		std::size_t local_start = getLocalStart();
+		std::size_t local_poles = getLocalEnd()-local_start;
+
+		o_start = local_start + (local_poles*o_chunk_id)/num_chunks;
+		o_end = local_start + (local_poles*(o_chunk_id+1))/num_chunks;
+		return true;
+	}
+
+
+
+	/**
+	 * Account time spent by a thread for solving poles
+	 */
+	void addWorkTime(
+			int i_local_thread_id,
+			double i_seconds
+	)
+	{
+		thread_work_time[i_local_thread_id*thread_work_time_padding] += i_seconds;
+	}
+
+
+
+	/**
+	 * Rebalance the pole ranges of the ranks based on the measured cost per pole.
+	 *
+	 * This is a collective operation and has to be called by all ranks after each time step.
+	 * Nothing is done if rebalancing is not activated.
+	 */
+	void rebalance()
+	{
+#if SWEET_MPI
+		if (num_mpi_ranks == 1 || !rebalance_ranks)
+			return;
+
+		double local_data[2];
+
+		// total time of all threads
+		local_data[0] = 0;
+		for (int i = 0; i < num_local_threads; i++)
+			local_data[0] += thread_work_time[i*thread_work_time_padding];
+
+		// number of threads
+		local_data[1] = num_local_threads;
+
+		std::vector<double> data(num_mpi_ranks*2);
+		MPI_Allgather(local_data, 2, MPI_DOUBLE, data.data(), 2, MPI_DOUBLE, MPI_COMM_WORLD);
+
+		/*
+		 * Determine the throughput (poles per second) for each rank
+		 */
+		std::vector<double> throughput(num_mpi_ranks);
+		double avg_throughput = 0;
+		int num_valid = 0;
+
+		for (int r = 0; r < num_mpi_ranks; r++)
+		{
+			std::size_t poles = rank_poles_start[r+1]-rank_poles_start[r];
+			double time = data[r*2];
+
+			if (poles == 0 || time <= 0)
+			{
+				throughput[r] = -1;
+				continue;
+			}
+
+			// cost per pole is time/poles, all threads are working concurrently
+			throughput[r] = (double)poles/time*data[r*2+1];
+			avg_throughput += throughput[r];
+			num_valid++;
+		}
+
+		if (num_valid == 0)
+			return;
+
+		avg_throughput /= (double)num_valid;
+
+		double sum_throughput = 0;
+		for (int r = 0; r < num_mpi_ranks; r++)
+		{
+			// Use the average for ranks without measurements
+			if (throughput[r] < 0)
+				throughput[r] = avg_throughput;
+
+			sum_throughput += throughput[r];
+		}
+
+		/*
+		 * Distribute poles proportional to throughput.
+		 *
+		 * This is computed identically on all ranks since all of them use the same data.
+		 */
+		double accum = 0;
+		rank_poles_start[0] = 0;
+		for (int r = 1; r < num_mpi_ranks; r++)
+		{
+			accum += throughput[r-1];
+			rank_poles_start[r] = std::min(num_poles, (std::size_t)(accum/sum_throughput*(double)num_poles + 0.5));
+			rank_poles_start[r] = std::max(rank_poles_start[r], rank_poles_start[r-1]);
+		}
+		rank_poles_start[num_mpi_ranks] = num_poles;
+#endif
+	}
+
+
+
+	/**
+	 * Combine per-thread data with a parallel tree reduction.
+	 *
+	 * In each level, i_add_fun(dst, src) is called to add the data of thread src
+	 * to the data of thread dst. The result is finally stored for thread 0.
+	 *
+	 * The pairs only depend on the number of entries, hence the order of
+	 * the summation is always the same.
+	 */
+	template <typename TAddFun>
+	static
+	void treeReduction(
+			int i_num_threads,
+			TAddFun i_add_fun
+	)
+	{
+		for (int stride = 1; stride < i_num_threads; stride *= 2)
+		{
+			if (2*stride >= i_num_threads)
+			{
+				// single pair left: let the add itself run in parallel
+				i_add_fun(0, stride);
+				break;
+			}
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp parallel for schedule(static,1)
+#endif
+			for (int dst = 0; dst < i_num_threads; dst += 2*stride)
+			{
+				int src = dst+stride;
+
+				if (src < i_num_threads)
+					i_add_fun(dst, src);
+			}
+		}
+	}
+};
+
+
+#endif /* SRC_INCLUDE_REXI_REXIPOLESCHEDULER_HPP_ */
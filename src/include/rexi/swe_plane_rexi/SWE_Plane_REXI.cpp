@@ -39,7 +39,8 @@
 
 
 SWE_Plane_REXI::SWE_Plane_REXI()	:
-	planeDataConfig(nullptr)
+	planeDataConfig(nullptr),
+	planeDataConfigIO(nullptr)
 {
 #if !SWEET_USE_LIBFFT
 	std::cerr << "Spectral space required for solvers, use compile option --libfft=enable" << std::endl;
@@ -82,6 +83,19 @@ void SWE_Plane_REXI::cleanup()
 	}
 
 	perThreadVars.resize(0);
+
+	for (std::vector<PerChunkVars*>::iterator iter = perChunkVars.begin(); iter != perChunkVars.end(); iter++)
+	{
+		PerChunkVars* p = *iter;
+		delete p;
+	}
+
+	perChunkVars.resize(0);
+
+	PlaneDataConfigRegistry::releaseConfig(planeDataConfig);
+
+	planeDataConfig = nullptr;
+	planeDataConfigIO = nullptr;
 }
 
 
@@ -116,10 +130,22 @@ void SWE_Plane_REXI::setup(
 		const double *i_domain_size,	///< size of domain
 
 		bool i_rexi_half,				///< use half-pole reduction
-		bool i_rexi_normalization
+		bool i_rexi_normalization,
+		bool i_rebalance_ranks			///< rebalance poles across ranks
 )
 {
-	planeDataConfig = i_planeDataConfig;
+	cleanup();
+
+	/*
+	 * Share the FFTW plans with all other users of this resolution
+	 */
+	planeDataConfig = PlaneDataConfigRegistry::getConfig(
+			i_planeDataConfig->physical_res[0],
+			i_planeDataConfig->physical_res[1],
+			i_planeDataConfig->spectral_modes[0],
+			i_planeDataConfig->spectral_modes[1]
+		);
+	planeDataConfigIO = i_planeDataConfig;
 
 	M = i_M;
 	h = i_h;
@@ -127,16 +153,16 @@ void SWE_Plane_REXI::setup(
 	domain_size[0] = i_domain_size[0];
 	domain_size[1] = i_domain_size[1];
 
-	rexi.setup(0, h, M, i_L, i_rexi_half, i_rexi_normalization);
+#if !SWEET_USE_PLANE_SPECTRAL_SPACE
+	helmholtzMultigrid.setup(planeDataConfig, domain_size);
+#endif
 
-	std::size_t N = rexi.alpha.size();
-	block_size = N/num_global_threads;
-	if (block_size*num_global_threads != N)
-		block_size++;
+	rexi.setup(0, h, M, i_L, i_rexi_half, i_rexi_normalization);
 
-	cleanup();
+	poleScheduler.setup(rexi.alpha.size(), num_local_rexi_par_threads, mpi_rank, num_mpi_ranks, i_rebalance_ranks);
 
 	perThreadVars.resize(num_local_rexi_par_threads);
+	perChunkVars.resize(poleScheduler.getNumChunks());
 
 	/**
 	 * We split the setup from the utilization here.
@@ -160,95 +186,81 @@ void SWE_Plane_REXI::setup(
 
 	PlaneDataConfig *planeDataConfig_local = this->planeDataConfig;
 
-	// use a kind of serialization of the input to avoid threading conflicts in the ComplexFFT generation
-	for (int j = 0; j < num_local_rexi_par_threads; j++)
-	{
-#if SWEET_REXI_THREAD_PARALLEL_SUM
-#	pragma omp parallel for schedule(static,1) default(none) shared(planeDataConfig_local, i_domain_size,std::cout,j)
-#endif
-		for (int i = 0; i < num_local_rexi_par_threads; i++)
-		{
-			if (i != j)
-				continue;
-
-#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
-			if (omp_get_thread_num() != i)
-			{
-				// leave this dummy std::cout in it to avoid the intel compiler removing this part
-				std::cout << "ERROR: thread " << omp_get_thread_num() << " number mismatch " << i << std::endl;
-				exit(-1);
-			}
-#endif
-
-			perThreadVars[i] = new PerThreadVars;
-
-			perThreadVars[i]->op.setup(planeDataConfig_local, i_domain_size);
-
-			perThreadVars[i]->eta.setup(planeDataConfig_local);
-			perThreadVars[i]->eta0.setup(planeDataConfig_local);
-			perThreadVars[i]->u0.setup(planeDataConfig_local);
-			perThreadVars[i]->v0.setup(planeDataConfig_local);
-			perThreadVars[i]->h_sum.setup(planeDataConfig_local);
-			perThreadVars[i]->u_sum.setup(planeDataConfig_local);
-			perThreadVars[i]->v_sum.setup(planeDataConfig_local);
-		}
-	}
-
-	if (num_local_rexi_par_threads == 0)
-	{
-		std::cerr << "FATAL ERROR C: omp_get_max_threads == 0" << std::endl;
-		exit(-1);
-	}
-
-	for (int i = 0; i < num_local_rexi_par_threads; i++)
-	{
-		if (perThreadVars[i]->op.diff_c_x.physical_space_data == nullptr)
-		{
-			std::cerr << "ARRAY NOT INITIALIZED!!!!" << std::endl;
-			exit(-1);
-		}
-	}
-
+	/*
+	 * The FFTW plans are shared via the registry, hence the per-thread
+	 * data can be set up concurrently by each thread (first touch)
+	 */
 #if SWEET_REXI_THREAD_PARALLEL_SUM
-#	pragma omp parallel for schedule(static,1) default(none)  shared(planeDataConfig_local, i_domain_size,std::cout)
+#	pragma omp parallel for schedule(static,1) default(none) shared(planeDataConfig_local, i_domain_size,std::cout)
 #endif
 	for (int i = 0; i < num_local_rexi_par_threads; i++)
 	{
 #if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
-//		int global_thread_id = omp_get_thread_num() + mpi_rank*num_local_rexi_par_threads;
 		if (omp_get_thread_num() != i)
 		{
 			// leave this dummy std::cout in it to avoid the intel compiler removing this part
 			std::cout << "ERROR: thread " << omp_get_thread_num() << " number mismatch " << i << std::endl;
 			exit(-1);
 		}
-#else
-
-//#if SWEET_REXI_THREAD_PARALLEL_SUM
-//		int global_thread_id = 0;
-//#endif
-
 #endif
 
-		if (perThreadVars[i]->eta.physical_space_data == nullptr)
-		{
-			std::cout << "ERROR, data == nullptr" << std::endl;
-			exit(-1);
-		}
+		MemBlockAlloc::Tag tag("SWE_Plane_REXI/PerThreadVars");
+
+		perThreadVars[i] = new PerThreadVars;
 
 		perThreadVars[i]->op.setup(planeDataConfig_local, i_domain_size);
 
+		perThreadVars[i]->eta.setup(planeDataConfig_local);
+		perThreadVars[i]->eta0.setup(planeDataConfig_local);
+		perThreadVars[i]->u0.setup(planeDataConfig_local);
+		perThreadVars[i]->v0.setup(planeDataConfig_local);
+
 		// initialize all values to account for first touch policy reason
 		perThreadVars[i]->eta.spectral_set_all(0, 0);
 		perThreadVars[i]->eta0.spectral_set_all(0, 0);
 
 		perThreadVars[i]->u0.spectral_set_all(0, 0);
 		perThreadVars[i]->v0.spectral_set_all(0, 0);
+	}
 
-		perThreadVars[i]->h_sum.spectral_set_all(0, 0);
-		perThreadVars[i]->u_sum.spectral_set_all(0, 0);
-		perThreadVars[i]->v_sum.spectral_set_all(0, 0);
+	int num_chunks = perChunkVars.size();
 
+	// the sums are returned to the caller, hence they use the config of the caller's data
+	PlaneDataConfig *planeDataConfigIO_local = this->planeDataConfigIO;
+
+#if SWEET_REXI_THREAD_PARALLEL_SUM
+#	pragma omp parallel for schedule(static,1) default(none) shared(planeDataConfigIO_local, num_chunks)
+#endif
+	for (int c = 0; c < num_chunks; c++)
+	{
+		MemBlockAlloc::Tag tag("SWE_Plane_REXI/PerChunkVars");
+
+		perChunkVars[c] = new PerChunkVars;
+
+		perChunkVars[c]->h_sum.setup(planeDataConfigIO_local);
+		perChunkVars[c]->u_sum.setup(planeDataConfigIO_local);
+		perChunkVars[c]->v_sum.setup(planeDataConfigIO_local);
+
+		perChunkVars[c]->h_sum.spectral_set_all(0, 0);
+		perChunkVars[c]->u_sum.spectral_set_all(0, 0);
+		perChunkVars[c]->v_sum.spectral_set_all(0, 0);
+	}
+
+	if (num_local_rexi_par_threads == 0)
+	{
+		std::cerr << "FATAL ERROR C: omp_get_max_threads == 0" << std::endl;
+		exit(-1);
+	}
+
+	for (int i = 0; i < num_local_rexi_par_threads; i++)
+	{
+		if (	perThreadVars[i]->op.diff_c_x.planeDataConfig == nullptr	||
+				perThreadVars[i]->eta.planeDataConfig == nullptr
+		)
+		{
+			std::cerr << "ARRAY NOT INITIALIZED!!!!" << std::endl;
+			exit(-1);
+		}
 	}
 
 
@@ -679,8 +691,6 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 {
 	typedef std::complex<double> complex;
 
-	std::size_t max_N = rexi.alpha.size();
-
 	io_h.request_data_physical();
 	io_u.request_data_physical();
 	io_v.request_data_physical();
@@ -702,13 +712,24 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 		stopwatch_broadcast.start();
 #endif
 
-	std::size_t data_size = io_h.planeDataConfig->physical_array_data_number_of_elements;
-	MPI_Bcast(io_h.physical_space_data, data_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	/*
+	 * Rank 0 might shorten the time step size (e.g. to hit output times),
+	 * hence it's sent along with the data. A NaN time step size
+	 * tells the workers to quit, see MPI_quitWorkers()
+	 */
+	MPI_Bcast(&i_timestep_size, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
-	if (std::isnan(io_h.physical_get(0,0)))
+	if (std::isnan(i_timestep_size))
 		return false;
 
+	std::size_t data_size = io_h.planeDataConfig->physical_array_data_number_of_elements;
+
+	io_h.request_data_physical();
+	MPI_Bcast(io_h.physical_space_data, data_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
+
+	io_u.request_data_physical();
+	io_v.request_data_physical();
 	MPI_Bcast(io_u.physical_space_data, data_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 	MPI_Bcast(io_v.physical_space_data, data_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
@@ -721,8 +742,10 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 
 
 
+	poleScheduler.startStep();
+
 #if SWEET_REXI_THREAD_PARALLEL_SUM
-#	pragma omp parallel for schedule(static,1) default(none) shared(i_parameters, i_timestep_size, io_h, io_u, io_v, max_N, std::cout, std::cerr)
+#	pragma omp parallel for schedule(static,1) default(none) shared(i_parameters, i_timestep_size, io_h, io_u, io_v, std::cout, std::cerr)
 #endif
 	for (int i = 0; i < num_local_rexi_par_threads; i++)
 	{
@@ -749,20 +772,12 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 		PlaneDataComplex &u0 = perThreadVars[i]->u0;
 		PlaneDataComplex &v0 = perThreadVars[i]->v0;
 
-		PlaneDataComplex &h_sum = perThreadVars[i]->h_sum;
-		PlaneDataComplex &u_sum = perThreadVars[i]->u_sum;
-		PlaneDataComplex &v_sum = perThreadVars[i]->v_sum;
-
 		PlaneDataComplex &eta = perThreadVars[i]->eta;
 
 
 		/*
 		 * INITIALIZATION - THIS IS THE NON-PARALLELIZABLE PART!
 		 */
-		h_sum.spectral_set_all(0, 0);
-		u_sum.spectral_set_all(0, 0);
-		v_sum.spectral_set_all(0, 0);
-
 		eta0 = Convert_PlaneData_To_PlaneDataComplex::physical_convert(io_h);
 		u0 = Convert_PlaneData_To_PlaneDataComplex::physical_convert(io_u);
 		v0 = Convert_PlaneData_To_PlaneDataComplex::physical_convert(io_v);
@@ -777,22 +792,6 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 		u0 = u0*(1.0/i_timestep_size);
 		v0 = v0*(1.0/i_timestep_size);
 
-#if SWEET_REXI_THREAD_PARALLEL_SUM || SWEET_MPI
-
-#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
-		int local_thread_id = omp_get_thread_num();
-#else
-		int local_thread_id = 0;
-#endif
-		int global_thread_id = local_thread_id + num_local_rexi_par_threads*mpi_rank;
-
-		std::size_t start = std::min(max_N, block_size*global_thread_id);
-		std::size_t end = std::min(max_N, start+block_size);
-#else
-		std::size_t start = 0;
-		std::size_t end = max_N;
-#endif
-
 
 		// reuse result from previous computations
 		// this significantly speeds up the process
@@ -823,41 +822,62 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 			stopwatch_solve_rexi_terms.start();
 #endif
 
-		for (std::size_t n = start; n < end; n++)
+		/*
+		 * Pull chunks of poles until all poles of this rank are processed.
+		 * Each chunk is accumulated separately to keep the summation order fixed.
+		 */
+		std::size_t chunk_id, start, end;
+		while (poleScheduler.getNextChunk(chunk_id, start, end))
 		{
-			// load alpha (a) and scale by inverse of tau
-			// we flip the sign to account for the -L used in exp(\tau (-L))
-			complex alpha = DQStuff::convertComplex<double>(rexi.alpha[n])/i_timestep_size;
-			complex beta = DQStuff::convertComplex<double>(rexi.beta_re[n]);
+			Stopwatch stopwatch_chunk;
 
-			// load kappa (k)
-			complex kappa = alpha*alpha + i_parameters.sim.f0*i_parameters.sim.f0;
+			PlaneDataComplex &h_sum = perChunkVars[chunk_id]->h_sum;
+			PlaneDataComplex &u_sum = perChunkVars[chunk_id]->u_sum;
+			PlaneDataComplex &v_sum = perChunkVars[chunk_id]->v_sum;
 
-			/*
-			 * TODO: we can even get more performance out of this operations
-			 * by partly using the real Fourier transformation
-			 */
-			PlaneDataComplex rhs =
-					(kappa/alpha) * eta0
-					+ (-i_parameters.sim.f0*eta_bar/alpha) * rhs_b
-					+ rhs_a
-				;
+			h_sum.spectral_set_all(0, 0);
+			u_sum.spectral_set_all(0, 0);
+			v_sum.spectral_set_all(0, 0);
 
-			PlaneDataComplex lhs = lhs_a.spectral_addScalarAll(kappa);
-//			rhs.spectral_div_element_wise(lhs, eta);
-			eta = rhs.spectral_div_element_wise(lhs);
+			for (std::size_t n = start; n < end; n++)
+			{
+				// load alpha (a) and scale by inverse of tau
+				// we flip the sign to account for the -L used in exp(\tau (-L))
+				complex alpha = DQStuff::convertComplex<double>(rexi.alpha[n])/i_timestep_size;
+				complex beta = DQStuff::convertComplex<double>(rexi.beta_re[n]);
+
+				// load kappa (k)
+				complex kappa = alpha*alpha + i_parameters.sim.f0*i_parameters.sim.f0;
+
+				/*
+				 * TODO: we can even get more performance out of this operations
+				 * by partly using the real Fourier transformation
+				 */
+				PlaneDataComplex rhs =
+						(kappa/alpha) * eta0
+						+ (-i_parameters.sim.f0*eta_bar/alpha) * rhs_b
+						+ rhs_a
+					;
 
-			PlaneDataComplex uh = u0 + g*opc.diff_c_x(eta);
-			PlaneDataComplex vh = v0 + g*opc.diff_c_y(eta);
+				PlaneDataComplex lhs = lhs_a.spectral_addScalarAll(kappa);
+//				rhs.spectral_div_element_wise(lhs, eta);
+				eta = rhs.spectral_div_element_wise(lhs);
 
-			PlaneDataComplex u1 = (alpha/kappa) * uh     - (i_parameters.sim.f0/kappa) * vh;
-			PlaneDataComplex v1 = (i_parameters.sim.f0/kappa) * uh + (alpha/kappa) * vh;
+				PlaneDataComplex uh = u0 + g*opc.diff_c_x(eta);
+				PlaneDataComplex vh = v0 + g*opc.diff_c_y(eta);
 
-			PlaneData tmp(h_sum.planeDataConfig);
+				PlaneDataComplex u1 = (alpha/kappa) * uh     - (i_parameters.sim.f0/kappa) * vh;
+				PlaneDataComplex v1 = (i_parameters.sim.f0/kappa) * uh + (alpha/kappa) * vh;
 
-			h_sum += eta*beta;
-			u_sum += u1*beta;
-			v_sum += v1*beta;
+				PlaneData tmp(h_sum.planeDataConfig);
+
+				h_sum += eta*beta;
+				u_sum += u1*beta;
+				v_sum += v1*beta;
+			}
+
+			stopwatch_chunk.stop();
+			poleScheduler.addWorkTime(i, stopwatch_chunk());
 		}
 
 #if SWEET_BENCHMARK_REXI
@@ -871,42 +891,28 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 		stopwatch_reduce.start();
 #endif
 
-#if SWEET_REXI_THREAD_PARALLEL_SUM
-	io_h.physical_set_all(0);
-	io_u.physical_set_all(0);
-	io_v.physical_set_all(0);
-
-	for (int n = 0; n < num_local_rexi_par_threads; n++)
-	{
-		perThreadVars[n]->h_sum.request_data_physical();
-		perThreadVars[n]->u_sum.request_data_physical();
-		perThreadVars[n]->v_sum.request_data_physical();
-
-		// sum real-valued elements
-		#pragma omp parallel for schedule(static)
-		for (std::size_t i = 0; i < io_h.planeDataConfig->physical_array_data_number_of_elements; i++)
-			io_h.physical_space_data[i] += perThreadVars[n]->h_sum.physical_space_data[i].real();
-
-		#pragma omp parallel for schedule(static)
-		for (std::size_t i = 0; i < io_h.planeDataConfig->physical_array_data_number_of_elements; i++)
-			io_u.physical_space_data[i] += perThreadVars[n]->u_sum.physical_space_data[i].real();
-
-		#pragma omp parallel for schedule(static)
-		for (std::size_t i = 0; i < io_h.planeDataConfig->physical_array_data_number_of_elements; i++)
-			io_v.physical_space_data[i] += perThreadVars[n]->v_sum.physical_space_data[i].real();
-	}
-
-#else
-
-	io_h = Convert_PlaneDataComplex_To_PlaneData::physical_convert(perThreadVars[0]->h_sum);
-	io_u = Convert_PlaneDataComplex_To_PlaneData::physical_convert(perThreadVars[0]->u_sum);
-	io_v = Convert_PlaneDataComplex_To_PlaneData::physical_convert(perThreadVars[0]->v_sum);
+	/*
+	 * The REXI sum is linear, hence we can first sum up the per-chunk
+	 * accumulators and then convert the result only once
+	 */
+	REXIPoleScheduler::treeReduction(
+			perChunkVars.size(),
+			[&](int i_dst, int i_src)
+			{
+				perChunkVars[i_dst]->h_sum += perChunkVars[i_src]->h_sum;
+				perChunkVars[i_dst]->u_sum += perChunkVars[i_src]->u_sum;
+				perChunkVars[i_dst]->v_sum += perChunkVars[i_src]->v_sum;
+			}
+		);
 
-#endif
+	io_h = Convert_PlaneDataComplex_To_PlaneData::physical_convert(perChunkVars[0]->h_sum);
+	io_u = Convert_PlaneDataComplex_To_PlaneData::physical_convert(perChunkVars[0]->u_sum);
+	io_v = Convert_PlaneDataComplex_To_PlaneData::physical_convert(perChunkVars[0]->v_sum);
 
 
 #if SWEET_MPI
 	PlaneData tmp(io_h.planeDataConfig);
+	tmp.physical_alloc_buffer();
 
 	io_h.request_data_physical();
 	int retval = MPI_Reduce(io_h.physical_space_data, tmp.physical_space_data, data_size, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
@@ -933,6 +939,9 @@ bool SWE_Plane_REXI::run_timestep_rexi(
 		stopwatch_reduce.stop();
 #endif
 
+	// redistribute poles across ranks based on the measured costs
+	poleScheduler.rebalance();
+
 	return true;
 }
 
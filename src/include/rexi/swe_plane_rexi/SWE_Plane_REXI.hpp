@@ -10,13 +10,18 @@
 
 #include <complex>
 #include <rexi/REXI.hpp>
+#include <rexi/REXIPoleScheduler.hpp>
 #include <sweet/SimulationVariables.hpp>
 #include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataConfigRegistry.hpp>
 #include <sweet/plane/PlaneDataComplex.hpp>
 #include <sweet/plane/PlaneOperatorsComplex.hpp>
 #include <sweet/plane/PlaneDataSemiLagrangian.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
 #include <sweet/plane/PlaneDataSampler.hpp>
+#if !SWEET_USE_PLANE_SPECTRAL_SPACE
+#	include <sweet/plane/PlaneDataHelmholtzMultigrid.hpp>
+#endif
 
 
 #define SWEET_BENCHMARK_REXI	0
@@ -50,10 +55,25 @@ class SWE_Plane_REXI
 	// simulation domain size
 	double domain_size[2];
 
-	std::size_t block_size;
+	// scheduler to distribute the poles across threads and ranks
+	REXIPoleScheduler poleScheduler;
 
+	/*
+	 * Config used for the REXI terms.
+	 * This is shared via the PlaneDataConfigRegistry
+	 */
 	PlaneDataConfig *planeDataConfig;
 
+	/*
+	 * Config of the data of the caller
+	 */
+	PlaneDataConfig *planeDataConfigIO;
+
+#if !SWEET_USE_PLANE_SPECTRAL_SPACE
+	// multigrid solver for Helmholtz problems with finite differences
+	PlaneDataHelmholtzMultigrid helmholtzMultigrid;
+#endif
+
 #if SWEET_BENCHMARK_REXI
 	Stopwatch stopwatch_preprocessing;
 	Stopwatch stopwatch_broadcast;
@@ -74,14 +94,21 @@ class SWE_Plane_REXI
 		PlaneDataComplex eta0;
 		PlaneDataComplex u0;
 		PlaneDataComplex v0;
+	};
+
+	// per-thread allocated variables to avoid NUMA domain effects
+	std::vector<PerThreadVars*> perThreadVars;
 
+	class PerChunkVars
+	{
+	public:
 		PlaneDataComplex h_sum;
 		PlaneDataComplex u_sum;
 		PlaneDataComplex v_sum;
 	};
 
-	// per-thread allocated variables to avoid NUMA domain effects
-	std::vector<PerThreadVars*> perThreadVars;
+	// accumulators for each chunk of poles, see REXIPoleScheduler
+	std::vector<PerChunkVars*> perChunkVars;
 
 	// number of threads to be used
 	int num_local_rexi_par_threads;
@@ -124,7 +151,8 @@ public:
 			PlaneDataConfig *i_planeDataConfig,
 			const double *i_domain_size,		///< size of domain
 			bool i_rexi_half = true,			///< use half-pole reduction
-			bool i_rexi_normalization = true
+			bool i_rexi_normalization = true,
+			bool i_rebalance_ranks = false		///< rebalance poles across ranks (not bitwise reproducible)
 	);
 
 
@@ -220,8 +248,12 @@ public:
 
 		io_x = i_rhs.spectral_div_element_wise(lhs);
 #else
-		std::cerr << "Cannot use helmholtz_spectral_solver if spectral space not enable in compilation time" << std::endl;
-		exit(1);
+		/*
+		 * Without spectral space, use the multigrid solver
+		 * with the 5-point finite-difference Laplacian
+		 */
+		if (!helmholtzMultigrid.solve(i_kappa, i_gh0, i_rhs, io_x))
+			FatalError("Multigrid solver for Helmholtz problem did not converge");
 #endif
 	}
 
@@ -361,18 +393,17 @@ public:
 
 
 public:
+	/**
+	 * Send a NaN time step size to stop the workers,
+	 * see run_timestep_rexi()
+	 */
 	inline
 	static
-	void MPI_quitWorkers(
-			PlaneDataConfig *i_planeDataConfig
-	)
+	void MPI_quitWorkers()
 	{
 #if SWEET_MPI
-	PlaneData dummyData(i_planeDataConfig);
-	dummyData.physical_set_all(NAN);
-
-	MPI_Bcast(dummyData.physical_space_data, dummyData.planeDataConfig->physical_array_data_number_of_elements, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-
+	double timestep_size = NAN;
+	MPI_Bcast(&timestep_size, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 #endif
 	}
 
@@ -6,6 +6,8 @@
  */
 
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <rexi/REXI.hpp>
 
 
@@ -40,7 +42,9 @@
 SWE_Sphere_REXI::SWE_Sphere_REXI()	:
 	normalization(true),
 	sphereDataConfig(nullptr),
-	sphereDataConfigRexi(nullptr)
+	sphereDataConfigRexi(nullptr),
+	solver_cache_size(0),
+	currentSolvers(nullptr)
 {
 #if !SWEET_USE_LIBFFT
 	std::cerr << "Spectral space required for solvers, use compile option --libfft=enable" << std::endl;
@@ -80,13 +84,18 @@ SWE_Sphere_REXI::SWE_Sphere_REXI()	:
 
 void SWE_Sphere_REXI::cleanup()
 {
-	for (std::vector<PerThreadVars*>::iterator iter = perThreadVars.begin(); iter != perThreadVars.end(); iter++)
+	for (std::vector<PerChunkVars*>::iterator iter = perChunkVars.begin(); iter != perChunkVars.end(); iter++)
 	{
-		PerThreadVars* p = *iter;
+		PerChunkVars* p = *iter;
 		delete p;
 	}
 
-	perThreadVars.resize(0);
+	perChunkVars.resize(0);
+
+	solverCache.clear();
+	currentSolvers = nullptr;
+
+	SphereDataConfigRegistry::releaseConfig(sphereDataConfigRexi);
 
 	sphereDataConfigRexi = nullptr;
 	sphereDataConfig = nullptr;
@@ -110,39 +119,6 @@ SWE_Sphere_REXI::~SWE_Sphere_REXI()
 }
 
 
-void SWE_Sphere_REXI::get_workload_start_end(
-		std::size_t &o_start,
-		std::size_t &o_end
-)
-{
-	std::size_t max_N = rexi.alpha.size();
-
-#if SWEET_REXI_THREAD_PARALLEL_SUM || SWEET_MPI
-
-	#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
-		int local_thread_id = omp_get_thread_num();
-	#else
-		int local_thread_id = 0;
-	#endif
-
-	int global_thread_id = local_thread_id + num_local_rexi_par_threads*mpi_rank;
-
-	assert(block_size >= 0);
-	assert(global_thread_id >= 0);
-
-	o_start = std::min(max_N, block_size*global_thread_id);
-	o_end = std::min(max_N, o_start+block_size);
-
-#else
-
-	o_start = 0;
-	o_end = max_N;
-
-#endif
-}
-
-
-
 /**
  * setup the REXI
  */
@@ -160,7 +136,9 @@ void SWE_Sphere_REXI::setup(
 		bool i_use_robert_functions,	///< use Robert functions
 		int i_rexi_use_extended_modes,
 		int i_rexi_normalization,
-		bool i_use_coriolis_rexi_formulation
+		bool i_use_coriolis_rexi_formulation,
+		int i_solver_cache_size,		///< number of time step sizes for which the solvers are kept (0: no preallocation)
+		bool i_rebalance_ranks			///< rebalance poles across ranks
 )
 {
 	cleanup();
@@ -176,33 +154,37 @@ void SWE_Sphere_REXI::setup(
 	use_robert_functions = i_use_robert_functions;
 	rexi_use_extended_modes = i_rexi_use_extended_modes;
 	use_coriolis_rexi_formulation = i_use_coriolis_rexi_formulation;
-	use_rexi_preallocation = false;
+	solver_cache_size = i_solver_cache_size;
+	use_rexi_preallocation = (solver_cache_size > 0);
 
 
 	if (rexi_use_extended_modes == 0)
 	{
-		sphereDataConfigRexi = sphereDataConfig;
+		// Share the SHTns tables with all other users of this grid
+		sphereDataConfigRexi = SphereDataConfigRegistry::getConfig(
+				sphereDataConfig->spectral_modes_m_max,
+				sphereDataConfig->spectral_modes_n_max,
+				sphereDataConfig->physical_num_lon,
+				sphereDataConfig->physical_num_lat
+		);
 	}
 	else
 	{
 		// Add modes only along latitude since these are the "problematic" modes
-		sphereConfigRexiAddedModes.setupAdditionalModes(
+		sphereDataConfigRexi = SphereDataConfigRegistry::getConfigAdditionalModes(
 				sphereDataConfig,
 				rexi_use_extended_modes,	// TODO: Extend SPH wrapper to also support m != n to set this guy to 0
 				rexi_use_extended_modes
 		);
-		sphereDataConfigRexi = &sphereConfigRexiAddedModes;
 	}
 
 
 	rexi.setup(0, h, M, i_L, i_rexi_half, normalization);
 
 	std::size_t N = rexi.alpha.size();
-	block_size = N/num_global_threads;
-	if (block_size*num_global_threads != N)
-		block_size++;
+	poleScheduler.setup(N, num_local_rexi_par_threads, mpi_rank, num_mpi_ranks, i_rebalance_ranks);
 
-	perThreadVars.resize(num_local_rexi_par_threads);
+	perChunkVars.resize(poleScheduler.getNumChunks());
 
 
 	/**
@@ -218,109 +200,40 @@ void SWE_Sphere_REXI::setup(
 	}
 
 #if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
-	if (omp_in_parallel())
+	/*
+	 * Nested parallel regions are fine as long as they are active
+	 * (e.g. one thread team per batch job, see BatchJobRunner)
+	 */
+	if (omp_in_parallel() && omp_get_active_level() >= omp_get_max_active_levels())
 	{
 		std::cerr << "FATAL ERROR X: in parallel region" << std::endl;
 		exit(-1);
 	}
 #endif
 
-	// use a kind of serialization of the input to avoid threading conflicts in the ComplexFFT generation
-	for (int j = 0; j < num_local_rexi_par_threads; j++)
-	{
-#if SWEET_REXI_THREAD_PARALLEL_SUM
-#	pragma omp parallel for schedule(static,1) default(none) shared(std::cout,j)
-#endif
-		for (int i = 0; i < num_local_rexi_par_threads; i++)
-		{
-			if (i != j)
-				continue;
-
-#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
-			if (omp_get_thread_num() != i)
-			{
-				// leave this dummy std::cout in it to avoid the intel compiler removing this part
-				std::cout << "ERROR: thread " << omp_get_thread_num() << " number mismatch " << i << std::endl;
-				exit(-1);
-			}
-#endif
-
-			perThreadVars[i] = new PerThreadVars;
-
-			std::size_t start, end;
-			get_workload_start_end(start, end);
-			int local_size = (int)end-(int)start;
-
-#if 0
-#pragma omp critical
-			std::cout << start << "\t" << end << "\t" << local_size << "\t" << block_size << std::endl;
-#endif
+	/*
+	 * The transformations are shared via the config, hence the per-chunk
+	 * data can be set up concurrently (first touch)
+	 */
+	int num_chunks = perChunkVars.size();
 
-#if SWEET_DEBUG
-			if (local_size < 0)
-				FatalError("local_size < 0");
+#if SWEET_REXI_THREAD_PARALLEL_SUM
+#	pragma omp parallel for schedule(static,1) default(none) shared(num_chunks)
 #endif
+	for (int c = 0; c < num_chunks; c++)
+	{
+		MemBlockAlloc::Tag tag("SWE_Sphere_REXI/PerChunkVars");
 
-			perThreadVars[i]->alpha.resize(local_size);
-			perThreadVars[i]->beta_re.resize(local_size);
-
-			perThreadVars[i]->accum_phi.setup(sphereDataConfigRexi);
-			perThreadVars[i]->accum_u.setup(sphereDataConfigRexi);
-			perThreadVars[i]->accum_v.setup(sphereDataConfigRexi);
-
-
-			for (std::size_t n = start; n < end; n++)
-			{
-				int thread_local_idx = n-start;
-
-				perThreadVars[i]->alpha[thread_local_idx] = rexi.alpha[n];
-				perThreadVars[i]->beta_re[thread_local_idx] = rexi.beta_re[n];
-			}
-
-			if (use_rexi_preallocation)
-			{
-				if (use_robert_functions)
-					perThreadVars[i]->rexiSPHRobert_vector.resize(local_size);
-				else
-					perThreadVars[i]->rexiSPH_vector.resize(local_size);
-
-				for (std::size_t n = start; n < end; n++)
-				{
-					int thread_local_idx = n-start;
+		perChunkVars[c] = new PerChunkVars;
 
-					if (use_robert_functions)
-					{
-//#pragma omp critical
-//						std::cout << mpi_rank << " - thread_local_idx: " << thread_local_idx << "        alpha: " << perThreadVars[i]->alpha[thread_local_idx] << std::endl;
+		perChunkVars[c]->accum_phi.setup(sphereDataConfigRexi);
+		perChunkVars[c]->accum_u.setup(sphereDataConfigRexi);
+		perChunkVars[c]->accum_v.setup(sphereDataConfigRexi);
 
-						perThreadVars[i]->rexiSPHRobert_vector[thread_local_idx].setup(
-								sphereDataConfigRexi,
-								sphereDataConfig,
-								perThreadVars[i]->alpha[thread_local_idx],
-								perThreadVars[i]->beta_re[thread_local_idx],
-								simCoeffs->earth_radius,
-								simCoeffs->coriolis_omega,
-								simCoeffs->h0 * simCoeffs->gravitation,
-								timestep_size,
-								use_coriolis_rexi_formulation
-						);
-					}
-					else
-					{
-						perThreadVars[i]->rexiSPH_vector[thread_local_idx].setup(
-								sphereDataConfigRexi,
-								perThreadVars[i]->alpha[thread_local_idx],
-								perThreadVars[i]->beta_re[thread_local_idx],
-								simCoeffs->earth_radius,
-								simCoeffs->coriolis_omega,
-								simCoeffs->h0*simCoeffs->gravitation,
-								timestep_size,
-								use_coriolis_rexi_formulation
-						);
-					}
-				}
-			}
-		}
+		// first touch
+		perChunkVars[c]->accum_phi.spectral_set_zero();
+		perChunkVars[c]->accum_u.spectral_set_zero();
+		perChunkVars[c]->accum_v.spectral_set_zero();
 	}
 
 	if (num_local_rexi_par_threads == 0)
@@ -343,6 +256,67 @@ void SWE_Sphere_REXI::setup(
 
 
 
+/**
+ * Return the preallocated solvers for the given time step size.
+ *
+ * Setting up the solvers (assembling and factorizing the banded matrices)
+ * is expensive, hence they are cached for the last solver_cache_size
+ * time step sizes. If the cache is full, the least recently used
+ * solvers are released.
+ *
+ * Poles can be processed by any thread, hence the solvers are only
+ * allocated here and set up by the thread which first uses them.
+ */
+SWE_Sphere_REXI::PreallocatedSolvers* SWE_Sphere_REXI::p_getPreallocatedSolvers(
+		double i_timestep_size
+)
+{
+	for (std::list<PreallocatedSolvers>::iterator iter = solverCache.begin(); iter != solverCache.end(); iter++)
+	{
+		// compare bitwise, the solvers are only valid for exactly this time step size
+		if (std::memcmp(&iter->timestep_size, &i_timestep_size, sizeof(double)) != 0)
+			continue;
+
+		// move to front
+		solverCache.splice(solverCache.begin(), solverCache, iter);
+		return &solverCache.front();
+	}
+
+	if ((int)solverCache.size() >= solver_cache_size)
+		solverCache.pop_back();
+
+	solverCache.emplace_front();
+	PreallocatedSolvers &s = solverCache.front();
+
+	std::size_t N = rexi.alpha.size();
+
+	s.timestep_size = i_timestep_size;
+	if (use_robert_functions)
+		s.rexiSPHRobert_vector.resize(N);
+	else
+		s.rexiSPH_vector.resize(N);
+
+	s.rexi_pole_is_setup.assign(N, 0);
+
+	return &s;
+}
+
+
+
+double SWE_Sphere_REXI::snapTimestepSizeToCache(
+		double i_timestep_size,
+		double i_rel_tolerance
+)	const
+{
+	for (std::list<PreallocatedSolvers>::const_iterator iter = solverCache.begin(); iter != solverCache.end(); iter++)
+		if (std::abs(iter->timestep_size - i_timestep_size) <= i_rel_tolerance*iter->timestep_size)
+			return iter->timestep_size;
+
+	return i_timestep_size;
+}
+
+
+
 /**
  * Solve the REXI of \f$ U(t) = exp(L*t) \f$
  *
@@ -377,13 +351,19 @@ bool SWE_Sphere_REXI::run_timestep_rexi(
 			stopwatch_broadcast.start();
 	#endif
 
-		std::size_t spectral_data_num_doubles = io_prog_h0.sphereDataConfig->spectral_array_data_number_of_elements*2;
-
-		MPI_Bcast(io_prog_h0.spectral_space_data, spectral_data_num_doubles, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+		/*
+		 * Rank 0 might change the time step size (CFL, output times),
+		 * hence it's sent along with the data. A NaN time step size
+		 * tells the workers to quit, see MPI_quitWorkers()
+		 */
+		MPI_Bcast(&i_timestep_size, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
-		if (std::isnan(io_prog_h0.spectral_get(0,0).real()))
+		if (std::isnan(i_timestep_size))
 			return false;
 
+		std::size_t spectral_data_num_doubles = io_prog_h0.sphereDataConfig->spectral_array_data_number_of_elements*2;
+
+		MPI_Bcast(io_prog_h0.spectral_space_data, spectral_data_num_doubles, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 		MPI_Bcast(io_prog_u0.spectral_space_data, spectral_data_num_doubles, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 		MPI_Bcast(io_prog_v0.spectral_space_data, spectral_data_num_doubles, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
@@ -395,6 +375,11 @@ bool SWE_Sphere_REXI::run_timestep_rexi(
 #endif	// SWEET_MPI
 
 
+	if (use_rexi_preallocation)
+		currentSolvers = p_getPreallocatedSolvers(i_timestep_size);
+
+	poleScheduler.startStep();
+
 #if SWEET_REXI_THREAD_PARALLEL_SUM
 #	pragma omp parallel for schedule(static,1) default(none) shared(i_parameters, i_timestep_size, io_prog_h0, io_prog_u0, io_prog_v0, std::cout, std::cerr)
 #endif
@@ -415,9 +400,6 @@ bool SWE_Sphere_REXI::run_timestep_rexi(
 			stopwatch_preprocessing.start();
 #endif
 
-		std::size_t start, end;
-		get_workload_start_end(start, end);
-
 		/*
 		 * DO SUM IN PARALLEL
 		 */
@@ -451,93 +433,128 @@ bool SWE_Sphere_REXI::run_timestep_rexi(
 		SphereData tmp_prog_u(sphereDataConfigRexi);
 		SphereData tmp_prog_v(sphereDataConfigRexi);
 
-		perThreadVars[thread_id]->accum_phi.spectral_set_zero();
-		perThreadVars[thread_id]->accum_u.spectral_set_zero();
-		perThreadVars[thread_id]->accum_v.spectral_set_zero();
-
 
-		for (std::size_t workload_idx = start; workload_idx < end; workload_idx++)
+		/*
+		 * Pull chunks of poles until all poles of this rank are processed.
+		 * Each chunk is accumulated separately to keep the summation order fixed.
+		 */
+		std::size_t chunk_id, start, end;
+		while (poleScheduler.getNextChunk(chunk_id, start, end))
 		{
-			int local_idx = workload_idx-start;
+			Stopwatch stopwatch_chunk;
+
+			PerChunkVars *chunk = perChunkVars[chunk_id];
+
+			chunk->accum_phi.spectral_set_zero();
+			chunk->accum_u.spectral_set_zero();
+			chunk->accum_v.spectral_set_zero();
 
-			if (use_robert_functions)
+			for (std::size_t workload_idx = start; workload_idx < end; workload_idx++)
 			{
-				if (use_rexi_preallocation)
-				{
-					perThreadVars[thread_id]->rexiSPHRobert_vector[local_idx].solve(
-							thread_prog_phi0, thread_prog_u0, thread_prog_v0,
-							tmp_prog_phi, tmp_prog_u, tmp_prog_v
-						);
-				}
-				else
+				const std::complex<double> &alpha = rexi.alpha[workload_idx];
+				const std::complex<double> &beta_re = rexi.beta_re[workload_idx];
+
+				if (use_robert_functions)
 				{
-					SWERexiTerm_SPHRobert rexiSPHRobert;
-
-					std::complex<double> &alpha = perThreadVars[thread_id]->alpha[local_idx];
-					std::complex<double> &beta_re = perThreadVars[thread_id]->beta_re[local_idx];
-
-					rexiSPHRobert.setup(
-							sphereDataConfigRexi,	///< sphere data for input data
-							sphereDataConfig,		///< sphereData for solver (should be truncated!)
-							alpha,
-							beta_re,
-							simCoeffs->earth_radius,
-							simCoeffs->coriolis_omega,
-							simCoeffs->h0*simCoeffs->gravitation,
-							i_timestep_size,
-							use_coriolis_rexi_formulation
-					);
-
-					rexiSPHRobert.solve(
-							thread_prog_phi0, thread_prog_u0, thread_prog_v0,
-							tmp_prog_phi, tmp_prog_u, tmp_prog_v
-						);
-#if 0
-#pragma omp critical
+					if (use_rexi_preallocation)
 					{
-						std::cout << mpi_rank << ": " << simCoeffs->earth_radius << "\t" << simCoeffs->coriolis_omega << "\t" << simCoeffs->h0*simCoeffs->gravitation << "\t" << i_timestep_size << std::endl;
-						std::cout << mpi_rank << ": " << alpha << ", " << beta_re << "\t" << tmp_prog_phi.physical_reduce_min() << ", " << tmp_prog_phi.physical_reduce_max() << std::endl;
+						// each pole is processed by only a single thread per time step
+						if (!currentSolvers->rexi_pole_is_setup[workload_idx])
+						{
+							currentSolvers->rexiSPHRobert_vector[workload_idx].setup(
+									sphereDataConfigRexi,
+									sphereDataConfig,
+									alpha,
+									beta_re,
+									simCoeffs->earth_radius,
+									simCoeffs->coriolis_omega,
+									simCoeffs->h0 * simCoeffs->gravitation,
+									i_timestep_size,
+									use_coriolis_rexi_formulation
+							);
+							currentSolvers->rexi_pole_is_setup[workload_idx] = 1;
+						}
+
+						currentSolvers->rexiSPHRobert_vector[workload_idx].solve(
+								thread_prog_phi0, thread_prog_u0, thread_prog_v0,
+								tmp_prog_phi, tmp_prog_u, tmp_prog_v
+							);
 					}
-#endif
-				}
-			}
-			else
-			{
-				if (use_rexi_preallocation)
-				{
-					perThreadVars[thread_id]->rexiSPH_vector[local_idx].solve(
-							thread_prog_phi0, thread_prog_u0, thread_prog_v0,
-							tmp_prog_phi, tmp_prog_u, tmp_prog_v
+					else
+					{
+						SWERexiTerm_SPHRobert rexiSPHRobert;
+
+						rexiSPHRobert.setup(
+								sphereDataConfigRexi,	///< sphere data for input data
+								sphereDataConfig,		///< sphereData for solver (should be truncated!)
+								alpha,
+								beta_re,
+								simCoeffs->earth_radius,
+								simCoeffs->coriolis_omega,
+								simCoeffs->h0*simCoeffs->gravitation,
+								i_timestep_size,
+								use_coriolis_rexi_formulation
 						);
+
+						rexiSPHRobert.solve(
+								thread_prog_phi0, thread_prog_u0, thread_prog_v0,
+								tmp_prog_phi, tmp_prog_u, tmp_prog_v
+							);
+					}
 				}
 				else
 				{
-					std::complex<double> &alpha = perThreadVars[thread_id]->alpha[local_idx];
-					std::complex<double> &beta_re = perThreadVars[thread_id]->beta_re[local_idx];
-
-					SWERexiTerm_SPH rexiSPH;
-					rexiSPH.setup(
-							sphereDataConfigRexi,
-							alpha,
-							beta_re,
-							simCoeffs->earth_radius,
-							simCoeffs->coriolis_omega,
-							simCoeffs->h0*simCoeffs->gravitation,
-							i_timestep_size,
-							use_coriolis_rexi_formulation
-					);
-
-					rexiSPH.solve(
-							thread_prog_phi0, thread_prog_u0, thread_prog_v0,
-							tmp_prog_phi, tmp_prog_u, tmp_prog_v
+					if (use_rexi_preallocation)
+					{
+						if (!currentSolvers->rexi_pole_is_setup[workload_idx])
+						{
+							currentSolvers->rexiSPH_vector[workload_idx].setup(
+									sphereDataConfigRexi,
+									alpha,
+									beta_re,
+									simCoeffs->earth_radius,
+									simCoeffs->coriolis_omega,
+									simCoeffs->h0*simCoeffs->gravitation,
+									i_timestep_size,
+									use_coriolis_rexi_formulation
+							);
+							currentSolvers->rexi_pole_is_setup[workload_idx] = 1;
+						}
+
+						currentSolvers->rexiSPH_vector[workload_idx].solve(
+								thread_prog_phi0, thread_prog_u0, thread_prog_v0,
+								tmp_prog_phi, tmp_prog_u, tmp_prog_v
+							);
+					}
+					else
+					{
+						SWERexiTerm_SPH rexiSPH;
+						rexiSPH.setup(
+								sphereDataConfigRexi,
+								alpha,
+								beta_re,
+								simCoeffs->earth_radius,
+								simCoeffs->coriolis_omega,
+								simCoeffs->h0*simCoeffs->gravitation,
+								i_timestep_size,
+								use_coriolis_rexi_formulation
 						);
+
+						rexiSPH.solve(
+								thread_prog_phi0, thread_prog_u0, thread_prog_v0,
+								tmp_prog_phi, tmp_prog_u, tmp_prog_v
+							);
+					}
 				}
-			}
 
 
-			perThreadVars[thread_id]->accum_phi += tmp_prog_phi;
-			perThreadVars[thread_id]->accum_u += tmp_prog_u;
-			perThreadVars[thread_id]->accum_v += tmp_prog_v;
+				chunk->accum_phi += tmp_prog_phi;
+				chunk->accum_u += tmp_prog_u;
+				chunk->accum_v += tmp_prog_v;
+			}
+
+			stopwatch_chunk.stop();
+			poleScheduler.addWorkTime(thread_id, stopwatch_chunk());
 		}
 
 #if SWEET_DEBUG
@@ -561,74 +578,34 @@ bool SWE_Sphere_REXI::run_timestep_rexi(
 		stopwatch_reduce.start();
 #endif
 
-#if SWEET_REXI_THREAD_PARALLEL_SUM
-
-	io_prog_h0.physical_set_zero();
-	io_prog_u0.physical_set_zero();
-	io_prog_v0.physical_set_zero();
-
-	for (int thread_id = 0; thread_id < num_local_rexi_par_threads; thread_id++)
+	/*
+	 * The REXI sum is linear, hence we can reduce the per-chunk
+	 * accumulators in spectral space and only have to do a single
+	 * mode truncation and a single inverse transformation per field.
+	 *
+	 * The accumulators are converted to spectral space before
+	 * the reduction since this is not possible in parallel regions.
+	 */
+	for (std::size_t c = 0; c < perChunkVars.size(); c++)
 	{
-		if (rexi_use_extended_modes == 0)
-		{
-			assert(io_prog_h0.sphereDataConfig->spectral_array_data_number_of_elements == perThreadVars[0]->accum_phi.sphereDataConfig->spectral_array_data_number_of_elements);
-
-
-			perThreadVars[thread_id]->accum_phi.request_data_physical();
-
-			#pragma omp parallel for schedule(static) default(none) shared(io_prog_h0, thread_id)
-			for (int i = 0; i < io_prog_h0.sphereDataConfig->physical_array_data_number_of_elements; i++)
-				io_prog_h0.physical_space_data[i] += perThreadVars[thread_id]->accum_phi.physical_space_data[i];
-
-
-			perThreadVars[thread_id]->accum_u.request_data_physical();
-
-			#pragma omp parallel for schedule(static) default(none) shared(io_prog_u0, thread_id)
-			for (int i = 0; i < io_prog_u0.sphereDataConfig->physical_array_data_number_of_elements; i++)
-				io_prog_u0.physical_space_data[i] += perThreadVars[thread_id]->accum_u.physical_space_data[i];
-
-
-			perThreadVars[thread_id]->accum_v.request_data_physical();
-
-			#pragma omp parallel for schedule(static) default(none) shared(io_prog_v0, thread_id)
-			for (int i = 0; i < io_prog_v0.sphereDataConfig->physical_array_data_number_of_elements; i++)
-				io_prog_v0.physical_space_data[i] += perThreadVars[thread_id]->accum_v.physical_space_data[i];
-		}
-		else
-		{
-			assert(io_prog_h0.sphereDataConfig->spectral_array_data_number_of_elements == sphereDataConfig->spectral_array_data_number_of_elements);
-
-			SphereData tmp(sphereDataConfig);
-
-			tmp = perThreadVars[thread_id]->accum_phi.spectral_returnWithDifferentModes(tmp.sphereDataConfig);
-			tmp.request_data_physical();
-			#pragma omp parallel for schedule(static) default(none) shared(io_prog_h0, tmp)
-			for (int i = 0; i < io_prog_h0.sphereDataConfig->physical_array_data_number_of_elements; i++)
-				io_prog_h0.physical_space_data[i] += tmp.physical_space_data[i]*(1.0/simCoeffs->gravitation);
-
-
-			tmp = perThreadVars[thread_id]->accum_u.spectral_returnWithDifferentModes(tmp.sphereDataConfig);
-			tmp.request_data_physical();
-			#pragma omp parallel for schedule(static) default(none) shared(io_prog_u0, tmp)
-			for (int i = 0; i < io_prog_u0.sphereDataConfig->physical_array_data_number_of_elements; i++)
-				io_prog_u0.physical_space_data[i] += tmp.physical_space_data[i];
-
-
-			tmp = perThreadVars[thread_id]->accum_v.spectral_returnWithDifferentModes(tmp.sphereDataConfig);
-			tmp.request_data_physical();
-			#pragma omp parallel for schedule(static) default(none) shared(io_prog_v0, tmp)
-			for (int i = 0; i < io_prog_v0.sphereDataConfig->physical_array_data_number_of_elements; i++)
-				io_prog_v0.physical_space_data[i] += tmp.physical_space_data[i];
-		}
+		perChunkVars[c]->accum_phi.request_data_spectral();
+		perChunkVars[c]->accum_u.request_data_spectral();
+		perChunkVars[c]->accum_v.request_data_spectral();
 	}
 
-#else
-
-	io_prog_h0 = (perThreadVars[0]->accum_phi*(1.0/simCoeffs->gravitation)).spectral_returnWithDifferentModes(io_prog_h0.sphereDataConfig);
-	io_prog_u0 = perThreadVars[0]->accum_u.spectral_returnWithDifferentModes(io_prog_u0.sphereDataConfig);
-	io_prog_v0 = perThreadVars[0]->accum_v.spectral_returnWithDifferentModes(io_prog_v0.sphereDataConfig);
+	REXIPoleScheduler::treeReduction(
+			perChunkVars.size(),
+			[&](int i_dst, int i_src)
+			{
+				perChunkVars[i_dst]->accum_phi += perChunkVars[i_src]->accum_phi;
+				perChunkVars[i_dst]->accum_u += perChunkVars[i_src]->accum_u;
+				perChunkVars[i_dst]->accum_v += perChunkVars[i_src]->accum_v;
+			}
+		);
 
-#endif
+	io_prog_h0 = (perChunkVars[0]->accum_phi*(1.0/simCoeffs->gravitation)).spectral_returnWithDifferentModes(io_prog_h0.sphereDataConfig);
+	io_prog_u0 = perChunkVars[0]->accum_u.spectral_returnWithDifferentModes(io_prog_u0.sphereDataConfig);
+	io_prog_v0 = perChunkVars[0]->accum_v.spectral_returnWithDifferentModes(io_prog_v0.sphereDataConfig);
 
 	io_prog_h0.request_data_physical();
 	io_prog_u0.request_data_physical();
@@ -639,6 +616,7 @@ bool SWE_Sphere_REXI::run_timestep_rexi(
 	std::size_t physical_data_num_doubles = io_prog_h0.sphereDataConfig->physical_array_data_number_of_elements;
 
 	SphereData tmp(sphereDataConfig);
+	tmp.physical_alloc_buffer();
 
 	int retval = MPI_Reduce(io_prog_h0.physical_space_data, tmp.physical_space_data, physical_data_num_doubles, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
 	if (retval != MPI_SUCCESS)
@@ -662,21 +640,23 @@ bool SWE_Sphere_REXI::run_timestep_rexi(
 		stopwatch_reduce.stop();
 #endif
 
+	// redistribute poles across ranks based on the measured costs
+	poleScheduler.rebalance();
+
 	return true;
 }
 
 
 
-void SWE_Sphere_REXI:: MPI_quitWorkers(
-		SphereDataConfig *i_sphereDataConfig
-)
+/**
+ * Send a NaN time step size to stop the workers, see run_timestep_rexi()
+ */
+void SWE_Sphere_REXI:: MPI_quitWorkers()
 {
 #if SWEET_MPI
 
-	SphereData dummyData(i_sphereDataConfig);
-	dummyData.spectral_set_value(NAN);
-
-	MPI_Bcast(dummyData.spectral_space_data, dummyData.sphereDataConfig->spectral_array_data_number_of_elements*2, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	double timestep_size = NAN;
+	MPI_Bcast(&timestep_size, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
 #endif
 }
@@ -15,10 +15,13 @@
 
 
 #include <complex>
+#include <list>
 #include <rexi/REXI.hpp>
+#include <rexi/REXIPoleScheduler.hpp>
 #include <sweet/SimulationVariables.hpp>
 #include <string.h>
 #include <sweet/sphere/SphereDataConfig.hpp>
+#include <sweet/sphere/SphereDataConfigRegistry.hpp>
 #include <sweet/sphere/SphereData.hpp>
 #include <sweet/sphere/SphereDataComplex.hpp>
 #include <sweet/sphere/SphereOperators.hpp>
@@ -41,6 +44,11 @@ class SWE_Sphere_REXI
 	bool normalization;
 
 	SphereDataConfig *sphereDataConfig;
+
+	/*
+	 * Config used for REXI terms.
+	 * This is shared via the SphereDataConfigRegistry
+	 */
 	SphereDataConfig *sphereDataConfigRexi;
 
 	/*
@@ -57,11 +65,6 @@ class SWE_Sphere_REXI
 	int rexi_use_extended_modes;
 
 
-	/*
-	 * This class is only used in case of added modes
-	 */
-	SphereDataConfig sphereConfigRexiAddedModes;
-
 
 	/*
 	 * Time step size of REXI
@@ -73,7 +76,36 @@ class SWE_Sphere_REXI
 	bool use_rexi_preallocation;
 
 
-	std::size_t block_size;
+	// scheduler to distribute the poles across threads and ranks
+	REXIPoleScheduler poleScheduler;
+
+	/*
+	 * Preallocated solvers for all poles for a particular time step size
+	 */
+	class PreallocatedSolvers
+	{
+	public:
+		double timestep_size;
+
+		// preallocated solvers for each pole
+		std::vector<SWERexiTerm_SPHRobert> rexiSPHRobert_vector;
+		std::vector<SWERexiTerm_SPH> rexiSPH_vector;
+
+		// flags for preallocated solvers which are already set up
+		std::vector<char> rexi_pole_is_setup;
+	};
+
+	/*
+	 * LRU cache of preallocated solvers for different time step sizes,
+	 * the most recently used ones are at the front
+	 */
+	std::list<PreallocatedSolvers> solverCache;
+
+	// maximum number of time step sizes in the solver cache
+	int solver_cache_size;
+
+	// solvers for the current time step size
+	PreallocatedSolvers *currentSolvers;
 
 #if SWEET_BENCHMARK_REXI
 	Stopwatch stopwatch_preprocessing;
@@ -82,22 +114,16 @@ class SWE_Sphere_REXI
 	Stopwatch stopwatch_solve_rexi_terms;
 #endif
 
-	class PerThreadVars
+	class PerChunkVars
 	{
 	public:
-		std::vector<SWERexiTerm_SPHRobert> rexiSPHRobert_vector;
-		std::vector<SWERexiTerm_SPH> rexiSPH_vector;
-
-		std::vector< std::complex<double> > alpha;
-		std::vector< std::complex<double> > beta_re;
-
 		SphereData accum_phi;
 		SphereData accum_u;
 		SphereData accum_v;
 	};
 
-	// per-thread allocated variables to avoid NUMA domain effects
-	std::vector<PerThreadVars*> perThreadVars;
+	// accumulators for each chunk of poles, see REXIPoleScheduler
+	std::vector<PerChunkVars*> perChunkVars;
 
 	// number of threads to be used
 	int num_local_rexi_par_threads;
@@ -119,6 +145,10 @@ public:
 private:
 	void cleanup();
 
+	PreallocatedSolvers* p_getPreallocatedSolvers(
+			double i_timestep_size
+	);
+
 public:
 	SWE_Sphere_REXI();
 
@@ -140,15 +170,26 @@ public:
 			bool i_use_robert_functions,	///< use Robert functions
 			int i_rexi_use_extended_modes,
 			int i_rexi_normalization,
-			bool i_use_coriolis_rexi_formulation
+			bool i_use_coriolis_rexi_formulation,
+			int i_solver_cache_size = 0,	///< number of time step sizes for which the solvers are kept (0: no preallocation)
+			bool i_rebalance_ranks = false	///< rebalance poles across ranks (not bitwise reproducible)
 	);
 
 
 
-	void get_workload_start_end(
-			std::size_t &o_start,
-			std::size_t &o_end
-	);
+	/**
+	 * Return the time step size of a cached solver if it only differs
+	 * by round-off from the given one, otherwise the given one.
+	 *
+	 * Time step sizes which are shortened to hit the next output time
+	 * typically differ by round-off errors, hence each output would
+	 * otherwise lead to a new entry in the solver cache.
+	 */
+public:
+	double snapTimestepSizeToCache(
+		double i_timestep_size,
+		double i_rel_tolerance = 1e-10
+	)	const;
 
 
 
@@ -174,9 +215,7 @@ public:
 
 public:
 	static
-	void MPI_quitWorkers(
-			SphereDataConfig *i_sphereDataConfig
-	);
+	void MPI_quitWorkers();
 
 	~SWE_Sphere_REXI();
 };
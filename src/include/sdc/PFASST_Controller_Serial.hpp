@@ -0,0 +1,415 @@
+/*
+ * PFASST_Controller_Serial.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SDC_PFASST_CONTROLLER_SERIAL_HPP_
+#define SRC_INCLUDE_SDC_PFASST_CONTROLLER_SERIAL_HPP_
+
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <sdc/SDC_Nodes.hpp>
+#include <sdc/SDC_Problem.hpp>
+#include <sdc/SDC_Sweeper.hpp>
+#include <sweet/FatalError.hpp>
+
+
+
+/**
+ * Serial emulation of the parallel full approximation scheme in space and time (PFASST)
+ *
+ * The time interval handed over to run() is split into a number of time slices.
+ * Each time slice is solved with multi-level SDC where the levels are coupled
+ * with the full approximation scheme (FAS). The coarsest level is propagated
+ * sequentially across the time slices, similar to the coarse propagator of Parareal.
+ *
+ * All levels use the same collocation nodes, coarsening is only done in space
+ * via the transfer operators.
+ *
+ * Level 0 is the finest level.
+ *
+ * As for Parareal, the iterations are stopped if the maximum change of the
+ * solution at the end of the time slices is below the convergence threshold.
+ *
+ * \param t_State	data container of the solution, see SDC_Problem
+ */
+template <class t_State>
+class PFASST_Controller_Serial
+{
+	typedef SDC_Sweeper<t_State> Sweeper;
+
+	int num_levels;
+	int num_slices;
+
+	/// problems and transfer operators for each level
+	std::vector<SDC_Problem<t_State>*> problems;
+	std::vector<SDC_Transfer<t_State>*> transfers;
+
+	const SDC_Nodes *nodes;
+
+	/// number of sweeps on each level
+	std::vector<int> num_sweeps;
+
+	/// maximum number of iterations
+	int max_iterations;
+
+	/// threshold for convergence, disabled if negative
+	double convergence_threshold;
+
+	int verbosity;
+
+	/// sweepers, index [slice*num_levels + level]
+	std::vector<Sweeper*> sweepers;
+
+	/// restricted values at nodes, required to compute coarse level corrections
+	std::vector<std::vector<t_State>> restricted;
+
+	/// workspace for integrals on each level
+	std::vector<std::vector<t_State>> integrals;
+
+	/// temporary data on each level
+	std::vector<t_State> tmp;
+
+	/// end values of previous iteration on the finest level
+	std::vector<t_State> prev_end;
+
+
+public:
+	/// number of iterations of last run
+	int last_num_iterations;
+
+	/// convergence value of last run
+	double last_convergence;
+
+
+public:
+	PFASST_Controller_Serial()	:
+		num_levels(0),
+		num_slices(0),
+		nodes(nullptr),
+		max_iterations(0),
+		convergence_threshold(-1),
+		verbosity(0),
+		last_num_iterations(0),
+		last_convergence(-1)
+	{
+	}
+
+
+	~PFASST_Controller_Serial()
+	{
+		cleanup();
+	}
+
+
+	void cleanup()
+	{
+		for (auto s : sweepers)
+			delete s;
+
+		sweepers.clear();
+		restricted.clear();
+		integrals.clear();
+		tmp.clear();
+		prev_end.clear();
+	}
+
+
+	inline
+	Sweeper& getSweeper(
+			int i_slice,
+			int i_level
+	)
+	{
+		return *sweepers[i_slice*num_levels + i_level];
+	}
+
+
+
+	void setup(
+			const std::vector<SDC_Problem<t_State>*> &i_problems,		///< problem for each level
+			const std::vector<SDC_Transfer<t_State>*> &i_transfers,		///< transfer between level l and l+1
+			const std::vector<const t_State*> &i_states,				///< state for each level, used to allocate data
+			const SDC_Nodes *i_nodes,									///< collocation nodes
+			const std::vector<int> &i_num_sweeps,						///< number of sweeps on each level
+			int i_num_slices,											///< number of time slices
+			int i_max_iterations,										///< maximum number of PFASST iterations
+			double i_convergence_threshold = -1,						///< stop iterating if end values change less
+			int i_verbosity = 0
+	)
+	{
+		cleanup();
+
+		num_levels = i_problems.size();
+		num_slices = i_num_slices;
+
+		if (num_levels < 1)
+			FatalError("PFASST: At least one level required");
+
+		if ((int)i_transfers.size() != num_levels-1 || (int)i_states.size() != num_levels || (int)i_num_sweeps.size() != num_levels)
+			FatalError("PFASST: Inconsistent number of levels");
+
+		if (num_slices < 1)
+			FatalError("PFASST: At least one time slice required");
+
+		problems = i_problems;
+		transfers = i_transfers;
+		nodes = i_nodes;
+		num_sweeps = i_num_sweeps;
+		max_iterations = i_max_iterations;
+		convergence_threshold = i_convergence_threshold;
+		verbosity = i_verbosity;
+
+		int M = nodes->num_nodes;
+
+		sweepers.resize(num_slices*num_levels);
+		for (int p = 0; p < num_slices; p++)
+		{
+			for (int l = 0; l < num_levels; l++)
+			{
+				Sweeper *s = new Sweeper(*i_states[l]);
+				s->setup(problems[l], nodes);
+				sweepers[p*num_levels + l] = s;
+			}
+		}
+
+		for (int l = 0; l < num_levels; l++)
+		{
+			restricted.push_back(std::vector<t_State>(M, *i_states[l]));
+			integrals.push_back(std::vector<t_State>(M, *i_states[l]));
+			tmp.push_back(*i_states[l]);
+		}
+
+		prev_end.assign(num_slices, *i_states[0]);
+	}
+
+
+
+private:
+	/**
+	 * Restrict the nodes of level l to level l+1 and compute the FAS correction
+	 */
+	void p_restrict(
+			int p,
+			int l
+	)
+	{
+		Sweeper &f = getSweeper(p, l);
+		Sweeper &c = getSweeper(p, l+1);
+
+		int M = nodes->num_nodes;
+
+		for (int m = 0; m < M; m++)
+		{
+			transfers[l]->restrict(f.u[m], c.u[m]);
+			restricted[l+1][m] = c.u[m];
+		}
+		c.evaluate_nodes();
+
+		/*
+		 * FAS correction:
+		 * tau_c = R(I_f + tau_f) - I_c(R(u_f))
+		 */
+		f.integrate(integrals[l]);
+		c.integrate(integrals[l+1]);
+
+		for (int m = 0; m < M; m++)
+		{
+			if (f.use_tau)
+				problems[l]->axpy(1.0, f.tau[m], integrals[l][m]);
+
+			transfers[l]->restrict(integrals[l][m], c.tau[m]);
+			problems[l+1]->axpy(-1.0, integrals[l+1][m], c.tau[m]);
+		}
+		c.use_tau = true;
+	}
+
+
+	/**
+	 * Interpolate the coarse correction of level l+1 to level l
+	 */
+	void p_interpolate(
+			int p,
+			int l
+	)
+	{
+		Sweeper &f = getSweeper(p, l);
+		Sweeper &c = getSweeper(p, l+1);
+
+		for (int m = 0; m < nodes->num_nodes; m++)
+		{
+			tmp[l+1] = c.u[m];
+			problems[l+1]->axpy(-1.0, restricted[l+1][m], tmp[l+1]);
+
+			transfers[l]->interpolate(tmp[l+1], tmp[l]);
+			problems[l]->axpy(1.0, tmp[l], f.u[m]);
+		}
+		f.evaluate_nodes();
+	}
+
+
+
+	/**
+	 * Predictor: Sequential propagation on the coarsest level,
+	 * followed by interpolation to the finer levels
+	 */
+	void p_predictor(
+			const t_State &i_u
+	)
+	{
+		int L = num_levels;
+
+		for (int p = 0; p < num_slices; p++)
+		{
+			Sweeper &c = getSweeper(p, L-1);
+
+			if (p == 0)
+			{
+				tmp[0] = i_u;
+				for (int l = 0; l < L-1; l++)
+					transfers[l]->restrict(tmp[l], tmp[l+1]);
+
+				c.u0 = tmp[L-1];
+			}
+			else
+			{
+				c.u0 = getSweeper(p-1, L-1).get_end();
+			}
+
+			c.use_tau = false;
+			c.spread();
+
+			for (int k = 0; k < num_sweeps[L-1]; k++)
+				c.sweep();
+		}
+
+		for (int l = L-2; l >= 0; l--)
+		{
+			for (int p = 0; p < num_slices; p++)
+			{
+				Sweeper &f = getSweeper(p, l);
+				Sweeper &c = getSweeper(p, l+1);
+
+				if (p == 0 && l == 0)
+					f.u0 = i_u;
+				else
+					transfers[l]->interpolate(c.u0, f.u0);
+
+				f.use_tau = false;
+				f.spread();
+
+				for (int m = 0; m < nodes->num_nodes; m++)
+					transfers[l]->interpolate(c.u[m], f.u[m]);
+
+				f.evaluate_nodes();
+			}
+		}
+	}
+
+
+
+public:
+	/**
+	 * Run PFASST on the time interval [i_t_start, i_t_start + num_slices*i_slice_size]
+	 *
+	 * \return number of iterations
+	 */
+	int run(
+			t_State &io_u,			///< initial value, overwritten with solution at end of time interval
+			double i_t_start,		///< start of time interval
+			double i_slice_size		///< size of each time slice
+	)
+	{
+		int L = num_levels;
+
+		for (int p = 0; p < num_slices; p++)
+			for (int l = 0; l < L; l++)
+				getSweeper(p, l).set_timeframe(i_t_start + i_slice_size*p, i_slice_size);
+
+		p_predictor(io_u);
+
+		last_convergence = -1;
+
+		int k = 0;
+		for (; k < max_iterations; k++)
+		{
+			for (int p = 0; p < num_slices; p++)
+				prev_end[p] = getSweeper(p, 0).get_end();
+
+			for (int p = 0; p < num_slices; p++)
+			{
+				/*
+				 * Initial values from previous time slice
+				 */
+				if (p > 0)
+				{
+					for (int l = 0; l < L; l++)
+						getSweeper(p, l).u0 = getSweeper(p-1, l).get_end();
+				}
+
+				/*
+				 * Sweep and restrict down to the coarsest level
+				 */
+				for (int l = 0; l < L-1; l++)
+				{
+					Sweeper &s = getSweeper(p, l);
+					for (int i = 0; i < num_sweeps[l]; i++)
+						s.sweep();
+
+					p_restrict(p, l);
+				}
+
+				Sweeper &c = getSweeper(p, L-1);
+				for (int i = 0; i < num_sweeps[L-1]; i++)
+					c.sweep();
+
+				/*
+				 * Interpolate corrections up to the finest level
+				 */
+				for (int l = L-2; l >= 0; l--)
+				{
+					p_interpolate(p, l);
+
+					if (l > 0)
+					{
+						Sweeper &s = getSweeper(p, l);
+						for (int i = 0; i < num_sweeps[l]; i++)
+							s.sweep();
+					}
+				}
+			}
+
+			/*
+			 * Convergence check
+			 */
+			double max_convergence = 0;
+			for (int p = 0; p < num_slices; p++)
+			{
+				problems[0]->axpy(-1.0, getSweeper(p, 0).get_end(), prev_end[p]);
+				max_convergence = std::max(max_convergence, problems[0]->norm(prev_end[p]));
+			}
+			last_convergence = max_convergence;
+
+			if (verbosity > 1)
+				std::cout << "PFASST iteration " << k << ", convergence: " << max_convergence << std::endl;
+
+			if (convergence_threshold >= 0 && max_convergence < convergence_threshold)
+			{
+				k++;
+				break;
+			}
+		}
+
+		last_num_iterations = k;
+
+		io_u = getSweeper(num_slices-1, 0).get_end();
+		return k;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SDC_PFASST_CONTROLLER_SERIAL_HPP_ */
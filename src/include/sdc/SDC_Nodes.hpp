@@ -0,0 +1,301 @@
+/*
+ * SDC_Nodes.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SDC_SDC_NODES_HPP_
+#define SRC_INCLUDE_SDC_SDC_NODES_HPP_
+
+#include <vector>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <libmath/GaussQuadrature.hpp>
+#include <sweet/FatalError.hpp>
+
+
+
+/**
+ * Collocation nodes and integration matrices for
+ * spectral deferred corrections (SDC)
+ *
+ * The nodes tau_0, ..., tau_{M-1} are given on the unit interval [0,1].
+ * Both supported node types include the right boundary tau_{M-1} = 1,
+ * hence the value at the last node is the solution at the end of the time step.
+ *
+ *  - Gauss-Lobatto: also includes the left boundary tau_0 = 0
+ *  - Gauss-Radau (right): does not include the left boundary
+ *
+ * The node-to-node integration matrix S is given by
+ *
+ *   S[m][j] = \int_{tau_{m-1}}^{tau_m} l_j(s) ds
+ *
+ * with l_j the Lagrange polynomials for the nodes and tau_{-1} = 0.
+ */
+class SDC_Nodes
+{
+public:
+	enum NodeType
+	{
+		GAUSS_LOBATTO = 0,
+		GAUSS_RADAU_RIGHT = 1
+	};
+
+	NodeType node_type;
+
+	/// number of nodes
+	int num_nodes;
+
+	/// nodes on unit interval
+	std::vector<double> nodes;
+
+	/// distance to previous node (or 0 for the first node)
+	std::vector<double> delta;
+
+	/// node-to-node integration matrix, stored row-wise
+	std::vector<double> S;
+
+
+public:
+	SDC_Nodes()	:
+		node_type(GAUSS_LOBATTO),
+		num_nodes(0)
+	{
+	}
+
+
+	SDC_Nodes(
+			int i_num_nodes,
+			NodeType i_node_type
+	)
+	{
+		setup(i_num_nodes, i_node_type);
+	}
+
+
+
+private:
+	/**
+	 * Evaluate Legendre polynomial P_n and its derivative at x
+	 */
+	static
+	void p_legendre(
+			int n,
+			double x,
+			double &o_p,
+			double &o_dp
+	)
+	{
+		double p0 = 1, p1 = x;
+		double dp0 = 0, dp1 = 1;
+
+		if (n == 0)
+		{
+			o_p = p0;
+			o_dp = dp0;
+			return;
+		}
+
+		for (int k = 1; k < n; k++)
+		{
+			double p2 = ((2*k+1)*x*p1 - k*p0)/(double)(k+1);
+			double dp2 = dp0 + (2*k+1)*p1;
+
+			p0 = p1;	p1 = p2;
+			dp0 = dp1;	dp1 = dp2;
+		}
+
+		o_p = p1;
+		o_dp = dp1;
+	}
+
+
+	/**
+	 * Find all roots of i_fun in the open interval (-1,1)
+	 * by scanning for sign changes followed by bisection
+	 */
+	static
+	void p_findInteriorRoots(
+			std::function<double(double)> i_fun,
+			std::vector<double> &o_roots
+	)
+	{
+		int num_samples = 4096;
+
+		double eps = 1e-12;
+		double x0 = -1.0+eps;
+		double f0 = i_fun(x0);
+
+		for (int i = 1; i <= num_samples; i++)
+		{
+			double x1 = -1.0 + 2.0*(double)i/(double)num_samples;
+			if (i == num_samples)
+				x1 = 1.0-eps;
+
+			double f1 = i_fun(x1);
+
+			if (f0 == 0)
+			{
+				o_roots.push_back(x0);
+			}
+			else if (f0*f1 < 0)
+			{
+				double a = x0, b = x1, fa = f0;
+				for (int k = 0; k < 200 && b-a > 1e-16; k++)
+				{
+					double c = 0.5*(a+b);
+					double fc = i_fun(c);
+
+					if (fa*fc <= 0)
+					{
+						b = c;
+					}
+					else
+					{
+						a = c;
+						fa = fc;
+					}
+				}
+				o_roots.push_back(0.5*(a+b));
+			}
+
+			x0 = x1;
+			f0 = f1;
+		}
+	}
+
+
+
+public:
+	void setup(
+			int i_num_nodes,
+			NodeType i_node_type
+	)
+	{
+		node_type = i_node_type;
+		num_nodes = i_num_nodes;
+
+		/*
+		 * The integration of the Lagrange polynomials of degree M-1
+		 * with the 5-point Gauss quadrature is exact up to degree 9
+		 */
+		if (num_nodes < 1 || num_nodes > 10)
+			FatalError("SDC: Only 1 to 10 nodes supported");
+
+		if (node_type == GAUSS_LOBATTO && num_nodes < 2)
+			FatalError("SDC: At least 2 Gauss-Lobatto nodes required");
+
+		std::vector<double> x;
+
+		if (node_type == GAUSS_LOBATTO)
+		{
+			/*
+			 * Endpoints and roots of P'_{M-1}
+			 */
+			x.push_back(-1.0);
+			p_findInteriorRoots(
+					[&](double i_x) -> double
+					{
+						double p, dp;
+						p_legendre(num_nodes-1, i_x, p, dp);
+						return dp;
+					},
+					x
+				);
+			x.push_back(1.0);
+		}
+		else if (node_type == GAUSS_RADAU_RIGHT)
+		{
+			/*
+			 * Roots of P_{M-1} - P_M, including x=1
+			 */
+			p_findInteriorRoots(
+					[&](double i_x) -> double
+					{
+						double pa, pb, dp;
+						p_legendre(num_nodes-1, i_x, pa, dp);
+						p_legendre(num_nodes, i_x, pb, dp);
+						return pa - pb;
+					},
+					x
+				);
+			x.push_back(1.0);
+		}
+		else
+		{
+			FatalError("SDC: Unknown node type");
+		}
+
+		if ((int)x.size() != num_nodes)
+			FatalError("SDC: Failed to compute collocation nodes");
+
+		nodes.resize(num_nodes);
+		delta.resize(num_nodes);
+		for (int m = 0; m < num_nodes; m++)
+		{
+			nodes[m] = 0.5*(x[m]+1.0);
+			delta[m] = nodes[m] - (m == 0 ? 0.0 : nodes[m-1]);
+		}
+
+		/*
+		 * Node-to-node integrals of Lagrange polynomials
+		 */
+		S.resize(num_nodes*num_nodes);
+		for (int j = 0; j < num_nodes; j++)
+		{
+			std::function<double(double)> lagrange =
+					[&](double t) -> double
+					{
+						double l = 1;
+						for (int i = 0; i < num_nodes; i++)
+							if (i != j)
+								l *= (t - nodes[i])/(nodes[j] - nodes[i]);
+						return l;
+					};
+
+			for (int m = 0; m < num_nodes; m++)
+			{
+				double start = (m == 0 ? 0.0 : nodes[m-1]);
+
+				if (delta[m] == 0)
+					S[m*num_nodes+j] = 0;
+				else
+					S[m*num_nodes+j] = GaussQuadrature::integrate5<double>(start, nodes[m], lagrange);
+			}
+		}
+	}
+
+
+
+	/**
+	 * Return the node-to-node integration weight S[m][j]
+	 */
+	inline
+	double getS(
+			int m,
+			int j
+	)	const
+	{
+		return S[m*num_nodes+j];
+	}
+
+
+
+	void print()	const
+	{
+		std::cout << "SDC nodes (" << (node_type == GAUSS_LOBATTO ? "Gauss-Lobatto" : "Gauss-Radau") << "):" << std::endl;
+		for (int m = 0; m < num_nodes; m++)
+		{
+			std::cout << "  " << nodes[m] << ":";
+			for (int j = 0; j < num_nodes; j++)
+				std::cout << "\t" << getS(m, j);
+			std::cout << std::endl;
+		}
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SDC_SDC_NODES_HPP_ */
@@ -0,0 +1,139 @@
+/*
+ * SDC_Problem.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SDC_SDC_PROBLEM_HPP_
+#define SRC_INCLUDE_SDC_SDC_PROBLEM_HPP_
+
+
+
+/**
+ * Interface descriptions which are required
+ * to solve an IMEX split problem
+ *
+ *   u_t = f_E(u) + f_I(u)
+ *
+ * with spectral deferred corrections on one level.
+ *
+ * The state class t_State has to be copy constructible and assignable.
+ * All other operations on the state are provided by this interface.
+ */
+template <class t_State>
+class SDC_Problem
+{
+public:
+	/**
+	 * Evaluate the explicitly treated part:
+	 * o_f := f_E(i_u)
+	 */
+	virtual
+	void eval_explicit(
+			const t_State &i_u,
+			double i_time,
+			t_State &o_f
+	) = 0;
+
+
+	/**
+	 * Evaluate the implicitly treated part:
+	 * o_f := f_I(i_u)
+	 */
+	virtual
+	void eval_implicit(
+			const t_State &i_u,
+			double i_time,
+			t_State &o_f
+	) = 0;
+
+
+	/**
+	 * Solve the implicit system
+	 *
+	 *   o_u - i_dt * f_I(o_u) = i_rhs
+	 *
+	 * and return f_I(o_u).
+	 */
+	virtual
+	void solve_implicit(
+			const t_State &i_rhs,
+			double i_dt,
+			double i_time,
+			t_State &o_u,
+			t_State &o_f
+	) = 0;
+
+
+	/**
+	 * o_u := 0
+	 */
+	virtual
+	void set_zero(
+			t_State &o_u
+	) = 0;
+
+
+	/**
+	 * io_y := io_y + i_a * i_x
+	 */
+	virtual
+	void axpy(
+			double i_a,
+			const t_State &i_x,
+			t_State &io_y
+	) = 0;
+
+
+	/**
+	 * Return the max norm of i_u
+	 */
+	virtual
+	double norm(
+			const t_State &i_u
+	) = 0;
+
+
+	virtual ~SDC_Problem()
+	{
+	}
+};
+
+
+
+/**
+ * Transfer operators between two levels of a multi-level SDC hierarchy
+ */
+template <class t_State>
+class SDC_Transfer
+{
+public:
+	/**
+	 * Restrict data from the fine to the coarse level
+	 */
+	virtual
+	void restrict(
+			const t_State &i_fine,
+			t_State &o_coarse
+	) = 0;
+
+
+	/**
+	 * Interpolate data from the coarse to the fine level
+	 */
+	virtual
+	void interpolate(
+			const t_State &i_coarse,
+			t_State &o_fine
+	) = 0;
+
+
+	virtual ~SDC_Transfer()
+	{
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SDC_SDC_PROBLEM_HPP_ */
@@ -0,0 +1,296 @@
+/*
+ * SDC_Sweeper.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SDC_SDC_SWEEPER_HPP_
+#define SRC_INCLUDE_SDC_SDC_SWEEPER_HPP_
+
+#include <vector>
+#include <cassert>
+#include <sdc/SDC_Nodes.hpp>
+#include <sdc/SDC_Problem.hpp>
+
+
+
+/**
+ * IMEX sweeper for spectral deferred corrections on one level
+ *
+ * Each sweep updates the solution at the collocation nodes
+ * with a forward/backward Euler substepping (see Minion, 2003):
+ *
+ *   u_m^{k+1} = u_{m-1}^{k+1}
+ *             + dt_m * (f_E(u_{m-1}^{k+1}) - f_E(u_{m-1}^k))
+ *             + dt_m * (f_I(u_m^{k+1}) - f_I(u_m^k))
+ *             + dt * sum_j S[m][j] (f_E(u_j^k) + f_I(u_j^k))
+ *             + tau_m
+ *
+ * with u_{-1} the initial value and tau_m the (optional) FAS correction
+ * which is used on coarser levels of multi-level SDC / PFASST.
+ *
+ * \param t_State	data container of the solution, see SDC_Problem
+ */
+template <class t_State>
+class SDC_Sweeper
+{
+public:
+	SDC_Problem<t_State> *problem;
+	const SDC_Nodes *nodes;
+
+	/// start and size of time step
+	double t0;
+	double dt;
+
+	/// initial value at t0
+	t_State u0;
+
+	/// values and function evaluations at collocation nodes
+	std::vector<t_State> u;
+	std::vector<t_State> f_E;
+	std::vector<t_State> f_I;
+
+	/// node-to-node FAS correction
+	std::vector<t_State> tau;
+	bool use_tau;
+
+private:
+	/// explicit evaluation at the initial value (current and previous sweep)
+	t_State f_E0;
+	t_State f_E0_prev;
+
+	/// node-to-node integrals
+	std::vector<t_State> integral;
+
+	/// right hand side for implicit solves
+	t_State rhs;
+
+
+public:
+	SDC_Sweeper(
+			const t_State &i_state		///< state which is used to allocate data on this level
+	)	:
+		problem(nullptr),
+		nodes(nullptr),
+		t0(0),
+		dt(0),
+		u0(i_state),
+		use_tau(false),
+		f_E0(i_state),
+		f_E0_prev(i_state),
+		rhs(i_state)
+	{
+	}
+
+
+
+	void setup(
+			SDC_Problem<t_State> *i_problem,
+			const SDC_Nodes *i_nodes
+	)
+	{
+		problem = i_problem;
+		nodes = i_nodes;
+
+		int M = nodes->num_nodes;
+
+		u.assign(M, u0);
+		f_E.assign(M, u0);
+		f_I.assign(M, u0);
+		tau.assign(M, u0);
+		integral.assign(M, u0);
+
+		use_tau = false;
+	}
+
+
+
+	void set_timeframe(
+			double i_t0,
+			double i_dt
+	)
+	{
+		t0 = i_t0;
+		dt = i_dt;
+	}
+
+
+
+	/**
+	 * Return time of node m
+	 */
+	inline
+	double node_time(int m)	const
+	{
+		return t0 + dt*nodes->nodes[m];
+	}
+
+
+
+	/**
+	 * Return solution at the end of the time step
+	 */
+	inline
+	const t_State& get_end()	const
+	{
+		return u[nodes->num_nodes-1];
+	}
+
+
+
+	/**
+	 * Initialize all nodes with the initial value
+	 */
+	void spread()
+	{
+		problem->eval_explicit(u0, t0, f_E0);
+		f_E0_prev = f_E0;
+
+		problem->eval_implicit(u0, t0, f_I[0]);
+
+		for (int m = 0; m < nodes->num_nodes; m++)
+		{
+			u[m] = u0;
+			f_E[m] = f_E0;
+
+			if (m > 0)
+				f_I[m] = f_I[0];
+		}
+	}
+
+
+
+	/**
+	 * Update function evaluations after the values at the nodes were modified
+	 */
+	void evaluate_nodes()
+	{
+		for (int m = 0; m < nodes->num_nodes; m++)
+		{
+			double t = node_time(m);
+			problem->eval_explicit(u[m], t, f_E[m]);
+			problem->eval_implicit(u[m], t, f_I[m]);
+		}
+	}
+
+
+
+	/**
+	 * Compute node-to-node integrals
+	 *
+	 *   o_integral[m] = dt * sum_j S[m][j] (f_E(u_j) + f_I(u_j))
+	 */
+	void integrate(
+			std::vector<t_State> &o_integral
+	)
+	{
+		int M = nodes->num_nodes;
+
+		for (int m = 0; m < M; m++)
+		{
+			problem->set_zero(o_integral[m]);
+
+			if (nodes->delta[m] == 0)
+				continue;
+
+			for (int j = 0; j < M; j++)
+			{
+				double s = dt*nodes->getS(m, j);
+				problem->axpy(s, f_E[j], o_integral[m]);
+				problem->axpy(s, f_I[j], o_integral[m]);
+			}
+		}
+	}
+
+
+
+	/**
+	 * Run a single IMEX SDC sweep
+	 */
+	void sweep()
+	{
+		int M = nodes->num_nodes;
+
+		// the initial value might have been changed since the last sweep
+		problem->eval_explicit(u0, t0, f_E0);
+
+		/*
+		 * Contributions of the previous iteration
+		 */
+		integrate(integral);
+
+		for (int m = 0; m < M; m++)
+		{
+			double dt_m = dt*nodes->delta[m];
+
+			if (dt_m != 0)
+			{
+				problem->axpy(-dt_m, f_I[m], integral[m]);
+				problem->axpy(-dt_m, (m == 0 ? f_E0_prev : f_E[m-1]), integral[m]);
+			}
+
+			if (use_tau)
+				problem->axpy(1.0, tau[m], integral[m]);
+		}
+
+		/*
+		 * Substepping through the nodes
+		 */
+		for (int m = 0; m < M; m++)
+		{
+			double dt_m = dt*nodes->delta[m];
+			double t = node_time(m);
+
+			rhs = (m == 0 ? u0 : u[m-1]);
+
+			if (dt_m != 0)
+				problem->axpy(dt_m, (m == 0 ? f_E0 : f_E[m-1]), rhs);
+
+			problem->axpy(1.0, integral[m], rhs);
+
+			if (dt_m == 0)
+			{
+				u[m] = rhs;
+				problem->eval_implicit(u[m], t, f_I[m]);
+			}
+			else
+			{
+				problem->solve_implicit(rhs, dt_m, t, u[m], f_I[m]);
+			}
+
+			problem->eval_explicit(u[m], t, f_E[m]);
+		}
+
+		f_E0_prev = f_E0;
+	}
+
+
+
+	/**
+	 * Run a full SDC time step with a fixed number of sweeps
+	 */
+	void run_timestep(
+			t_State &io_u,			///< initial value, overwritten with solution at end of time step
+			double i_t0,			///< start of time step
+			double i_dt,			///< time step size
+			int i_num_sweeps		///< number of sweeps
+	)
+	{
+		set_timeframe(i_t0, i_dt);
+
+		u0 = io_u;
+		use_tau = false;
+
+		spread();
+
+		for (int k = 0; k < i_num_sweeps; k++)
+			sweep();
+
+		io_u = get_end();
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SDC_SDC_SWEEPER_HPP_ */
@@ -0,0 +1,344 @@
+/*
+ * BatchJobRunner.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_BATCHJOBRUNNER_HPP_
+#define SRC_INCLUDE_SWEET_BATCHJOBRUNNER_HPP_
+
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/Stopwatch.hpp>
+#include <sweet/FatalError.hpp>
+#include <getopt.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <atomic>
+#include <algorithm>
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#	include <omp.h>
+#endif
+
+
+
+/**
+ * Run many simulations with different parameters in a single process.
+ *
+ * Each line of the job file contains the program arguments of one job, e.g.
+ *
+ * 	-M 64 -C -120 --rexi-m=256 -O job0_prog_%s_t%020.8f.csv
+ *
+ * Empty lines and lines starting with '#' are ignored.
+ * The arguments of each job are appended to the arguments of the program,
+ * hence the latter ones provide the default values for all jobs.
+ *
+ * Jobs are grouped by a program-specific key (e.g. resolution and
+ * transformation config). The group is set up once outside of
+ * parallel regions, then its jobs are executed
+ *  - one after another with all threads or
+ *  - concurrently by teams of threads (nested OpenMP parallelism).
+ *
+ * Everything which is cached process-wide (transformation plans
+ * in the config registries, REXI coefficients, initial conditions of benchmarks)
+ * is reused by all jobs.
+ */
+class BatchJobRunner
+{
+public:
+	class Job
+	{
+	public:
+		int id;							///< number of job in job file, starting with 0
+		std::string args;				///< arguments of job as given in job file
+		SimulationVariables simVars;	///< simulation variables of this job
+		double wallclock_seconds = 0;
+	};
+
+	std::vector<Job> jobs;
+
+private:
+	int num_teams = 1;
+	int threads_per_team = 1;
+
+
+	/**
+	 * Split a line of the job file into arguments.
+	 * Arguments can be quoted with ' or "
+	 */
+	static
+	void p_splitArguments(
+			const std::string &i_line,
+			std::vector<std::string> &o_args
+	)
+	{
+		o_args.clear();
+
+		std::string arg;
+		bool in_arg = false;
+		char quote = 0;
+
+		for (std::size_t i = 0; i < i_line.size(); i++)
+		{
+			char c = i_line[i];
+
+			if (quote != 0)
+			{
+				if (c == quote)
+					quote = 0;
+				else
+					arg += c;
+				continue;
+			}
+
+			if (c == '#' && !in_arg)
+				break;
+
+			if (c == '\'' || c == '"')
+			{
+				quote = c;
+				in_arg = true;
+				continue;
+			}
+
+			if (c == ' ' || c == '\t' || c == '\r')
+			{
+				if (in_arg)
+					o_args.push_back(arg);
+
+				arg = "";
+				in_arg = false;
+				continue;
+			}
+
+			arg += c;
+			in_arg = true;
+		}
+
+		if (in_arg)
+			o_args.push_back(arg);
+	}
+
+
+public:
+	/**
+	 * Load the jobs and parse their arguments
+	 *
+	 * \return false if the arguments of a job are invalid
+	 */
+	bool setup(
+			const std::string &i_job_file_name,
+			int i_num_teams,
+			const SimulationVariables &i_defaultSimVars,	///< simulation variables before parsing any program arguments
+			int i_argc,
+			char *const i_argv[],
+			const char *i_bogus_var_names[] = nullptr
+	)
+	{
+		jobs.clear();
+
+		// the allocator has to be set up outside of parallel regions
+		MemBlockAlloc::setup();
+
+		std::ifstream file(i_job_file_name);
+		if (!file)
+			FatalError("Unable to open batch job file '"+i_job_file_name+"'");
+
+		std::string line;
+		std::vector<std::string> args;
+
+		for (int line_nr = 1; std::getline(file, line); line_nr++)
+		{
+			p_splitArguments(line, args);
+
+			if (args.size() == 0)
+				continue;
+
+			std::vector<char*> argv(i_argv, i_argv+i_argc);
+			for (auto &a : args)
+				argv.push_back(&a[0]);
+			argv.push_back(nullptr);
+
+			jobs.emplace_back();
+			Job &job = jobs.back();
+
+			job.id = jobs.size()-1;
+			job.args = line;
+			job.simVars = i_defaultSimVars;
+
+			// restart parsing of arguments with getopt
+			optind = 1;
+
+			if (!job.simVars.setupFromMainParameters(argv.size()-1, argv.data(), i_bogus_var_names))
+			{
+				std::cerr << "Invalid arguments of batch job in line " << line_nr << ": " << line << std::endl;
+				return false;
+			}
+
+			if (	(job.simVars.disc.res_physical[0] == 0 || job.simVars.disc.res_physical[1] == 0)	&&
+					(job.simVars.disc.res_spectral[0] == 0 || job.simVars.disc.res_spectral[1] == 0)
+			)
+			{
+				std::cerr << "No resolution given for batch job in line " << line_nr << ": " << line << std::endl;
+				return false;
+			}
+		}
+
+		/*
+		 * Distribute threads to teams
+		 */
+		num_teams = std::max(1, std::min(i_num_teams, (int)jobs.size()));
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+		threads_per_team = std::max(1, omp_get_max_threads() / num_teams);
+#else
+		num_teams = 1;
+		threads_per_team = 1;
+#endif
+
+		std::cout << "Batch jobs: " << jobs.size() << std::endl;
+		std::cout << "Batch thread teams: " << num_teams << " with " << threads_per_team << " threads each" << std::endl;
+
+		return true;
+	}
+
+
+
+private:
+	template <typename T_JobFun>
+	void p_runJob(
+			Job &io_job,
+			T_JobFun &i_job_fun
+	)
+	{
+		Stopwatch watch;
+		watch.start();
+
+		i_job_fun(io_job);
+
+		watch.stop();
+		io_job.wallclock_seconds = watch();
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp critical (BatchJobRunner)
+#endif
+		std::cout << "BATCH JOB " << io_job.id << " FINISHED (" << io_job.wallclock_seconds << " seconds): " << io_job.args << std::endl;
+	}
+
+
+
+	template <typename T_JobFun>
+	void p_runGroup(
+			const std::vector<std::size_t> &i_group,
+			T_JobFun &i_job_fun
+	)
+	{
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+		if (num_teams > 1)
+		{
+			std::atomic<std::size_t> next_job(0);
+
+			int max_active_levels = omp_get_max_active_levels();
+			omp_set_max_active_levels(std::max(2, max_active_levels));
+
+#pragma omp parallel num_threads(num_teams) proc_bind(spread)
+			{
+				int team_id = omp_get_thread_num();
+
+				omp_set_num_threads(threads_per_team);
+
+				// see Parareal_Controller_Threaded
+#pragma omp parallel num_threads(threads_per_team) proc_bind(close)
+				MemBlockAlloc::setThreadLocalDomainId(team_id*threads_per_team + omp_get_thread_num());
+
+				// jobs are assigned dynamically since their runtime differs
+				for (std::size_t i = next_job++; i < i_group.size(); i = next_job++)
+					p_runJob(jobs[i_group[i]], i_job_fun);
+			}
+
+			omp_set_max_active_levels(max_active_levels);
+
+			// restore allocation domains for non-nested parallel regions
+			MemBlockAlloc::setThreadLocalDomainId(0);
+#pragma omp parallel
+			MemBlockAlloc::setThreadLocalDomainId(omp_get_thread_num());
+
+			return;
+		}
+#endif
+
+		for (std::size_t i = 0; i < i_group.size(); i++)
+			p_runJob(jobs[i_group[i]], i_job_fun);
+	}
+
+
+
+public:
+	/**
+	 * Run all jobs
+	 */
+	template <
+		typename T_GroupKeyFun,
+		typename T_GroupSetupFun,
+		typename T_GroupCleanupFun,
+		typename T_JobFun
+	>
+	void run(
+			T_GroupKeyFun i_group_key_fun,			///< std::string(const SimulationVariables&): key of group of job
+			T_GroupSetupFun i_group_setup_fun,		///< void(const SimulationVariables&): set up group for the given job, called outside of parallel regions
+			T_GroupCleanupFun i_group_cleanup_fun,	///< void(): release data of group
+			T_JobFun i_job_fun						///< void(Job&): run job, called concurrently by different thread teams
+	)
+	{
+		/*
+		 * Group jobs in the order of their first appearance
+		 */
+		std::vector<std::string> keys;
+		std::vector<std::vector<std::size_t>> groups;
+
+		for (std::size_t i = 0; i < jobs.size(); i++)
+		{
+			std::string key = i_group_key_fun(jobs[i].simVars);
+
+			std::size_t g = std::find(keys.begin(), keys.end(), key)-keys.begin();
+			if (g == keys.size())
+			{
+				keys.push_back(key);
+				groups.emplace_back();
+			}
+
+			groups[g].push_back(i);
+		}
+
+		Stopwatch watch;
+		watch.start();
+
+		for (std::size_t g = 0; g < groups.size(); g++)
+		{
+			std::cout << "BATCH GROUP " << keys[g] << ": " << groups[g].size() << " jobs" << std::endl;
+
+			i_group_setup_fun(jobs[groups[g][0]].simVars);
+
+			p_runGroup(groups[g], i_job_fun);
+
+			i_group_cleanup_fun();
+		}
+
+		watch.stop();
+
+		double sum_seconds = 0;
+		for (auto &job : jobs)
+			sum_seconds += job.wallclock_seconds;
+
+		std::cout << "Batch wallclock time (seconds): " << watch() << std::endl;
+		std::cout << "Batch accumulated job time (seconds): " << sum_seconds << std::endl;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_BATCHJOBRUNNER_HPP_ */
@@ -0,0 +1,293 @@
+/*
+ * Checkpoint.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_CHECKPOINT_HPP_
+#define SRC_INCLUDE_SWEET_CHECKPOINT_HPP_
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sweet/FatalError.hpp>
+
+
+/*
+ * Binary checkpoint files to restart simulations.
+ *
+ * A checkpoint file consists of a header followed by a sequence of named records.
+ * Each record is stored as
+ *
+ *   [uint32 length of name][name][uint64 size of payload][payload]
+ *
+ * The records have to be read in the same order as they were written.
+ * The names are only used to detect mismatching checkpoint files.
+ */
+namespace CheckpointFormat
+{
+	static const char magic[8] = {'S', 'W', 'E', 'E', 'T', 'C', 'K', 'P'};
+	static const std::uint32_t version = 1;
+}
+
+
+
+/**
+ * Write a checkpoint file.
+ *
+ * The data is first written to a temporary file which is then synced to disk
+ * and atomically renamed to the final file name in close().
+ * Hence, there's always a consistent checkpoint file available,
+ * even if the job is killed while writing the checkpoint.
+ */
+class CheckpointWriter
+{
+	std::string filename;
+	std::string tmp_filename;
+
+	std::ofstream file;
+
+	// position of size of payload of current record
+	std::streampos record_size_pos;
+
+
+public:
+	CheckpointWriter(
+			const std::string &i_filename
+	)	:
+		filename(i_filename),
+		tmp_filename(i_filename+".tmp")
+	{
+		file.open(tmp_filename, std::ios::binary | std::ios::trunc);
+
+		if (!file)
+			FatalError(std::string("Failed to open checkpoint file ")+tmp_filename);
+
+		file.write(CheckpointFormat::magic, sizeof(CheckpointFormat::magic));
+		file.write((const char*)&CheckpointFormat::version, sizeof(CheckpointFormat::version));
+	}
+
+
+	~CheckpointWriter()
+	{
+		if (file.is_open())
+			close();
+	}
+
+
+private:
+	void p_begin_record(
+			const char *i_name
+	)
+	{
+		std::uint32_t name_length = std::strlen(i_name);
+		file.write((const char*)&name_length, sizeof(name_length));
+		file.write(i_name, name_length);
+
+		record_size_pos = file.tellp();
+
+		std::uint64_t size = 0;
+		file.write((const char*)&size, sizeof(size));
+	}
+
+
+	void p_end_record()
+	{
+		std::streampos end_pos = file.tellp();
+		std::uint64_t size = end_pos - record_size_pos - (std::streamoff)sizeof(std::uint64_t);
+
+		file.seekp(record_size_pos);
+		file.write((const char*)&size, sizeof(size));
+		file.seekp(end_pos);
+	}
+
+
+public:
+	/**
+	 * Write plain data such as scalars or structs without pointers
+	 */
+	template <typename T>
+	void write(
+			const char *i_name,
+			const T &i_value
+	)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be stored directly");
+
+		p_begin_record(i_name);
+		file.write((const char*)&i_value, sizeof(T));
+		p_end_record();
+	}
+
+
+	void write(
+			const char *i_name,
+			const std::string &i_value
+	)
+	{
+		p_begin_record(i_name);
+		file.write(i_value.data(), i_value.size());
+		p_end_record();
+	}
+
+
+	/**
+	 * Write data arrays (e.g. PlaneData, SphereData) which provide file_checkpoint_write()
+	 */
+	template <typename T>
+	void write_data(
+			const char *i_name,
+			const T &i_data
+	)
+	{
+		p_begin_record(i_name);
+		i_data.file_checkpoint_write(file);
+		p_end_record();
+	}
+
+
+	/**
+	 * Finish the checkpoint file and move it to its final destination
+	 */
+	void close()
+	{
+		file.close();
+
+		if (file.fail())
+			FatalError(std::string("Failed to write checkpoint file ")+tmp_filename);
+
+		// make sure that the data is on disk before replacing the previous checkpoint
+		int fd = ::open(tmp_filename.c_str(), O_RDONLY);
+		if (fd < 0 || ::fsync(fd) != 0)
+			FatalError(std::string("Failed to sync checkpoint file ")+tmp_filename);
+		::close(fd);
+
+		if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+			FatalError(std::string("Failed to rename checkpoint file to ")+filename);
+	}
+};
+
+
+
+/**
+ * Read a checkpoint file written by CheckpointWriter
+ */
+class CheckpointReader
+{
+	std::string filename;
+
+	std::ifstream file;
+
+	// position of end of current record
+	std::streampos record_end_pos;
+
+
+public:
+	CheckpointReader(
+			const std::string &i_filename
+	)	:
+		filename(i_filename)
+	{
+		file.open(filename, std::ios::binary);
+
+		if (!file)
+			FatalError(std::string("Failed to open checkpoint file ")+filename);
+
+		char magic[sizeof(CheckpointFormat::magic)];
+		std::uint32_t version;
+
+		file.read(magic, sizeof(magic));
+		file.read((char*)&version, sizeof(version));
+
+		if (!file || std::memcmp(magic, CheckpointFormat::magic, sizeof(magic)) != 0)
+			FatalError(std::string("Invalid checkpoint file ")+filename);
+
+		if (version != CheckpointFormat::version)
+			FatalError(std::string("Unsupported version of checkpoint file ")+filename);
+	}
+
+
+private:
+	std::uint64_t p_begin_record(
+			const char *i_name
+	)
+	{
+		std::uint32_t name_length;
+		file.read((char*)&name_length, sizeof(name_length));
+
+		if (!file || name_length > 256)
+			FatalError(std::string("Checkpoint file ")+filename+": invalid record while reading '"+i_name+"'");
+
+		std::string name(name_length, '\0');
+		file.read(&name[0], name.size());
+
+		std::uint64_t size;
+		file.read((char*)&size, sizeof(size));
+
+		if (!file || name != i_name)
+			FatalError(std::string("Checkpoint file ")+filename+": expected record '"+i_name+"', but found '"+name+"'");
+
+		record_end_pos = file.tellg() + (std::streamoff)size;
+		return size;
+	}
+
+
+	void p_end_record(
+			const char *i_name
+	)
+	{
+		if (!file || file.tellg() != record_end_pos)
+			FatalError(std::string("Checkpoint file ")+filename+": size mismatch of record '"+i_name+"'");
+	}
+
+
+public:
+	template <typename T>
+	void read(
+			const char *i_name,
+			T &o_value
+	)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be restored directly");
+
+		p_begin_record(i_name);
+		file.read((char*)&o_value, sizeof(T));
+		p_end_record(i_name);
+	}
+
+
+	void read(
+			const char *i_name,
+			std::string &o_value
+	)
+	{
+		o_value.resize(p_begin_record(i_name));
+		file.read(&o_value[0], o_value.size());
+		p_end_record(i_name);
+	}
+
+
+	/**
+	 * Read data arrays (e.g. PlaneData, SphereData) which provide file_checkpoint_read()
+	 */
+	template <typename T>
+	void read_data(
+			const char *i_name,
+			T &o_data
+	)
+	{
+		p_begin_record(i_name);
+		o_data.file_checkpoint_read(file);
+		p_end_record(i_name);
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_CHECKPOINT_HPP_ */
@@ -27,6 +27,7 @@ public:
 		i_sphereData.request_data_physical();
 
 		PlaneData out(i_planeDataConfig);
+		out.physical_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -39,6 +39,12 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#	include <sys/mman.h>
+#	include <sys/syscall.h>
+#endif
 
 #if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
 #	include <omp.h>
@@ -46,8 +52,12 @@
 
 #include <cstdlib>
 #include <cassert>
+#include <csignal>
 #include <iostream>
 #include <vector>
+#include <map>
+#include <string>
+#include <unordered_map>
 
 
 
@@ -73,6 +83,42 @@ class MemBlockAlloc
 	 */
 	int verbosity = 1;
 
+	/**
+	 * Blocks of at least this size are aligned to huge pages,
+	 * advised to be backed by transparent huge pages and first touched in parallel
+	 */
+	static const std::size_t large_block_size = 2*1024*1024;
+
+	/**
+	 * Use transparent huge pages for large blocks
+	 * (disable with NUMA_BLOCK_ALLOC_HUGEPAGES=0)
+	 */
+	bool use_huge_pages = true;
+
+	/**
+	 * Initialize large blocks in parallel with the same static partitioning
+	 * as the loops over the data arrays to place the pages on the NUMA domains
+	 * of the threads working on them (disable with NUMA_BLOCK_ALLOC_FIRST_TOUCH=0)
+	 */
+	bool use_first_touch = true;
+
+	/**
+	 * Return the buffer of the representation which got invalid by a
+	 * transformation of a field (e.g. the spectral buffer after a backward FFT)
+	 * back to the allocator (enable with NUMA_BLOCK_ALLOC_RELEASE_UNUSED=1)
+	 */
+	bool release_unused_buffers = false;
+
+	/**
+	 * Record live, peak and cached bytes and the number of allocations
+	 * per block size, allocation domain and tag of the allocation site
+	 * (enable with NUMA_BLOCK_ALLOC_ACCOUNTING=1).
+	 *
+	 * The report is printed at program exit and with the next
+	 * allocation or release of a block after receiving SIGUSR1.
+	 */
+	bool accounting = false;
+
 	/**
 	 * List of memory blocks of same size
 	 */
@@ -113,6 +159,78 @@ private:
 	std::vector<DomainMemBlocks> domain_block_groups;
 
 
+public:
+	/**
+	 * Memory statistics of a group of blocks
+	 */
+	class AccountingStats
+	{
+	public:
+		std::size_t live_bytes = 0;		///< bytes of blocks in use
+		std::size_t peak_bytes = 0;		///< maximum of live bytes
+		std::size_t cached_bytes = 0;	///< bytes of released blocks kept for reuse
+		std::size_t num_allocs = 0;
+		std::size_t num_frees = 0;
+		std::size_t num_cache_hits = 0;	///< allocations served by cached blocks
+
+		void alloc(
+				std::size_t i_size,
+				bool i_cache_hit
+		)
+		{
+			live_bytes += i_size;
+			if (live_bytes > peak_bytes)
+				peak_bytes = live_bytes;
+
+			num_allocs++;
+			if (i_cache_hit)
+				num_cache_hits++;
+		}
+
+		void free(
+				std::size_t i_size
+		)
+		{
+			live_bytes -= i_size;
+			num_frees++;
+		}
+
+		void print(
+				std::ostream &o_ostream,
+				bool i_print_cached = true
+		)	const
+		{
+			double MB = 1.0/(1024.0*1024.0);
+
+			o_ostream << "live " << (double)live_bytes*MB << " MB, ";
+			o_ostream << "peak " << (double)peak_bytes*MB << " MB, ";
+			if (i_print_cached)
+				o_ostream << "cached " << (double)cached_bytes*MB << " MB, ";
+			o_ostream << "allocs " << num_allocs << ", ";
+			o_ostream << "frees " << num_frees << ", ";
+			o_ostream << "cache hits " << num_cache_hits;
+		}
+	};
+
+
+private:
+	/**
+	 * Allocation domain and tag of a block in use
+	 */
+	class AccountingBlockInfo
+	{
+	public:
+		int domain_id;
+		const char *tag;
+	};
+
+	AccountingStats acc_total;
+	std::vector<AccountingStats> acc_domains;
+	std::map<std::size_t, AccountingStats> acc_block_sizes;
+	std::map<std::string, AccountingStats> acc_tags;
+	std::unordered_map<const void*, AccountingBlockInfo> acc_blocks;
+
+
 	/**
 	 * Hardware page size to use for memory alignment.
 	 * (avoid overlapping pages for different NUMA nodes)
@@ -151,6 +269,65 @@ private:
 	}
 
 
+	/**
+	 * Tag of the allocation site of the current thread for the accounting
+	 */
+	inline
+	static
+	const char*& getThreadLocalTagRef()
+	{
+		static thread_local const char* tag = nullptr;
+		return tag;
+	}
+
+
+	/**
+	 * Set by the SIGUSR1 handler to request an accounting report
+	 */
+	static
+	volatile std::sig_atomic_t& getReportRequestRef()
+	{
+		static volatile std::sig_atomic_t report_request = 0;
+		return report_request;
+	}
+
+
+	static
+	void p_signal_handler(int)
+	{
+		getReportRequestRef() = 1;
+	}
+
+
+public:
+	/**
+	 * Tag all allocations of the current thread within the scope
+	 * of this object for the accounting, e.g.
+	 *
+	 * 	MemBlockAlloc::Tag tag("SWE_Sphere_REXI/PerThreadVars");
+	 *
+	 * The string has to be valid until the end of the program (e.g. a string literal).
+	 */
+	class Tag
+	{
+		const char *prev_tag;
+
+	public:
+		Tag(
+				const char *i_tag
+		)	:
+			prev_tag(getThreadLocalTagRef())
+		{
+			getThreadLocalTagRef() = i_tag;
+		}
+
+		~Tag()
+		{
+			getThreadLocalTagRef() = prev_tag;
+		}
+	};
+
+
 public:
 	MemBlockAlloc()	:
 		setup_done(false)
@@ -188,6 +365,33 @@ private:
 		else
 			verbosity = atoi(env_verbosity);
 
+		const char* env_huge_pages = getenv("NUMA_BLOCK_ALLOC_HUGEPAGES");
+		if (env_huge_pages != nullptr)
+			use_huge_pages = atoi(env_huge_pages);
+
+		const char* env_first_touch = getenv("NUMA_BLOCK_ALLOC_FIRST_TOUCH");
+		if (env_first_touch != nullptr)
+			use_first_touch = atoi(env_first_touch);
+
+		const char* env_release_unused = getenv("NUMA_BLOCK_ALLOC_RELEASE_UNUSED");
+		if (env_release_unused != nullptr)
+			release_unused_buffers = atoi(env_release_unused);
+
+		const char* env_accounting = getenv("NUMA_BLOCK_ALLOC_ACCOUNTING");
+		if (env_accounting != nullptr)
+			accounting = atoi(env_accounting);
+
+		if (accounting)
+			std::signal(SIGUSR1, p_signal_handler);
+
+		if (verbosity > 0)
+		{
+			std::cout << "NUMA block alloc: transparent huge pages for large blocks: " << use_huge_pages << std::endl;
+			std::cout << "NUMA block alloc: parallel first touch of large blocks: " << use_first_touch << std::endl;
+			std::cout << "NUMA block alloc: release unused field buffers: " << release_unused_buffers << std::endl;
+			std::cout << "NUMA block alloc: memory accounting: " << accounting << std::endl;
+		}
+
 
 #if  NUMA_BLOCK_ALLOCATOR_TYPE == 0
 
@@ -282,6 +486,7 @@ private:
 #endif
 
 		domain_block_groups.resize(num_alloc_domains);
+		acc_domains.resize(num_alloc_domains);
 
 #if 0
 		// TODO: care about first-touch policy
@@ -305,6 +510,14 @@ public:
 		if (verbosity > 1)
 			std::cout << "NUMABlockAlloc EXIT" << std::endl;
 
+		if (accounting)
+		{
+			p_printAccountingReport(std::cout);
+
+			// blocks of global objects might be released after this point
+			accounting = false;
+		}
+
 		for (auto& n : domain_block_groups)
 		{
 			for (auto& g : n.block_groups)
@@ -347,6 +560,73 @@ public:
 
 
 
+	/**
+	 * Return true if field classes should release the buffer
+	 * of a representation which is not valid anymore
+	 */
+	static
+	bool getReleaseUnusedBuffers()
+	{
+		return getSingletonRef().release_unused_buffers;
+	}
+
+
+
+	/**
+	 * Return the number of allocation domains
+	 */
+	static
+	int getNumAllocDomains()
+	{
+		return getSingletonRef().num_alloc_domains;
+	}
+
+
+
+	/**
+	 * Assign the current thread to an allocation domain.
+	 *
+	 * This is required for threads in nested parallel regions
+	 * (e.g. one thread team per Parareal time slice) since
+	 * these threads are not covered by the setup and
+	 * omp_get_thread_num() is not unique over all teams.
+	 *
+	 * For NUMA granularity, the domain is determined by the CPU the thread is running on.
+	 * For thread granularity, the program-wide unique thread id has to be provided.
+	 */
+	static
+	void setThreadLocalDomainId(
+			int i_thread_id		///< program-wide unique id of thread
+	)
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+#if NUMA_BLOCK_ALLOCATOR_TYPE == 1
+
+		getThreadLocalDomainIdRef() = numa_node_of_cpu(sched_getcpu());
+
+#elif NUMA_BLOCK_ALLOCATOR_TYPE == 2
+
+		if (i_thread_id < 0 || i_thread_id >= n.num_alloc_domains)
+		{
+			std::cerr << "ERROR: Thread id " << i_thread_id << " exceeds number of allocation domains " << n.num_alloc_domains << std::endl;
+			exit(1);
+		}
+
+		getThreadLocalDomainIdRef() = i_thread_id;
+
+#else
+
+		getThreadLocalDomainIdRef() = 0;
+
+#endif
+
+		if (n.verbosity > 1)
+			std::cout << "	thread " << i_thread_id << " is assigned to memory allocator domain " << getThreadLocalDomainIdRef() << std::endl;
+	}
+
+
+
 	/**
 	 * return a list of blocks with the same size
 	 *
@@ -382,6 +662,14 @@ public:
 	/**
 	 * Explicitly write data to the areas instead of relying on
 	 * the program to apply a first touch policy
+	 *
+	 * The data is written in parallel with the same static schedule as the one
+	 * of the loops over the physical data (PLANE_DATA_PHYSICAL_FOR_IDX),
+	 * hence each page is placed on the NUMA domain of the thread working on it.
+	 *
+	 * This is only done for large blocks of the shared allocators (0 and 3).
+	 * Blocks of the NUMA/thread-granular allocators are used by the allocating
+	 * thread or NUMA domain and are placed by its first access.
 	 */
 	template <typename T=void>
 	static
@@ -390,20 +678,323 @@ public:
 			std::size_t i_size
 	)
 	{
-#if 1
-		return i_data;
-#else
-		char *data = (char*)i_data;
+#if (NUMA_BLOCK_ALLOCATOR_TYPE == 0 || NUMA_BLOCK_ALLOCATOR_TYPE == 3) && SWEET_THREADING
+		if (i_size < large_block_size || !getSingletonRef().use_first_touch)
+			return i_data;
+
+		// threads in a parallel region are already working on their own data
+		if (omp_in_parallel())
+			return i_data;
 
-#pragma omp parallel for OPENMP_PAR_SIMD
-		for (std::size_t i = 0; i < i_size; i++)
+		double *data = (double*)i_data;
+		std::size_t n = i_size/sizeof(double);
+
+#pragma omp parallel for OPENMP_PAR_SIMD proc_bind(close)
+		for (std::size_t i = 0; i < n; i++)
 			data[i] = 0;
 
+		for (std::size_t i = n*sizeof(double); i < i_size; i++)
+			((char*)i_data)[i] = 0;
+#endif
+
 		return i_data;
+	}
+
+
+
+private:
+	/**
+	 * Advise the kernel to back large blocks with transparent huge pages.
+	 *
+	 * This has to be done before the pages are touched the first time.
+	 */
+	static
+	void p_advise_huge_pages(
+			void *i_data,
+			std::size_t i_size
+	)
+	{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		if (i_size < large_block_size || !getSingletonRef().use_huge_pages)
+			return;
+
+		if (madvise(i_data, i_size, MADV_HUGEPAGE) != 0)
+		{
+			if (getSingletonRef().verbosity > 0)
+				std::cerr << "NUMA block alloc: madvise(MADV_HUGEPAGE) failed" << std::endl;
+		}
+#endif
+	}
+
+
+	/**
+	 * Allocate a new block aligned to pages (huge pages for large blocks)
+	 */
+	static
+	void* p_posix_memalign(
+			std::size_t i_size
+	)
+	{
+		void *data = nullptr;
+
+		std::size_t alignment = 4096;
+		if (i_size >= large_block_size && getSingletonRef().use_huge_pages)
+			alignment = large_block_size;
+
+		// posix_memalign is thread safe
+		// http://www.qnx.com/developers/docs/6.3.0SP3/neutrino/lib_ref/p/posix_memalign.html
+		int retval = posix_memalign(&data, alignment, i_size);
+		if (retval != 0)
+		{
+			std::cerr << "Unable to allocate memory" << std::endl;
+			assert(false);
+			exit(-1);
+		}
+
+		p_advise_huge_pages(data, i_size);
+
+		return data;
+	}
+
+
+
+public:
+	/**
+	 * Return the number of pages of the given memory area located on each NUMA node.
+	 *
+	 * This is meant to verify the placement of the data of particular fields,
+	 * e.g. with PlaneData::get_physical_numa_placement().
+	 * Pages which are not yet touched are not counted.
+	 *
+	 * \return vector with the number of pages per NUMA node, empty if not supported
+	 */
+	static
+	std::vector<std::size_t> getNumaPlacement(
+			const void *i_data,
+			std::size_t i_size
+	)
+	{
+		std::vector<std::size_t> pages_per_node;
+
+#if defined(__linux__) && defined(SYS_move_pages)
+		std::size_t page_size = sysconf(_SC_PAGESIZE);
+
+		uintptr_t start = (uintptr_t)i_data & ~(uintptr_t)(page_size-1);
+		uintptr_t end = (uintptr_t)i_data + i_size;
+
+		// query pages in batches
+		const std::size_t batch_size = 1024;
+		std::vector<void*> pages(batch_size);
+		std::vector<int> status(batch_size);
+
+		for (uintptr_t p = start; p < end; )
+		{
+			std::size_t n = 0;
+			for (; n < batch_size && p < end; n++, p += page_size)
+				pages[n] = (void*)p;
+
+			// move_pages() without target nodes only returns the nodes of the pages
+			if (syscall(SYS_move_pages, 0, n, pages.data(), nullptr, status.data(), 0) != 0)
+				return std::vector<std::size_t>();
+
+			for (std::size_t i = 0; i < n; i++)
+			{
+				// negative values: page not present
+				if (status[i] < 0)
+					continue;
+
+				if ((std::size_t)status[i] >= pages_per_node.size())
+					pages_per_node.resize(status[i]+1, 0);
+
+				pages_per_node[status[i]]++;
+			}
+		}
+#endif
+
+		return pages_per_node;
+	}
+
+
+
+private:
+	/**
+	 * Print the accounting report without synchronization
+	 */
+	void p_printAccountingReport(
+			std::ostream &o_ostream
+	)	const
+	{
+		o_ostream << "NUMA block alloc: memory accounting" << std::endl;
+
+		o_ostream << "  total: ";
+		acc_total.print(o_ostream);
+		o_ostream << std::endl;
+
+		for (std::size_t i = 0; i < acc_domains.size(); i++)
+		{
+			o_ostream << "  domain " << i << ": ";
+			acc_domains[i].print(o_ostream);
+			o_ostream << std::endl;
+		}
+
+		for (auto &a : acc_block_sizes)
+		{
+			o_ostream << "  block size " << a.first << ": ";
+			a.second.print(o_ostream);
+			o_ostream << std::endl;
+		}
+
+		// cached blocks are shared by all allocation sites
+		for (auto &a : acc_tags)
+		{
+			o_ostream << "  tag " << a.first << ": ";
+			a.second.print(o_ostream, false);
+			o_ostream << std::endl;
+		}
+	}
+
+
+	/**
+	 * Return statistics of the current domain (resized for nested threads)
+	 */
+	AccountingStats& p_accountingDomainStats(
+			int i_domain_id
+	)
+	{
+		if (i_domain_id >= (int)acc_domains.size())
+			acc_domains.resize(i_domain_id+1);
+
+		return acc_domains[i_domain_id];
+	}
+
+
+	static
+	void p_accountingAlloc(
+			const void *i_data,
+			std::size_t i_size,
+			bool i_cache_hit
+	)
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+		if (!n.accounting)
+			return;
+
+		int domain_id = getThreadLocalDomainIdRef();
+		const char *tag = getThreadLocalTagRef();
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#	pragma omp critical (MemBlockAllocAccounting)
+#endif
+		{
+			n.acc_blocks[i_data] = AccountingBlockInfo{domain_id, tag};
+
+			AccountingStats* stats[3] = {
+					&n.acc_total,
+					&n.p_accountingDomainStats(domain_id),
+					&n.acc_block_sizes[i_size]
+				};
+
+			for (AccountingStats *s : stats)
+			{
+				s->alloc(i_size, i_cache_hit);
+				if (i_cache_hit)
+					s->cached_bytes -= i_size;
+			}
+
+			n.acc_tags[tag == nullptr ? "untagged" : tag].alloc(i_size, i_cache_hit);
+
+			if (getReportRequestRef())
+			{
+				getReportRequestRef() = 0;
+				n.p_printAccountingReport(std::cout);
+			}
+		}
+	}
+
+
+	static
+	void p_accountingFree(
+			const void *i_data,
+			std::size_t i_size,
+			bool i_cached
+	)
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+		if (!n.accounting)
+			return;
+
+		int domain_id = getThreadLocalDomainIdRef();
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#	pragma omp critical (MemBlockAllocAccounting)
+#endif
+		{
+			AccountingBlockInfo info{domain_id, nullptr};
+
+			auto iter = n.acc_blocks.find(i_data);
+			if (iter != n.acc_blocks.end())
+			{
+				info = iter->second;
+				n.acc_blocks.erase(iter);
+			}
+
+			n.acc_total.free(i_size);
+			n.p_accountingDomainStats(info.domain_id).free(i_size);
+			n.acc_block_sizes[i_size].free(i_size);
+			n.acc_tags[info.tag == nullptr ? "untagged" : info.tag].free(i_size);
+
+			// released blocks are cached in the list of the current domain
+			if (i_cached)
+			{
+				n.acc_total.cached_bytes += i_size;
+				n.p_accountingDomainStats(domain_id).cached_bytes += i_size;
+				n.acc_block_sizes[i_size].cached_bytes += i_size;
+			}
+
+			if (getReportRequestRef())
+			{
+				getReportRequestRef() = 0;
+				n.p_printAccountingReport(std::cout);
+			}
+		}
+	}
+
+
+public:
+	/**
+	 * Print the report of the memory accounting
+	 * (only available with NUMA_BLOCK_ALLOC_ACCOUNTING=1)
+	 */
+	static
+	void printAccountingReport(
+			std::ostream &o_ostream = std::cout
+	)
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+		if (!n.accounting)
+			return;
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#	pragma omp critical (MemBlockAllocAccounting)
 #endif
+		n.p_printAccountingReport(o_ostream);
 	}
 
 
+	/**
+	 * Return the accounting statistics over all blocks
+	 */
+	static
+	AccountingStats getAccountingTotal()
+	{
+		return getSingletonRef().acc_total;
+	}
+
+
+
 public:
 	template <typename T=void>
 	static
@@ -436,9 +1027,17 @@ public:
 		}
 
 		if (data != nullptr)
+		{
+			p_accountingAlloc(data, i_size, true);
 			return data;
+		}
 
-		return (T*)first_touch_init(numa_alloc(i_size), i_size);
+		data = (T*)numa_alloc(i_size);
+		p_advise_huge_pages(data, i_size);
+
+		first_touch_init(data, i_size);
+		p_accountingAlloc(data, i_size, false);
+		return data;
 
 #elif NUMA_BLOCK_ALLOCATOR_TYPE == 3
 
@@ -456,34 +1055,24 @@ public:
 		}
 
 		if (data != nullptr)
-			return data;
-
-		int retval = posix_memalign((void**)&data, 4096, i_size);
-		if (retval != 0)
 		{
-			std::cerr << "Unable to allocate memory" << std::endl;
-			assert(false);
-			exit(-1);
+			p_accountingAlloc(data, i_size, true);
+			return data;
 		}
 
+		data = (T*)p_posix_memalign(i_size);
+
 		first_touch_init(data, i_size);
+		p_accountingAlloc(data, i_size, false);
 		return data;
 
 #else
 
 		// allocate a new element to the list of blocks given in block_list
-
-		// posix_memalign is thread safe
-		// http://www.qnx.com/developers/docs/6.3.0SP3/neutrino/lib_ref/p/posix_memalign.html
-		int retval = posix_memalign((void**)&data, 4096, i_size);
-		if (retval != 0)
-		{
-			std::cerr << "Unable to allocate memory" << std::endl;
-			assert(false);
-			exit(-1);
-		}
+		data = (T*)p_posix_memalign(i_size);
 
 		first_touch_init(data, i_size);
+		p_accountingAlloc(data, i_size, false);
 		return data;
 
 #endif
@@ -502,6 +1091,8 @@ public:
 		if (i_data == nullptr)
 			return;
 
+		p_accountingFree(i_data, i_size, NUMA_BLOCK_ALLOCATOR_TYPE != 0);
+
 #if NUMA_BLOCK_ALLOCATOR_TYPE == 0
 
 		::free(i_data);
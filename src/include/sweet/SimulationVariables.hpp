@@ -123,6 +123,9 @@ public:
 		/// use "BINARY;filename1;filename2" to specify that the binary files should be read in binary format
 		bool input_data_binary = false;
 
+		/// directory to cache generated initial conditions of benchmarks, empty to disable file cache
+		std::string benchmark_cache_dir = "";
+
 
 		void setup_initial_condition_filenames(
 				const std::string i_string
@@ -163,6 +166,7 @@ public:
 			for (std::size_t i = 0; i < input_data_filenames.size(); i++)
 				std::cout << "    - filename " << i << " " << input_data_filenames[i] << std::endl;
 			std::cout << " + input_data_binary: " << input_data_binary << std::endl;
+			std::cout << " + benchmark_cache_dir: " << benchmark_cache_dir << std::endl;
 			std::cout << std::endl;
 		}
 	} setup;
@@ -170,9 +174,12 @@ public:
 
 
 	/**
-	 * simulation coefficients
+	 * values of the simulation coefficients
+	 *
+	 * These are copied with the defaulted copy operations,
+	 * hence new coefficients are added here.
 	 */
-	struct SimulationCoefficients
+	struct SimulationCoefficientValues
 	{
 		/// average height for initialization
 		double h0 = 1000.0;
@@ -213,11 +220,6 @@ public:
 		 */
 		double earth_radius = 6.37122e6;
 
-		/**
-		 * Coriolis effect
-		 */
-		double &coriolis_omega = f0;
-
 		/**
 		 * Gravitational constant
 		 */
@@ -228,6 +230,41 @@ public:
 
 		/// domain size
 		double domain_size[2] = {1.0, 1.0};
+	};
+
+
+	/**
+	 * simulation coefficients
+	 */
+	struct SimulationCoefficients	:
+		public SimulationCoefficientValues
+	{
+		/**
+		 * Coriolis effect
+		 */
+		double &coriolis_omega = f0;
+
+
+		SimulationCoefficients()
+		{
+		}
+
+
+		/**
+		 * Copy only the values to keep coriolis_omega referring
+		 * to f0 of this object and not to the one of the copied object.
+		 */
+		SimulationCoefficients(const SimulationCoefficients &i_src)	:
+			SimulationCoefficientValues(i_src)
+		{
+		}
+
+
+		SimulationCoefficients& operator=(const SimulationCoefficients &i_src)
+		{
+			SimulationCoefficientValues::operator=(i_src);
+			return *this;
+		}
 
 
 		void outputConfig()
@@ -434,6 +471,67 @@ public:
 		 */
 		bool rexi_normalization = true;
 
+		/**
+		 * Directory to cache REXI coefficients, empty to disable file cache
+		 */
+		std::string rexi_coefficient_cache_dir = "";
+
+		/**
+		 * Number of time step sizes for which the REXI solvers are kept
+		 * (0: set up solvers in each time step)
+		 */
+		int rexi_solver_cache_size = 0;
+
+		/**
+		 * Snap variable time step sizes down to rexi_timestep_snap*2^k
+		 * to reuse cached REXI solvers (0: no snapping)
+		 */
+		double rexi_timestep_snap = 0;
+
+		/**
+		 * Rebalance the REXI poles across MPI ranks based on measured costs.
+		 * This changes the summation order, hence results are not bitwise reproducible.
+		 */
+		bool rexi_rebalance_ranks = false;
+
+
+		/**
+		 * Return the largest time step size for which REXI still approximates
+		 * exp(i*omega*dt) for all frequencies |omega| <= i_max_frequency.
+		 *
+		 * The approximation of exp(ix) is only accurate for |x| <= h*M.
+		 */
+		double getMaxTimestepSize(double i_max_frequency)	const
+		{
+			if (i_max_frequency <= 0)
+				return std::numeric_limits<double>::infinity();
+
+			return rexi_h*rexi_M/i_max_frequency;
+		}
+
+
+		/**
+		 * Snap a time step size down to the largest value
+		 * rexi_timestep_snap*2^k (k integer) not larger than it.
+		 *
+		 * This limits the number of different time step sizes
+		 * with an adaptive (CFL-based) time step size.
+		 */
+		double snapTimestepSize(double i_dt)	const
+		{
+			if (rexi_timestep_snap <= 0 || i_dt <= 0 || std::isinf(i_dt))
+				return i_dt;
+
+			int k = (int)std::floor(std::log2(i_dt/rexi_timestep_snap));
+			double dt = std::ldexp(rexi_timestep_snap, k);
+
+			// avoid round-off issues
+			if (dt > i_dt)
+				dt *= 0.5;
+
+			return dt;
+		}
+
 		void outputConfig()
 		{
 			std::cout << std::endl;
@@ -444,6 +542,10 @@ public:
 			std::cout << " + rexi_use_half_poles: " << rexi_use_half_poles << std::endl;
 			std::cout << " + rexi_use_extended_modes: " << rexi_use_extended_modes << std::endl;
 			std::cout << " + rexi_normalization: " << rexi_normalization << std::endl;
+			std::cout << " + rexi_coefficient_cache_dir: " << rexi_coefficient_cache_dir << std::endl;
+			std::cout << " + rexi_solver_cache_size: " << rexi_solver_cache_size << std::endl;
+			std::cout << " + rexi_timestep_snap: " << rexi_timestep_snap << std::endl;
+			std::cout << " + rexi_rebalance_ranks: " << rexi_rebalance_ranks << std::endl;
 			std::cout << std::endl;
 		}
 	} rexi;
@@ -530,6 +632,10 @@ public:
 			std::cout << " + use_nonlinear_equations: " << use_nonlinear_equations << std::endl;
 			std::cout << " + sphere_use_robert_functions: " << sphere_use_robert_functions << std::endl;
 			std::cout << " + output_time_scale: " << output_time_scale << std::endl;
+			std::cout << " + checkpoint_file_name: " << checkpoint_file_name << std::endl;
+			std::cout << " + checkpoint_each_wallclock_seconds: " << checkpoint_each_wallclock_seconds << std::endl;
+			std::cout << " + restart_file_name: " << restart_file_name << std::endl;
+			std::cout << " + output_image_each_timesteps: " << output_image_each_timesteps << std::endl;
 			std::cout << std::endl;
 		}
 
@@ -568,6 +674,24 @@ public:
 		/// e.g. use scaling by 1.0/(60*60) to output days instead of seconds
 		double output_time_scale = 1.0;
 
+		/// file name of checkpoint which is written during the simulation
+		std::string checkpoint_file_name = "";
+
+		/// write checkpoint each given period of wallclock time (-1: disabled)
+		double checkpoint_each_wallclock_seconds = -1;
+
+		/// checkpoint file to restart the simulation from
+		std::string restart_file_name = "";
+
+		/// write images of the simulation data each given number of time steps (-1: disabled)
+		int output_image_each_timesteps = -1;
+
+		/// file with the program arguments of one simulation per line, see BatchJobRunner
+		std::string batch_job_file_name = "";
+
+		/// number of thread teams which run batch jobs concurrently
+		int batch_num_teams = 1;
+
 	} misc;
 
 
@@ -658,7 +782,7 @@ public:
 			const char *bogus_var_names[] = nullptr			///< list of strings of simulation-specific variables, has to be terminated by nullptr
 	)
 	{
-		const int max_options = 50;
+		const int max_options = 60;
         static struct option long_options[max_options+1] = {
     			{0, 0, 0, 0}, // 0
     			{0, 0, 0, 0}, // 1
@@ -715,6 +839,17 @@ public:
 				{0, 0, 0, 0}, // 8
 				{0, 0, 0, 0}, // 9	Option Nr. 50
 
+				{0, 0, 0, 0}, // 0
+				{0, 0, 0, 0}, // 1
+				{0, 0, 0, 0}, // 2
+				{0, 0, 0, 0}, // 3
+				{0, 0, 0, 0}, // 4
+				{0, 0, 0, 0}, // 5
+				{0, 0, 0, 0}, // 6
+				{0, 0, 0, 0}, // 7
+				{0, 0, 0, 0}, // 8
+				{0, 0, 0, 0}, // 9	Option Nr. 60
+
 				{0, 0, 0, 0} // NULL
         };
 
@@ -771,11 +906,50 @@ public:
         long_options[next_free_program_option] = {"timestepping-order2", required_argument, 0, 256+next_free_program_option};
         next_free_program_option++;
 
+        // 16
+        long_options[next_free_program_option] = {"rexi-cache-dir", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        // 17
+        long_options[next_free_program_option] = {"checkpoint-file", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"checkpoint-interval", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"restart-file", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        // 20
+        long_options[next_free_program_option] = {"output-image-steps", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"benchmark-cache-dir", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        // 22
+        long_options[next_free_program_option] = {"rexi-solver-cache-size", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"rexi-dt-snap", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        // 24
+        long_options[next_free_program_option] = {"batch-jobs", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        long_options[next_free_program_option] = {"batch-teams", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
+        // 26
+        long_options[next_free_program_option] = {"rexi-rebalance-ranks", required_argument, 0, 256+next_free_program_option};
+        next_free_program_option++;
+
 
 // leave this commented to avoid mismatch with following parameters!
 #if SWEET_PFASST_CPP
 
-        // 16
+        // 27
 		long_options[next_free_program_option] = {"pfasst-nlevels", required_argument, 0, 256+next_free_program_option};
 		next_free_program_option++;
 
@@ -873,14 +1047,31 @@ public:
 						case 14:	disc.timestepping_method2 = atoi(optarg);	break;
 						case 15:	disc.timestepping_order2 = atoi(optarg);	break;
 
+						case 16:	rexi.rexi_coefficient_cache_dir = optarg;	break;
+
+						case 17:	misc.checkpoint_file_name = optarg;	break;
+						case 18:	misc.checkpoint_each_wallclock_seconds = atof(optarg);	break;
+						case 19:	misc.restart_file_name = optarg;	break;
+
+						case 20:	misc.output_image_each_timesteps = atoi(optarg);	break;
+						case 21:	setup.benchmark_cache_dir = optarg;	break;
+
+						case 22:	rexi.rexi_solver_cache_size = atoi(optarg);	break;
+						case 23:	rexi.rexi_timestep_snap = atof(optarg);	break;
+
+						case 24:	misc.batch_job_file_name = optarg;	break;
+						case 25:	misc.batch_num_teams = atoi(optarg);	break;
+
+						case 26:	rexi.rexi_rebalance_ranks = atoi(optarg);	break;
+
 
 #if SWEET_PFASST_CPP
-						case 16:	pfasst.nlevels = atoi(optarg);	break;
-						case 17:	pfasst.nnodes = atoi(optarg);	break;
-						case 18:	pfasst.nspace = atoi(optarg);	break;
-						case 19:	pfasst.nsteps = atoi(optarg);	break;
-						case 20:	pfasst.niters = atoi(optarg);	break;
-						case 21:	pfasst.dt = atof(optarg);	break;
+						case 27:	pfasst.nlevels = atoi(optarg);	break;
+						case 28:	pfasst.nnodes = atoi(optarg);	break;
+						case 29:	pfasst.nspace = atoi(optarg);	break;
+						case 30:	pfasst.nsteps = atoi(optarg);	break;
+						case 31:	pfasst.niters = atoi(optarg);	break;
+						case 32:	pfasst.dt = atof(optarg);	break;
 #endif
 						default:
 #if SWEET_PARAREAL
@@ -1091,15 +1282,26 @@ public:
 				std::cout << "	-V [double]	period of outputConfig" << std::endl;
 				std::cout << "	-G [0/1]	graphical user interface" << std::endl;
 				std::cout << "	-O [string]	string prefix for filename of output of simulation data" << std::endl;
+				std::cout << "	--output-image-steps [int]	write images of simulation data each given number of time steps, default: -1 (disabled)" << std::endl;
 				std::cout << "	-d [int]	accuracy of floating point output" << std::endl;
 				std::cout << "	-i [file0][;file1][;file3]...	string with filenames for initial conditions" << std::endl;
 				std::cout << "	            specify BINARY; as first file name to read files as binary raw data" << std::endl;
+				std::cout << "	--benchmark-cache-dir [string]	Directory to cache generated initial conditions of benchmarks, default: '' (no file cache)" << std::endl;
 				std::cout << "	--use-robert-functions [bool]	Use Robert function formulation for velocities on the sphere" << std::endl;
 				std::cout << "	--nonlinear [int]	Use non-linear (>=1) if available or linear (0) formulation, default: 1" << std::endl;
 				std::cout << "						     0: Linear " << std::endl;
 				std::cout << "						     1: Nonlinear (default)" << std::endl;
 				std::cout << "						     2: Linear + nonlinear advection only (needs -H to be set)" << std::endl;
 				std::cout << "" << std::endl;
+				std::cout << "Checkpointing" << std::endl;
+				std::cout << "	--checkpoint-file [string]	File name of checkpoint, default: '' (no checkpointing)" << std::endl;
+				std::cout << "	--checkpoint-interval [float]	Write checkpoint each given number of wallclock seconds, default: -1 (only at end of simulation)" << std::endl;
+				std::cout << "	--restart-file [string]	Restart simulation from given checkpoint file" << std::endl;
+				std::cout << "" << std::endl;
+				std::cout << "Batch jobs" << std::endl;
+				std::cout << "	--batch-jobs [string]	File with program arguments of one simulation per line, run all of them in this process" << std::endl;
+				std::cout << "	--batch-teams [int]	Number of thread teams running batch jobs concurrently, default: 1" << std::endl;
+				std::cout << "" << std::endl;
 				std::cout << "Rexi" << std::endl;
 				std::cout << "	--rexi [bool]	Time stepping method: 0: explicit, 1: REXI, -1: implicit" << std::endl;
 				std::cout << "	--rexi-h [float]	REXI parameter h" << std::endl;
@@ -1108,6 +1310,10 @@ public:
 				std::cout << "	--rexi-half [bool]	Use half REXI poles, default:1" << std::endl;
 				std::cout << "	--rexi-normalization [bool]	Use REXI normalization around geostrophic balance, default:1" << std::endl;
 				std::cout << "	--rexi-ext-modes [int]	Use this number of extended modes in spherical harmonics" << std::endl;
+				std::cout << "	--rexi-cache-dir [string]	Directory to cache REXI coefficients, default: '' (no file cache)" << std::endl;
+				std::cout << "	--rexi-solver-cache-size [int]	Number of time step sizes for which REXI solvers are kept, default: 0 (no preallocation)" << std::endl;
+				std::cout << "	--rexi-dt-snap [float]	Snap variable time step sizes down to this value times 2^k, default: 0 (no snapping)" << std::endl;
+				std::cout << "	--rexi-rebalance-ranks [bool]	Rebalance REXI poles across MPI ranks (not bitwise reproducible), default: 0" << std::endl;
 				std::cout << "" << std::endl;
 
 
@@ -1122,7 +1328,9 @@ public:
 			}
 		}
 
-		if (	(disc.res_physical[0] == 0 || disc.res_physical[1] == 0)	&&
+		// the resolution of batch jobs is given in the job file
+		if (	misc.batch_job_file_name == ""	&&
+				(disc.res_physical[0] == 0 || disc.res_physical[1] == 0)	&&
 				(disc.res_spectral[0] == 0 || disc.res_spectral[1] == 0)
 			)
 		{
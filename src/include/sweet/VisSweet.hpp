@@ -8,6 +8,7 @@
 #define SRC_EXAMPLES_VISSWEET_HPP_
 
 #include <sweet/VisSweetHUD.hpp>
+#include <sweet/VisSweetImageWriter.hpp>
 #include "../libgl/draw/GlDrawCube.hpp"
 #include "../libgl/shaders/shader_blinn/CShaderBlinn.hpp"
 #include "../libgl/VisualizationEngine.hpp"
@@ -128,25 +129,14 @@ class VisSweet	:
 		vis_min = visData.reduce_min();
 		vis_max = visData.reduce_max();
 
-		vis_max = std::max(vis_max, vis_min+1e-20);	//< avoid numerical issues if min == max
-
-		double real_delta = vis_max-vis_min;
-//		vis_min -= real_delta*0.03;
-//		vis_max += real_delta*0.03;
-
-		double inv_delta = 1.0/real_delta;
-
-#pragma omp parallel for OPENMP_PAR_SIMD
-		for (	std::size_t i = 0;
-				i < visData.planeDataConfig->physical_array_data_number_of_elements;
-				i++
-		)
-		{
-			double value = (visData.physical_space_data[i]-vis_min)*inv_delta;
-			value *= 255.0;
-
-			texture_data[i] = (unsigned char)std::min(255.0, std::max(0.0, value));//			texture_data[i] = 128;
-		}
+		VisSweetImageWriter::normalize(
+				visData.physical_space_data,
+				visData.planeDataConfig->physical_array_data_number_of_elements,
+				vis_min,
+				vis_max,
+				texture_data,
+				true
+			);
 
 		glTexture->bind();
 		glTexture->setData(texture_data);
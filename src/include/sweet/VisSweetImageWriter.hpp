@@ -0,0 +1,410 @@
+/*
+ * VisSweetImageWriter.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_VISSWEETIMAGEWRITER_HPP_
+#define SRC_INCLUDE_SWEET_VISSWEETIMAGEWRITER_HPP_
+
+#ifndef SWEET_ZLIB
+#	define SWEET_ZLIB	0
+#endif
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <sweet/openmp_helper.hpp>
+
+#if SWEET_ZLIB
+#	include <zlib.h>
+#endif
+
+
+/**
+ * Headless in-situ rendering of scalar fields to image files.
+ *
+ * The data is mapped with the same normalization as the one of VisSweet
+ * and with the rainbow color map of the shader 'shader_texturize_rainbowmap'
+ * to an RGB image on the CPU.
+ *
+ * The rendering and writing of the images is done in a background thread,
+ * the simulation only has to copy the physical data.
+ *
+ * Images are written as PNG files if compiled with zlib (--zlib=enable),
+ * otherwise as binary PPM files.
+ */
+class VisSweetImageWriter
+{
+	struct Frame
+	{
+		std::string filename;
+		std::vector<double> data;
+		int width;
+		int height;
+		bool column_major;
+	};
+
+	/**
+	 * Maximum number of frames in the queue.
+	 * The simulation is blocked if it's generating frames faster
+	 * than they can be written.
+	 */
+	static const std::size_t max_queued_frames = 4;
+
+	std::deque<Frame*> queue;
+	std::mutex queue_mutex;
+	std::condition_variable queue_cond;
+
+	std::thread worker_thread;
+	bool worker_running = false;
+	bool worker_quit = false;
+
+
+public:
+	VisSweetImageWriter()
+	{
+	}
+
+
+	~VisSweetImageWriter()
+	{
+		finish();
+	}
+
+
+	/**
+	 * Return the file extension (including the dot) of the written images
+	 */
+	static
+	const char* get_file_extension()
+	{
+#if SWEET_ZLIB
+		return ".png";
+#else
+		return ".ppm";
+#endif
+	}
+
+
+	/**
+	 * Replace the extension of a file name generated from the output file
+	 * name template by the one of the image files.
+	 *
+	 * Only known extensions are removed since the file names
+	 * contain the simulation time, e.g. "prog_h_t00000000001.50000000".
+	 */
+	static
+	std::string replace_file_extension(
+			const std::string &i_filename
+	)
+	{
+		static const char* extensions[] = {".csv", ".bmp", ".png", ".ppm"};
+
+		std::string filename = i_filename;
+
+		for (const char *ext : extensions)
+		{
+			std::size_t len = std::char_traits<char>::length(ext);
+
+			if (filename.size() >= len && filename.compare(filename.size()-len, len, ext) == 0)
+			{
+				filename.resize(filename.size()-len);
+				break;
+			}
+		}
+
+		return filename + get_file_extension();
+	}
+
+
+	/**
+	 * Map data to bytes in [0;255] between given minimum and maximum values.
+	 *
+	 * This is also used by VisSweet to prepare the texture data.
+	 * The background thread of the writer doesn't use threading
+	 * to not compete with the simulation for the cores.
+	 */
+	static
+	void normalize(
+			const double *i_data,
+			std::size_t i_size,
+			double i_min,
+			double &io_max,
+			unsigned char *o_data,
+			bool i_threaded = false
+	)
+	{
+		io_max = std::max(io_max, i_min+1e-20);	//< avoid numerical issues if min == max
+
+		double inv_delta = 1.0/(io_max-i_min);
+
+#if SWEET_THREADING
+#pragma omp parallel for OPENMP_PAR_SIMD if(i_threaded)
+#endif
+		for (std::size_t i = 0; i < i_size; i++)
+		{
+			double value = (i_data[i]-i_min)*inv_delta;
+			value *= 255.0;
+
+			o_data[i] = (unsigned char)std::min(255.0, std::max(0.0, value));
+		}
+	}
+
+
+	/**
+	 * Rainbow color map, see data/shaders_glsl/shader_texturize_rainbowmap
+	 */
+	static
+	void colormap(
+			unsigned char i_value,
+			unsigned char *o_rgb
+	)
+	{
+		static const double centers[3] = {0.75, 0.5, 0.25};
+
+		double f = (double)i_value*(1.0/255.0);
+
+		for (int c = 0; c < 3; c++)
+		{
+			double x = 3.3*(f-centers[c]);
+			o_rgb[c] = (unsigned char)(std::max(0.0, 1.0-x*x)*255.0+0.5);
+		}
+	}
+
+
+	/**
+	 * Render data to RGB image.
+	 *
+	 * The data is either stored row-major with the rows along the x-axis (PlaneData)
+	 * or column-major with the columns along the latitude (SphereData).
+	 * The first row of the image is the last row of the data
+	 * to match the ASCII output of PlaneData and SphereData.
+	 */
+	static
+	void render(
+			const double *i_data,
+			int i_width,
+			int i_height,
+			bool i_column_major,
+			std::vector<unsigned char> &o_rgb
+	)
+	{
+		std::size_t size = (std::size_t)i_width*i_height;
+
+		double vis_min = *std::min_element(i_data, i_data+size);
+		double vis_max = *std::max_element(i_data, i_data+size);
+
+		std::vector<unsigned char> values(size);
+		normalize(i_data, size, vis_min, vis_max, values.data());
+
+		o_rgb.resize(size*3);
+
+		for (int y = 0; y < i_height; y++)
+		{
+			int j = i_height-1-y;
+
+			for (int x = 0; x < i_width; x++)
+			{
+				std::size_t idx = i_column_major ? (std::size_t)x*i_height+j : (std::size_t)j*i_width+x;
+				colormap(values[idx], &o_rgb[((std::size_t)y*i_width+x)*3]);
+			}
+		}
+	}
+
+
+private:
+#if SWEET_ZLIB
+	static
+	void p_png_write_uint32(
+			std::ofstream &o_file,
+			std::uint32_t i_value
+	)
+	{
+		unsigned char b[4] = {
+				(unsigned char)(i_value >> 24), (unsigned char)(i_value >> 16),
+				(unsigned char)(i_value >> 8), (unsigned char)i_value
+			};
+		o_file.write((const char*)b, 4);
+	}
+
+
+	static
+	void p_png_write_chunk(
+			std::ofstream &o_file,
+			const char *i_type,
+			const unsigned char *i_data,
+			std::size_t i_size
+	)
+	{
+		p_png_write_uint32(o_file, i_size);
+		o_file.write(i_type, 4);
+		o_file.write((const char*)i_data, i_size);
+
+		uLong crc = crc32(0, (const Bytef*)i_type, 4);
+		if (i_size > 0)	// crc32() returns 0 for a null pointer
+			crc = crc32(crc, i_data, i_size);
+		p_png_write_uint32(o_file, crc);
+	}
+#endif
+
+
+public:
+	/**
+	 * Write RGB image to file
+	 *
+	 * \return true if the image was written successfully
+	 */
+	static
+	bool write_image(
+			const std::string &i_filename,
+			const std::vector<unsigned char> &i_rgb,
+			int i_width,
+			int i_height
+	)
+	{
+		std::ofstream file(i_filename, std::ios::binary | std::ios::trunc);
+
+#if SWEET_ZLIB
+		static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+		file.write((const char*)signature, 8);
+
+		unsigned char ihdr[13] = {
+				(unsigned char)(i_width >> 24), (unsigned char)(i_width >> 16), (unsigned char)(i_width >> 8), (unsigned char)i_width,
+				(unsigned char)(i_height >> 24), (unsigned char)(i_height >> 16), (unsigned char)(i_height >> 8), (unsigned char)i_height,
+				8,	// bit depth
+				2,	// RGB
+				0, 0, 0		// compression, filter, interlace
+			};
+		p_png_write_chunk(file, "IHDR", ihdr, 13);
+
+		// each scanline is prefixed with its filter type (0: none)
+		std::size_t row_size = (std::size_t)i_width*3;
+		std::vector<unsigned char> raw((row_size+1)*i_height);
+		for (int y = 0; y < i_height; y++)
+		{
+			raw[y*(row_size+1)] = 0;
+			std::copy(&i_rgb[y*row_size], &i_rgb[y*row_size]+row_size, &raw[y*(row_size+1)+1]);
+		}
+
+		uLongf compressed_size = compressBound(raw.size());
+		std::vector<unsigned char> compressed(compressed_size);
+		if (compress2(compressed.data(), &compressed_size, raw.data(), raw.size(), Z_DEFAULT_COMPRESSION) != Z_OK)
+			return false;
+
+		p_png_write_chunk(file, "IDAT", compressed.data(), compressed_size);
+		p_png_write_chunk(file, "IEND", nullptr, 0);
+#else
+		file << "P6\n" << i_width << " " << i_height << "\n255\n";
+		file.write((const char*)i_rgb.data(), i_rgb.size());
+#endif
+
+		return file.good();
+	}
+
+
+
+private:
+	void p_worker()
+	{
+		std::vector<unsigned char> rgb;
+
+		while (true)
+		{
+			Frame *frame;
+
+			{
+				std::unique_lock<std::mutex> lock(queue_mutex);
+				queue_cond.wait(lock, [this]{ return worker_quit || !queue.empty(); });
+
+				if (queue.empty())
+					return;
+
+				frame = queue.front();
+			}
+
+			render(frame->data.data(), frame->width, frame->height, frame->column_major, rgb);
+
+			if (!write_image(frame->filename, rgb, frame->width, frame->height))
+				std::cerr << "Failed to write image " << frame->filename << std::endl;
+
+			{
+				std::lock_guard<std::mutex> lock(queue_mutex);
+				queue.pop_front();
+			}
+			queue_cond.notify_all();
+
+			delete frame;
+		}
+	}
+
+
+public:
+	/**
+	 * Enqueue physical data to be rendered to an image file.
+	 *
+	 * The data is copied, hence it can be modified after returning from this function.
+	 */
+	void push_frame(
+			const std::string &i_filename,
+			const double *i_data,
+			int i_width,
+			int i_height,
+			bool i_column_major = false
+	)
+	{
+		Frame *frame = new Frame;
+		frame->filename = i_filename;
+		frame->data.assign(i_data, i_data+(std::size_t)i_width*i_height);
+		frame->width = i_width;
+		frame->height = i_height;
+		frame->column_major = i_column_major;
+
+		std::unique_lock<std::mutex> lock(queue_mutex);
+
+		if (!worker_running)
+		{
+			worker_quit = false;
+			worker_thread = std::thread(&VisSweetImageWriter::p_worker, this);
+			worker_running = true;
+		}
+
+		queue_cond.wait(lock, [this]{ return queue.size() < max_queued_frames; });
+
+		queue.push_back(frame);
+		lock.unlock();
+
+		queue_cond.notify_all();
+	}
+
+
+	/**
+	 * Write all pending frames and stop the background thread
+	 */
+	void finish()
+	{
+		if (!worker_running)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(queue_mutex);
+			worker_quit = true;
+		}
+		queue_cond.notify_all();
+
+		worker_thread.join();
+		worker_running = false;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_VISSWEETIMAGEWRITER_HPP_ */
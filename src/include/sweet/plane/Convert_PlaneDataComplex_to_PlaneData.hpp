@@ -21,6 +21,7 @@ public:
 	)
 	{
 		PlaneData out(i_planeData.planeDataConfig);
+		out.physical_alloc_buffer();
 
 		i_planeData.request_data_physical();
 
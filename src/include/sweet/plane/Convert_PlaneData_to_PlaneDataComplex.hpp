@@ -21,6 +21,7 @@ public:
 	)
 	{
 		PlaneDataComplex out(i_planeData.planeDataConfig);
+		out.physical_alloc_buffer();
 
 		i_planeData.request_data_physical();
 
@@ -22,6 +22,7 @@ public:
 	)
 	{
 		PlaneData out(i_planeDataConfig);
+		out.physical_alloc_buffer();
 
 		for (std::size_t i = 0; i < out.planeDataConfig->physical_array_data_number_of_elements; i++)
 			out.physical_space_data[i] = i_scalarDataArray.scalar_data[i];
@@ -21,6 +21,7 @@
 #include <limits>
 #include <fstream>
 #include <iomanip>
+#include <vector>
 #include <iostream>
 #include <string.h>
 #include <sweet/sweetmath.hpp>
@@ -29,6 +30,7 @@
 #include <sweet/FatalError.hpp>
 
 #include <sweet/plane/PlaneDataConfig.hpp>
+#include <sweet/plane/PlaneDataFixedResolution.hpp>
 #include <sweet/plane/PlaneData_Kernels.hpp>
 
 
@@ -38,7 +40,7 @@
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 
 	#if SWEET_THREADING
-		#define PLANE_DATA_SPECTRAL_FOR_IDX(CORE)					\
+		#define PLANE_DATA_SPECTRAL_FOR_IDX_GENERIC(CORE)					\
 			_Pragma("omp parallel for proc_bind(spread)")			\
 			for (int r = 0; r < 2; r++)								\
 			{														\
@@ -55,7 +57,7 @@
 
 	#else
 
-		#define PLANE_DATA_SPECTRAL_FOR_IDX(CORE)					\
+		#define PLANE_DATA_SPECTRAL_FOR_IDX_GENERIC(CORE)					\
 			for (int r = 0; r < 2; r++)								\
 			{														\
 				for (std::size_t jj = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; jj < planeDataConfig->spectral_data_iteration_ranges[r][1][1]; jj++)		\
@@ -73,7 +75,7 @@
 
 
 #if SWEET_THREADING
-	#define PLANE_DATA_PHYSICAL_FOR_IDX(CORE)				\
+	#define PLANE_DATA_PHYSICAL_FOR_IDX_GENERIC(CORE)				\
 		_Pragma("omp parallel for OPENMP_PAR_SIMD proc_bind(close)")	\
 			for (std::size_t idx = 0; idx < planeDataConfig->physical_array_data_number_of_elements; idx++)	\
 			{	CORE;	}
@@ -98,7 +100,7 @@
 
 #else
 
-	#define PLANE_DATA_PHYSICAL_FOR_IDX(CORE)				\
+	#define PLANE_DATA_PHYSICAL_FOR_IDX_GENERIC(CORE)				\
 			for (std::size_t idx = 0; idx < planeDataConfig->physical_array_data_number_of_elements; idx++)	\
 			{	CORE;	}
 
@@ -116,6 +118,35 @@
 
 
 
+/*
+ * Use the loops specialized for the resolutions given at compile time,
+ * if available (see PlaneDataFixedResolution.hpp)
+ */
+#ifdef SWEET_PLANE_FIXED_RESOLUTIONS
+
+	#define PLANE_DATA_SPECTRAL_FOR_IDX(CORE)							\
+		{															\
+			auto core_fun = [&](std::size_t idx) { CORE };			\
+			if (!PlaneDataFixedResolutions::spectral_for_idx(planeDataConfig, core_fun))	\
+				PLANE_DATA_SPECTRAL_FOR_IDX_GENERIC(core_fun(idx);)		\
+		}
+
+	#define PLANE_DATA_PHYSICAL_FOR_IDX(CORE)							\
+		{															\
+			auto core_fun = [&](std::size_t idx) { CORE; };			\
+			if (!PlaneDataFixedResolutions::physical_for_idx(planeDataConfig, core_fun))	\
+				PLANE_DATA_PHYSICAL_FOR_IDX_GENERIC(core_fun(idx);)		\
+		}
+
+#else
+
+	#define PLANE_DATA_SPECTRAL_FOR_IDX(CORE)	PLANE_DATA_SPECTRAL_FOR_IDX_GENERIC(CORE)
+	#define PLANE_DATA_PHYSICAL_FOR_IDX(CORE)	PLANE_DATA_PHYSICAL_FOR_IDX_GENERIC(CORE)
+
+#endif
+
+
+
 /*
  * this option activates if data has to be allocated for the spectral space
  */
@@ -170,6 +201,9 @@ public:
 
 	/**
 	 * physical space data
+	 *
+	 * With spectral space support, the buffers of both representations
+	 * are allocated on first use, see physical_alloc_buffer() and spectral_alloc_buffer()
 	 */
 	double *physical_space_data;
 
@@ -189,10 +223,12 @@ public:
 	 */
 private:
 	PlaneData()	:
-		planeDataConfig(nullptr)
+		planeDataConfig(nullptr),
+		physical_space_data(nullptr)
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		,
 		physical_space_data_valid(false),
+		spectral_space_data(nullptr),
 		spectral_space_data_valid(false)
 #endif
 	{
@@ -203,10 +239,12 @@ private:
 	 */
 public:
 	PlaneData(int i)	:
-		planeDataConfig(nullptr)
+		planeDataConfig(nullptr),
+		physical_space_data(nullptr)
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		,
 		physical_space_data_valid(false),
+		spectral_space_data(nullptr),
 		spectral_space_data_valid(false)
 #endif
 	{
@@ -214,17 +252,76 @@ public:
 
 
 
-private:
-	void p_allocate_buffers()
+public:
+	/**
+	 * Allocate the buffer for the physical space data if this wasn't done so far.
+	 *
+	 * This has to be called before writing physical data directly to physical_space_data
+	 * without calling request_data_physical() before.
+	 */
+	inline
+	void physical_alloc_buffer()	const
 	{
-		physical_space_data = MemBlockAlloc::alloc<double>(
+		if (physical_space_data != nullptr)
+			return;
+
+		((PlaneData*)this)->physical_space_data = MemBlockAlloc::alloc<double>(
 				planeDataConfig->physical_array_data_number_of_elements*sizeof(double)
 		);
+	}
+
 
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
-		spectral_space_data = MemBlockAlloc::alloc< std::complex<double> >(
+	/**
+	 * Allocate the buffer for the spectral space data if this wasn't done so far,
+	 * see physical_alloc_buffer()
+	 */
+	inline
+	void spectral_alloc_buffer()	const
+	{
+		if (spectral_space_data != nullptr)
+			return;
+
+		((PlaneData*)this)->spectral_space_data = MemBlockAlloc::alloc< std::complex<double> >(
 				planeDataConfig->spectral_array_data_number_of_elements*sizeof(std::complex<double>)
 		);
+	}
+
+
+	/**
+	 * Return the buffers of invalid representations to the memory allocator
+	 */
+	void free_unused_buffers()	const
+	{
+		PlaneData *rw_array_data = (PlaneData*)this;
+
+		if (!physical_space_data_valid)
+		{
+			MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(double));
+			rw_array_data->physical_space_data = nullptr;
+		}
+
+		if (!spectral_space_data_valid)
+		{
+			MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_array_data_number_of_elements*sizeof(std::complex<double>));
+			rw_array_data->spectral_space_data = nullptr;
+		}
+	}
+#endif
+
+
+private:
+	void p_free_buffers()
+	{
+		if (planeDataConfig == nullptr)
+			return;
+
+		MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(double));
+		physical_space_data = nullptr;
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_array_data_number_of_elements*sizeof(std::complex<double>));
+		spectral_space_data = nullptr;
 #endif
 	}
 
@@ -239,20 +336,23 @@ public:
 	 */
 	PlaneData(
 			const PlaneData &i_dataArray
-	)
+	)	:
+		planeDataConfig(i_dataArray.planeDataConfig),
+		physical_space_data(nullptr)
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		,
+		spectral_space_data(nullptr)
+#endif
 	{
 		assert(i_dataArray.planeDataConfig != nullptr);
 
-		planeDataConfig = i_dataArray.planeDataConfig;
-
-		p_allocate_buffers();
-
-
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		physical_space_data_valid = i_dataArray.physical_space_data_valid;
 		if (physical_space_data_valid)
 #endif
 		{
+			physical_alloc_buffer();
+
 			PLANE_DATA_PHYSICAL_FOR_IDX(
 					physical_space_data[idx] = i_dataArray.physical_space_data[idx];
 			);
@@ -263,6 +363,8 @@ public:
 
 		if (spectral_space_data_valid)
 		{
+			spectral_alloc_buffer();
+
 			PLANE_DATA_SPECTRAL_FOR_IDX(
 					spectral_space_data[idx] = i_dataArray.spectral_space_data[idx];
 			);
@@ -285,9 +387,13 @@ public:
 			PlaneDataConfig *i_planeDataConfig
 	)
 	{
+		p_free_buffers();
+
 		planeDataConfig = i_planeDataConfig;
 
-		p_allocate_buffers();
+#if !SWEET_USE_PLANE_SPECTRAL_SPACE
+		physical_alloc_buffer();
+#endif
 	}
 
 
@@ -299,9 +405,11 @@ public:
 	PlaneData(
 		PlaneDataConfig *i_planeDataConfig
 	)	:
-		planeDataConfig(nullptr)
+		planeDataConfig(nullptr),
+		physical_space_data(nullptr)
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 		,physical_space_data_valid(false),
+		spectral_space_data(nullptr),
 		spectral_space_data_valid(false)
 #endif
 
@@ -314,11 +422,7 @@ public:
 public:
 	~PlaneData()
 	{
-		MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(double));
-
-#if SWEET_USE_PLANE_SPECTRAL_SPACE
-		MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_array_data_number_of_elements*sizeof(std::complex<double>));
-#endif
+		p_free_buffers();
 	}
 
 
@@ -334,6 +438,7 @@ public:
 		spectral_space_data_valid = false;
 #endif
 
+		physical_alloc_buffer();
 		physical_space_data[j*planeDataConfig->physical_data_size[0]+i] = i_value;
 	}
 
@@ -347,6 +452,8 @@ public:
 			request_data_physical();
 #endif
 
+		physical_alloc_buffer();
+
 		PLANE_DATA_PHYSICAL_FOR_2D_IDX(
 				i_lambda(i, j, physical_space_data[idx])
 		);
@@ -375,6 +482,8 @@ public:
 			double i_value
 	)
 	{
+		physical_alloc_buffer();
+
 		PLANE_DATA_PHYSICAL_FOR_IDX(
 				physical_space_data[idx] = i_value;
 		);
@@ -530,6 +639,8 @@ public:
 		physical_space_data_valid = false;
 		spectral_space_data_valid = true;
 
+		spectral_alloc_buffer();
+
 		std::size_t idx = (j*planeDataConfig->spectral_data_size[0])+i;
 		spectral_space_data[idx] = i_value;
 	}
@@ -543,6 +654,8 @@ public:
 			double i_value_im
 	)
 	{
+		spectral_alloc_buffer();
+
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				spectral_space_data[idx].real(i_value_re);
 				spectral_space_data[idx].imag(i_value_im);
@@ -552,6 +665,73 @@ public:
 		spectral_space_data_valid = true;
 	}
 
+
+
+	/**
+	 * Return data with a different number of modes / resolution.
+	 *
+	 * Modes which exist in both configurations are copied, all other ones are set to zero.
+	 * The Nyquist modes are dropped since they can't be represented uniquely.
+	 * Values in physical space are preserved, hence the spectral coefficients
+	 * are rescaled due to the unnormalized forward FFT.
+	 */
+	PlaneData spectral_returnWithDifferentModes(
+			PlaneDataConfig *i_planeDataConfig
+	)	const
+	{
+		PlaneData out(i_planeDataConfig);
+
+		if (	planeDataConfig->physical_res[0] == i_planeDataConfig->physical_res[0]	&&
+				planeDataConfig->physical_res[1] == i_planeDataConfig->physical_res[1]
+		)
+		{
+			out = *this;
+			return out;
+		}
+
+		request_data_spectral();
+		out.spectral_alloc_buffer();
+
+		double scale =	((double)i_planeDataConfig->physical_res[0]*(double)i_planeDataConfig->physical_res[1]) /
+						((double)planeDataConfig->physical_res[0]*(double)planeDataConfig->physical_res[1]);
+
+		// maximum wavenumbers (exclusive) which are available in both configurations
+		long max_kx = std::min(planeDataConfig->physical_res[0], i_planeDataConfig->physical_res[0])/2;
+		long max_ky = std::min(planeDataConfig->physical_res[1], i_planeDataConfig->physical_res[1])/2;
+
+		long dst_size_y = i_planeDataConfig->spectral_data_size[1];
+		long src_size_y = planeDataConfig->spectral_data_size[1];
+
+#if SWEET_THREADING
+#pragma omp parallel for
+#endif
+		for (long jj = 0; jj < dst_size_y; jj++)
+		{
+			std::complex<double> *dst = &out.spectral_space_data[jj*i_planeDataConfig->spectral_data_size[0]];
+
+			// negative wavenumbers are stored in the upper half
+			long ky = (jj <= dst_size_y/2 ? jj : jj-dst_size_y);
+
+			if (std::abs(ky) >= max_ky)
+			{
+				for (std::size_t ii = 0; ii < i_planeDataConfig->spectral_data_size[0]; ii++)
+					dst[ii] = 0;
+				continue;
+			}
+
+			long src_jj = (ky >= 0 ? ky : ky+src_size_y);
+			const std::complex<double> *src = &spectral_space_data[src_jj*planeDataConfig->spectral_data_size[0]];
+
+			for (std::size_t ii = 0; ii < i_planeDataConfig->spectral_data_size[0]; ii++)
+				dst[ii] = ((long)ii < max_kx ? src[ii]*scale : 0);
+		}
+
+		out.physical_space_data_valid = false;
+		out.spectral_space_data_valid = true;
+
+		return out;
+	}
+
 #endif
 
 
@@ -584,11 +764,18 @@ public:
 			FatalError("Spectral data not available! Is this maybe a non-initialized operator?");
 #endif
 
-		planeDataConfig->fft_physical_to_spectral(rw_array_data->physical_space_data, rw_array_data->spectral_space_data);
+		spectral_alloc_buffer();
+
+		// nothing to transform if no data was written so far
+		if (physical_space_data != nullptr)
+			planeDataConfig->fft_physical_to_spectral(rw_array_data->physical_space_data, rw_array_data->spectral_space_data);
 
 		rw_array_data->spectral_space_data_valid = true;
 		rw_array_data->physical_space_data_valid = false;
 
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			free_unused_buffers();
+
 #endif
 	}
 
@@ -603,19 +790,155 @@ public:
 
 		PlaneData *rw_array_data = (PlaneData*)this;
 
-#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
-		spectral_zeroAliasingModes();
-#endif
-
 #if SWEET_DEBUG
 		if (!spectral_space_data_valid)
 			FatalError("Physical data not available and no spectral data!");
 #endif
 
-		planeDataConfig->fft_spectral_to_physical(rw_array_data->spectral_space_data, rw_array_data->physical_space_data);
+		physical_alloc_buffer();
+
+		// nothing to transform if no data was written so far
+		if (spectral_space_data != nullptr)
+		{
+#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
+			spectral_zeroAliasingModes();
+#endif
+
+			planeDataConfig->fft_spectral_to_physical(rw_array_data->spectral_space_data, rw_array_data->physical_space_data);
+		}
 
 		rw_array_data->spectral_space_data_valid = false;
 		rw_array_data->physical_space_data_valid = true;
+
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			free_unused_buffers();
+#endif
+	}
+
+
+
+	/**
+	 * Make the spectral data of several arrays available.
+	 *
+	 * The arrays are transformed with a single FFTW call, see
+	 * PlaneDataConfig::fft_physical_to_spectral_batch().
+	 * All arrays have to share the same PlaneDataConfig.
+	 */
+	static
+	void request_data_spectral_batch(
+			PlaneData * const *io_arrays,
+			std::size_t i_num_arrays
+	)
+	{
+#if !SWEET_USE_PLANE_SPECTRAL_SPACE
+
+		FatalError("request_data_spectral_batch: spectral space is disabled");
+
+#else
+
+		std::vector<double*> physical_data;
+		std::vector<std::complex<double>*> spectral_data;
+
+		PlaneDataConfig *config = nullptr;
+
+		for (std::size_t n = 0; n < i_num_arrays; n++)
+		{
+			PlaneData &d = *io_arrays[n];
+
+			if (d.spectral_space_data_valid)
+				continue;
+
+			if (config == nullptr)
+				config = d.planeDataConfig;
+			else if (config != d.planeDataConfig)
+				FatalError("request_data_spectral_batch: different PlaneDataConfig");
+
+#if SWEET_DEBUG
+			if (!d.physical_space_data_valid)
+				FatalError("Spectral data not available! Is this maybe a non-initialized operator?");
+#endif
+
+			d.spectral_alloc_buffer();
+
+			if (d.physical_space_data != nullptr)
+			{
+				physical_data.push_back(d.physical_space_data);
+				spectral_data.push_back(d.spectral_space_data);
+			}
+
+			d.spectral_space_data_valid = true;
+			d.physical_space_data_valid = false;
+		}
+
+		if (physical_data.size() > 0)
+			config->fft_physical_to_spectral_batch(physical_data.size(), physical_data.data(), spectral_data.data());
+
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			for (std::size_t n = 0; n < i_num_arrays; n++)
+				io_arrays[n]->free_unused_buffers();
+
+#endif
+	}
+
+
+
+	/**
+	 * Make the physical data of several arrays available,
+	 * see request_data_spectral_batch()
+	 */
+	static
+	void request_data_physical_batch(
+			PlaneData * const *io_arrays,
+			std::size_t i_num_arrays
+	)
+	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+
+		std::vector<std::complex<double>*> spectral_data;
+		std::vector<double*> physical_data;
+
+		PlaneDataConfig *config = nullptr;
+
+		for (std::size_t n = 0; n < i_num_arrays; n++)
+		{
+			PlaneData &d = *io_arrays[n];
+
+			if (d.physical_space_data_valid)
+				continue;
+
+			if (config == nullptr)
+				config = d.planeDataConfig;
+			else if (config != d.planeDataConfig)
+				FatalError("request_data_physical_batch: different PlaneDataConfig");
+
+#if SWEET_DEBUG
+			if (!d.spectral_space_data_valid)
+				FatalError("Physical data not available and no spectral data!");
+#endif
+
+			d.physical_alloc_buffer();
+
+			if (d.spectral_space_data != nullptr)
+			{
+#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
+				d.spectral_zeroAliasingModes();
+#endif
+
+				spectral_data.push_back(d.spectral_space_data);
+				physical_data.push_back(d.physical_space_data);
+			}
+
+			d.spectral_space_data_valid = false;
+			d.physical_space_data_valid = true;
+		}
+
+		if (spectral_data.size() > 0)
+			config->fft_spectral_to_physical_batch(spectral_data.size(), spectral_data.data(), physical_data.data());
+
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			for (std::size_t n = 0; n < i_num_arrays; n++)
+				io_arrays[n]->free_unused_buffers();
+
 #endif
 	}
 
@@ -627,6 +950,7 @@ public:
 		request_data_physical();
 
 		PlaneData out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 		PLANE_DATA_PHYSICAL_FOR_IDX(
 				out.physical_space_data[idx] = (physical_space_data[idx] > 0 ? 1 : 0);
@@ -646,6 +970,7 @@ public:
 		request_data_physical();
 
 		PlaneData out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 		PLANE_DATA_PHYSICAL_FOR_IDX(
 				out.physical_space_data[idx] = (physical_space_data[idx] > 0 ? physical_space_data[idx] : 0);
@@ -664,6 +989,7 @@ public:
 		request_data_physical();
 
 		PlaneData out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 		PLANE_DATA_PHYSICAL_FOR_IDX(
 				out.physical_space_data[idx] = (physical_space_data[idx] < 0 ? 1 : 0);
@@ -682,6 +1008,7 @@ public:
 		request_data_physical();
 
 		PlaneData out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 		PLANE_DATA_PHYSICAL_FOR_IDX(
 				out.physical_space_data[idx] = (physical_space_data[idx] < 0 ? physical_space_data[idx] : 0);
@@ -973,6 +1300,8 @@ public:
 			double i_scale = 1.0
 	)
 	{
+		physical_alloc_buffer();
+
 		((PlaneData_Kernels&)*this).kernel_stencil_setup(
 				i_kernel_array,
 				i_scale,
@@ -986,6 +1315,9 @@ public:
 		spectral_space_data_valid = false;
 
 		request_data_spectral();
+
+		// operators are only applied in spectral space
+		free_unused_buffers();
 #endif
 	}
 
@@ -1010,6 +1342,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 
@@ -1085,6 +1418,8 @@ public:
 			physical_space_data_valid = true;
 #endif
 
+			physical_alloc_buffer();
+
 			PLANE_DATA_PHYSICAL_FOR_IDX(
 					physical_space_data[idx] = i_dataArray.physical_space_data[idx];
 			);
@@ -1100,6 +1435,8 @@ public:
 		{
 			spectral_space_data_valid = true;
 
+			spectral_alloc_buffer();
+
 			PLANE_DATA_SPECTRAL_FOR_IDX(
 					spectral_space_data[idx] = i_dataArray.spectral_space_data[idx];
 				);
@@ -1128,6 +1465,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx]*i_array_data.spectral_space_data[idx];
@@ -1155,6 +1493,41 @@ public:
 
 
 
+	/**
+	 * Apply two linear operators (e.g. diff_c_x and diff_c_y) to the same input data array.
+	 *
+	 * Without spectral space, both stencils are applied in a single sweep over the input data.
+	 */
+	static
+	void apply_fused(
+			const PlaneData &i_op_a,		///< first linear operator
+			const PlaneData &i_op_b,		///< second linear operator
+			const PlaneData &i_array_data,	///< input data
+			PlaneData &o_a,					///< result of first operator
+			PlaneData &o_b					///< result of second operator
+	)
+	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		o_a = i_op_a(i_array_data);
+		o_b = i_op_b(i_array_data);
+#else
+		PlaneData &rw_array_data = (PlaneData&)i_array_data;
+
+		((const PlaneData_Kernels&)i_op_a).kernel_apply_fused(
+				(const PlaneData_Kernels&)i_op_b,
+
+				i_array_data.planeDataConfig->physical_data_size[0],
+				i_array_data.planeDataConfig->physical_data_size[1],
+				rw_array_data.physical_space_data,
+
+				o_a.physical_space_data,
+				o_b.physical_space_data
+			);
+#endif
+	}
+
+
+
 	/**
 	 * Compute element-wise addition
 	 */
@@ -1171,6 +1544,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] + i_array_data.spectral_space_data[idx];
@@ -1413,6 +1787,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 			out.spectral_space_data[idx] = spectral_space_data[idx] - i_array_data.spectral_space_data[idx];
@@ -1484,6 +1859,7 @@ public:
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = -spectral_space_data[idx];
@@ -1521,6 +1897,7 @@ public:
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = -spectral_space_data[idx];
@@ -1553,6 +1930,7 @@ public:
 	)	const
 	{
 		PlaneData out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 #if SWEET_USE_PLANE_SPECTRAL_DEALIASING
@@ -1596,6 +1974,7 @@ public:
 	)	const
 	{
 		PlaneData out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 #if SWEET_USE_PLANE_SPECTRAL_DEALIASING
@@ -1644,6 +2023,7 @@ public:
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx]*i_value;
@@ -1676,6 +2056,7 @@ public:
 #if SWEET_USE_PLANE_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] / i_value;
@@ -1711,6 +2092,7 @@ public:
 		PlaneData out(planeDataConfig);
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] + i_value;
@@ -1732,6 +2114,7 @@ public:
 		PlaneData out(planeDataConfig);
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = 1.0/spectral_space_data[idx];
@@ -1945,6 +2328,85 @@ public:
 
 
 
+	/**
+	 * Return the number of pages of the physical data on each NUMA node
+	 * to verify the placement of the data, see MemBlockAlloc::getNumaPlacement()
+	 */
+	std::vector<std::size_t> get_physical_numa_placement()	const
+	{
+		if (physical_space_data == nullptr)
+			return std::vector<std::size_t>();
+
+		return MemBlockAlloc::getNumaPlacement(
+				physical_space_data,
+				planeDataConfig->physical_array_data_number_of_elements*sizeof(double)
+			);
+	}
+
+
+
+	/**
+	 * Write raw data for checkpointing to a binary stream.
+	 *
+	 * The spectral coefficients are stored if they are valid.
+	 * The physical data is only stored additionally if it is valid as well,
+	 * hence the restored data is bitwise identical.
+	 */
+	void file_checkpoint_write(
+			std::ostream &o_ostream
+	)	const
+	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		int flags = (spectral_space_data_valid ? 1 : 0) | (physical_space_data_valid ? 2 : 0);
+#else
+		int flags = 2;
+#endif
+		o_ostream.write((const char*)&flags, sizeof(flags));
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		if (spectral_space_data_valid)
+			o_ostream.write((const char*)spectral_space_data, sizeof(std::complex<double>)*planeDataConfig->spectral_array_data_number_of_elements);
+
+		if (physical_space_data_valid)
+#endif
+			o_ostream.write((const char*)physical_space_data, sizeof(double)*planeDataConfig->physical_array_data_number_of_elements);
+	}
+
+
+
+	/**
+	 * Read data written with file_checkpoint_write()
+	 */
+	void file_checkpoint_read(
+			std::istream &i_istream
+	)
+	{
+		int flags;
+		i_istream.read((char*)&flags, sizeof(flags));
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		spectral_space_data_valid = (flags & 1);
+		physical_space_data_valid = (flags & 2);
+
+		if (spectral_space_data_valid)
+		{
+			spectral_alloc_buffer();
+			i_istream.read((char*)spectral_space_data, sizeof(std::complex<double>)*planeDataConfig->spectral_array_data_number_of_elements);
+		}
+
+		if (physical_space_data_valid)
+#else
+		if (flags != 2)
+			FatalError("Checkpoint contains spectral data, but spectral space is disabled");
+#endif
+		{
+			physical_alloc_buffer();
+			i_istream.read((char*)physical_space_data, sizeof(double)*planeDataConfig->physical_array_data_number_of_elements);
+		}
+	}
+
+
+
 	/**
 	 * Load data from ASCII file.
 	 * This is a non-bullet proof implementation, so be careful for invalid file formats.
@@ -1982,6 +2444,8 @@ public:
 				FatalError("EXIT");
 			}
 
+			physical_alloc_buffer();
+
 			if (!file.read((char*)physical_space_data, expected_size))
 			{
 				std::cerr << "Error while loading data from file " << i_filename << std::endl;
@@ -26,6 +26,7 @@
 #include <sweet/FatalError.hpp>
 
 #include <sweet/plane/PlaneDataConfig.hpp>
+#include <sweet/plane/PlaneDataFixedResolution.hpp>
 
 
 #if !SWEET_USE_LIBFFT
@@ -42,7 +43,7 @@
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 	#if SWEET_THREADING
-		#define PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(CORE)					\
+		#define PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX_GENERIC(CORE)					\
 			_Pragma("omp parallel for proc_bind(spread)")			\
 			for (int r = 0; r < 4; r++)								\
 			{														\
@@ -59,7 +60,7 @@
 
 	#else
 
-		#define PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(CORE)					\
+		#define PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX_GENERIC(CORE)					\
 			for (int r = 0; r < 4; r++)								\
 			{														\
 				for (std::size_t jj = planeDataConfig->spectral_complex_data_iteration_ranges[r][1][0]; jj < planeDataConfig->spectral_complex_data_iteration_ranges[r][1][1]; jj++)		\
@@ -77,7 +78,7 @@
 
 
 #if SWEET_THREADING
-	#define PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(CORE)				\
+	#define PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX_GENERIC(CORE)				\
 		_Pragma("omp parallel for OPENMP_PAR_SIMD proc_bind(close)")	\
 			for (std::size_t idx = 0; idx < planeDataConfig->physical_array_data_number_of_elements; idx++)	\
 			{	CORE;	}
@@ -95,7 +96,7 @@
 
 #else
 
-	#define PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(CORE)				\
+	#define PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX_GENERIC(CORE)				\
 			for (std::size_t idx = 0; idx < planeDataConfig->physical_array_data_number_of_elements; idx++)	\
 			{	{CORE};	}
 
@@ -113,6 +114,35 @@
 
 
 
+/*
+ * Use the loops specialized for the resolutions given at compile time,
+ * if available (see PlaneDataFixedResolution.hpp)
+ */
+#ifdef SWEET_PLANE_FIXED_RESOLUTIONS
+
+	#define PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(CORE)							\
+		{															\
+			auto core_fun = [&](std::size_t idx) { CORE };			\
+			if (!PlaneDataFixedResolutions::spectral_complex_for_idx(planeDataConfig, core_fun))	\
+				PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX_GENERIC(core_fun(idx);)		\
+		}
+
+	#define PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(CORE)							\
+		{															\
+			auto core_fun = [&](std::size_t idx) { CORE; };			\
+			if (!PlaneDataFixedResolutions::physical_for_idx(planeDataConfig, core_fun))	\
+				PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX_GENERIC(core_fun(idx);)		\
+		}
+
+#else
+
+	#define PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(CORE)	PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX_GENERIC(CORE)
+	#define PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(CORE)	PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX_GENERIC(CORE)
+
+#endif
+
+
+
 /*
  * this option activates if data has to be allocated for the spectral space
  */
@@ -163,6 +193,9 @@ public:
 
 	/**
 	 * physical space data
+	 *
+	 * With spectral space support, the buffers of both representations
+	 * are allocated on first use, see physical_alloc_buffer() and spectral_alloc_buffer()
 	 */
 	std::complex<double> *physical_space_data;
 
@@ -183,10 +216,12 @@ public:
 // TODO: search for ways to make this private again
 public:
 	PlaneDataComplex()	:
-		planeDataConfig(nullptr)
+		planeDataConfig(nullptr),
+		physical_space_data(nullptr)
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 		,
 		physical_space_data_valid(false),
+		spectral_space_data(nullptr),
 		spectral_space_data_valid(false)
 #endif
 	{
@@ -194,17 +229,76 @@ public:
 
 
 
-private:
-	void p_allocate_buffers()
+public:
+	/**
+	 * Allocate the buffer for the physical space data if this wasn't done so far.
+	 *
+	 * This has to be called before writing physical data directly to physical_space_data
+	 * without calling request_data_physical() before.
+	 */
+	inline
+	void physical_alloc_buffer()	const
 	{
-		physical_space_data = MemBlockAlloc::alloc< std::complex<double> >(
+		if (physical_space_data != nullptr)
+			return;
+
+		((PlaneDataComplex*)this)->physical_space_data = MemBlockAlloc::alloc< std::complex<double> >(
 				planeDataConfig->physical_array_data_number_of_elements*sizeof(std::complex<double>)
 		);
+	}
+
 
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
-		spectral_space_data = MemBlockAlloc::alloc< std::complex<double> >(
+	/**
+	 * Allocate the buffer for the spectral space data if this wasn't done so far,
+	 * see physical_alloc_buffer()
+	 */
+	inline
+	void spectral_alloc_buffer()	const
+	{
+		if (spectral_space_data != nullptr)
+			return;
+
+		((PlaneDataComplex*)this)->spectral_space_data = MemBlockAlloc::alloc< std::complex<double> >(
 				planeDataConfig->spectral_complex_array_data_number_of_elements*sizeof(std::complex<double>)
 		);
+	}
+
+
+	/**
+	 * Return the buffers of invalid representations to the memory allocator
+	 */
+	void free_unused_buffers()	const
+	{
+		PlaneDataComplex *rw_array_data = (PlaneDataComplex*)this;
+
+		if (!physical_space_data_valid)
+		{
+			MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(std::complex<double>));
+			rw_array_data->physical_space_data = nullptr;
+		}
+
+		if (!spectral_space_data_valid)
+		{
+			MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_complex_array_data_number_of_elements*sizeof(std::complex<double>));
+			rw_array_data->spectral_space_data = nullptr;
+		}
+	}
+#endif
+
+
+private:
+	void p_free_buffers()
+	{
+		if (planeDataConfig == nullptr)
+			return;
+
+		MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(std::complex<double>));
+		physical_space_data = nullptr;
+
+#if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
+		MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_complex_array_data_number_of_elements*sizeof(std::complex<double>));
+		spectral_space_data = nullptr;
 #endif
 	}
 
@@ -219,20 +313,23 @@ public:
 	 */
 	PlaneDataComplex(
 			const PlaneDataComplex &i_dataArray
-	)
+	)	:
+		planeDataConfig(i_dataArray.planeDataConfig),
+		physical_space_data(nullptr)
+#if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
+		,
+		spectral_space_data(nullptr)
+#endif
 	{
 		assert(i_dataArray.planeDataConfig != nullptr);
 
-		planeDataConfig = i_dataArray.planeDataConfig;
-
-		p_allocate_buffers();
-
-
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 		physical_space_data_valid = i_dataArray.physical_space_data_valid;
 		if (physical_space_data_valid)
 #endif
 		{
+			physical_alloc_buffer();
+
 			PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(
 					physical_space_data[idx] = i_dataArray.physical_space_data[idx];
 			);
@@ -243,6 +340,8 @@ public:
 
 		if (spectral_space_data_valid)
 		{
+			spectral_alloc_buffer();
+
 			PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 					spectral_space_data[idx] = i_dataArray.spectral_space_data[idx];
 			);
@@ -264,9 +363,13 @@ public:
 			PlaneDataConfig *i_planeDataConfig
 	)
 	{
+		p_free_buffers();
+
 		planeDataConfig = i_planeDataConfig;
 
-		p_allocate_buffers();
+#if !SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
+		physical_alloc_buffer();
+#endif
 	}
 
 
@@ -278,9 +381,11 @@ public:
 	PlaneDataComplex(
 		PlaneDataConfig *i_planeDataConfig
 	)	:
-		planeDataConfig(nullptr)
+		planeDataConfig(nullptr),
+		physical_space_data(nullptr)
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 		,physical_space_data_valid(false),
+		spectral_space_data(nullptr),
 		spectral_space_data_valid(false)
 #endif
 
@@ -293,11 +398,7 @@ public:
 public:
 	~PlaneDataComplex()
 	{
-		MemBlockAlloc::free(physical_space_data, planeDataConfig->physical_array_data_number_of_elements*sizeof(double));
-
-#if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
-		MemBlockAlloc::free(spectral_space_data, planeDataConfig->spectral_complex_array_data_number_of_elements*sizeof(std::complex<double>));
-#endif
+		p_free_buffers();
 	}
 
 
@@ -314,6 +415,7 @@ public:
 		spectral_space_data_valid = false;
 #endif
 
+		physical_alloc_buffer();
 		physical_space_data[j*planeDataConfig->physical_data_size[0]+i] = i_value;
 	}
 
@@ -332,6 +434,7 @@ public:
 		spectral_space_data_valid = false;
 #endif
 
+		physical_alloc_buffer();
 		physical_space_data[j*planeDataConfig->physical_data_size[0]+i].real(i_real);
 		physical_space_data[j*planeDataConfig->physical_data_size[0]+i].imag(i_imag);
 	}
@@ -378,6 +481,8 @@ public:
 			double i_real
 	)
 	{
+		physical_alloc_buffer();
+
 		PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(
 				physical_space_data[idx] = i_real;
 		);
@@ -396,6 +501,8 @@ public:
 			double i_imag
 	)
 	{
+		physical_alloc_buffer();
+
 		PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(
 				physical_space_data[idx].real(i_real);
 				physical_space_data[idx].imag(i_imag);
@@ -507,6 +614,7 @@ public:
 		physical_space_data_valid = false;
 		spectral_space_data_valid = true;
 
+		spectral_alloc_buffer();
 		spectral_space_data[(j*planeDataConfig->spectral_complex_data_size[0])+i] = i_value;
 	}
 
@@ -523,6 +631,8 @@ public:
 		physical_space_data_valid = false;
 		spectral_space_data_valid = true;
 
+		spectral_alloc_buffer();
+
 		std::size_t idx = (j*planeDataConfig->spectral_complex_data_size[0])+i;
 		spectral_space_data[idx].real(i_real);
 		spectral_space_data[idx].imag(i_imag);
@@ -537,6 +647,8 @@ public:
 			double i_value_im
 	)
 	{
+		spectral_alloc_buffer();
+
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				spectral_space_data[idx].real(i_value_re);
 				spectral_space_data[idx].imag(i_value_im);
@@ -578,11 +690,18 @@ public:
 			FatalError("Spectral data not available! Is this maybe a non-initialized operator?");
 #endif
 
-		planeDataConfig->fft_complex_physical_to_spectral(rw_array_data->physical_space_data, rw_array_data->spectral_space_data);
+		spectral_alloc_buffer();
+
+		// nothing to transform if no data was written so far
+		if (physical_space_data != nullptr)
+			planeDataConfig->fft_complex_physical_to_spectral(rw_array_data->physical_space_data, rw_array_data->spectral_space_data);
 
 		rw_array_data->spectral_space_data_valid = true;
 		rw_array_data->physical_space_data_valid = false;
 
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			free_unused_buffers();
+
 #endif
 	}
 
@@ -597,19 +716,28 @@ public:
 
 		PlaneDataComplex *rw_array_data = (PlaneDataComplex*)this;
 
-#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
-		spectral_zeroAliasingModes();
-#endif
-
 #if SWEET_DEBUG
 		if (!spectral_space_data_valid)
 			FatalError("Physical data not available and no spectral data!");
 #endif
 
-		planeDataConfig->fft_spectral_to_complex_physical(rw_array_data->spectral_space_data, rw_array_data->physical_space_data);
+		physical_alloc_buffer();
+
+		// nothing to transform if no data was written so far
+		if (spectral_space_data != nullptr)
+		{
+#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
+			spectral_zeroAliasingModes();
+#endif
+
+			planeDataConfig->fft_spectral_to_complex_physical(rw_array_data->spectral_space_data, rw_array_data->physical_space_data);
+		}
 
 		rw_array_data->spectral_space_data_valid = false;
 		rw_array_data->physical_space_data_valid = true;
+
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			free_unused_buffers();
 #endif
 	}
 
@@ -961,6 +1089,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		for (std::size_t idx = 0; idx < planeDataConfig->spectral_complex_array_data_number_of_elements; idx++)
 		{
@@ -995,6 +1124,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 					out.spectral_space_data[idx] = spectral_space_data[idx] * i_array_data.spectral_space_data[idx];
@@ -1053,6 +1183,8 @@ public:
 			physical_space_data_valid = true;
 #endif
 
+			physical_alloc_buffer();
+
 			PLANE_DATA_COMPLEX_PHYSICAL_FOR_IDX(
 					physical_space_data[idx] = i_dataArray.physical_space_data[idx];
 			);
@@ -1068,6 +1200,8 @@ public:
 		{
 			spectral_space_data_valid = true;
 
+			spectral_alloc_buffer();
+
 			PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 					spectral_space_data[idx] = i_dataArray.spectral_space_data[idx];
 				);
@@ -1097,6 +1231,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx]*i_array_data.spectral_space_data[idx];
@@ -1140,6 +1275,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] + i_array_data.spectral_space_data[idx];
@@ -1513,6 +1649,7 @@ public:
 
 		request_data_spectral();
 		rw_array_data.request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 			out.spectral_space_data[idx] = spectral_space_data[idx] - i_array_data.spectral_space_data[idx];
@@ -1618,6 +1755,7 @@ public:
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = -spectral_space_data[idx];
@@ -1657,6 +1795,7 @@ public:
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = -spectral_space_data[idx];
@@ -1694,6 +1833,7 @@ public:
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = -spectral_space_data[idx];
@@ -1726,6 +1866,7 @@ public:
 	)	const
 	{
 		PlaneDataComplex out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 #if SWEET_USE_PLANE_SPECTRAL_DEALIASING
@@ -1768,6 +1909,7 @@ public:
 	)	const
 	{
 		PlaneDataComplex out(planeDataConfig);
+		out.physical_alloc_buffer();
 
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 #if SWEET_USE_PLANE_SPECTRAL_DEALIASING
@@ -1815,6 +1957,7 @@ public:
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx]*i_value;
@@ -1847,6 +1990,7 @@ public:
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx]*i_value;
@@ -1879,6 +2023,7 @@ public:
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] / i_value;
@@ -1913,6 +2058,7 @@ public:
 #if SWEET_USE_PLANE_COMPLEX_SPECTRAL_SPACE
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] / i_value;
@@ -1949,6 +2095,7 @@ public:
 		PlaneDataComplex out(planeDataConfig);
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] + i_value;
@@ -1971,6 +2118,7 @@ public:
 	{
 		request_data_spectral();
 		PlaneDataComplex out(planeDataConfig);
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] + i_value;
@@ -1993,6 +2141,7 @@ public:
 		PlaneDataComplex out(planeDataConfig);
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = spectral_space_data[idx] - i_value;
@@ -2014,6 +2163,7 @@ public:
 		PlaneDataComplex out(planeDataConfig);
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(
 				out.spectral_space_data[idx] = 1.0/spectral_space_data[idx];
@@ -2263,6 +2413,8 @@ public:
 				FatalError("EXIT");
 			}
 
+			physical_alloc_buffer();
+
 			if (!file.read((char*)physical_space_data, expected_size))
 			{
 				std::cerr << "Error while loading data from file " << i_filename << std::endl;
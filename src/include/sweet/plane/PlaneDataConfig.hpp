@@ -17,6 +17,7 @@
 
 #include <fftw3.h>
 #include <iostream>
+#include <map>
 #include <stdlib.h>
 #include <iostream>
 #include <sweet/sweetmath.hpp>
@@ -107,6 +108,22 @@ private:
 	fftw_plan	fftw_plan_forward;
 	fftw_plan	fftw_plan_backward;
 
+	/// plans to transform several arrays with a single FFTW call
+	class BatchPlans
+	{
+	public:
+		fftw_plan forward;
+		fftw_plan backward;
+	};
+
+	/// batch plans for each number of arrays,
+	/// created on the first batched transformation
+	std::map<std::size_t, BatchPlans> fftw_plans_batch;
+
+	/// planner flags of setup_internal_data() for the batch plans
+	bool fftw_wisdom_loaded;
+	int fftw_estimate_plan;
+
 	/// FFTW scaling related stuff for backward transformation
 	/// WARNING: FFTW doesn't implement a symmetric FFTW
 	/// We only to the rescaling for the backward transformation
@@ -133,6 +150,12 @@ public:
 
 	bool initialized;
 
+	/**
+	 * Number of threads used for the FFTW plans of this config.
+	 * Values <= 0 use omp_get_max_threads()
+	 */
+	int num_fftw_threads;
+
 
 	std::string getUniqueIDString()
 	{
@@ -214,11 +237,24 @@ public:
 	}
 
 
+public:
+	/**
+	 * Set to true by the PlaneDataConfigRegistry while it holds its lock.
+	 * Plans can then be created and destroyed inside parallel regions.
+	 */
+	static
+	bool& serializedSetupRef()
+	{
+		static thread_local bool serialized_setup = false;
+		return serialized_setup;
+	}
+
+
 public:
 	int& refCounterFftwPlans()
 	{
 #if SWEET_THREADING
-		if (omp_get_level() != 0)
+		if (omp_get_level() != 0 && !serializedSetupRef())
 			FatalError("PlaneDataConfig is not threadsafe, but called inside parallel region with more than one thread!!!");
 #endif
 
@@ -238,6 +274,7 @@ public:
 #endif
 
 		initialized = false;
+		num_fftw_threads = -1;
 	}
 
 
@@ -295,8 +332,10 @@ private:
 		{
 			// initialise FFTW with spatial parallelization
 			fftw_init_threads();
-			fftw_plan_with_nthreads(omp_get_max_threads());
 		}
+
+		// only affects plans which are created afterwards
+		fftw_plan_with_nthreads(num_fftw_threads > 0 ? num_fftw_threads : omp_get_max_threads());
 	#endif
 
 #endif
@@ -306,9 +345,10 @@ private:
 		 * Load existing wisdom
 		 */
 		bool wisdom_loaded = loadWisdom();
+		fftw_wisdom_loaded = wisdom_loaded;
 
 
-		int fftw_estimate_plan = 0;
+		fftw_estimate_plan = 0;
 		const char* fftw_estimate_plan_env = getenv("SWEET_FFTW_ESTIMATE");
 		if (fftw_estimate_plan_env != nullptr)
 		{
@@ -600,6 +640,199 @@ private:
 
 
 
+private:
+	/**
+	 * Return the plans to transform i_num_arrays arrays with a single call.
+	 *
+	 * The arrays are stored one after the other (fftw_plan_many_dft_*).
+	 * Plans are only created on the first batched transformation with
+	 * this number of arrays since most programs never use them.
+	 * There might be no wisdom for these plans, hence we fall back to estimated plans.
+	 */
+	BatchPlans p_get_batch_plans(
+			std::size_t i_num_arrays
+	)
+	{
+		BatchPlans plans;
+
+#if SWEET_THREADING
+#pragma omp critical (PlaneDataConfigRegistry)
+#endif
+		{
+			std::map<std::size_t, BatchPlans>::iterator iter = fftw_plans_batch.find(i_num_arrays);
+
+			if (iter != fftw_plans_batch.end())
+			{
+				plans = iter->second;
+			}
+			else
+			{
+				int n[2] = {(int)physical_res[1], (int)physical_res[0]};
+				int howmany = (int)i_num_arrays;
+				int physical_dist = (int)physical_array_data_number_of_elements;
+				int spectral_dist = (int)spectral_array_data_number_of_elements;
+
+				double *data_physical = MemBlockAlloc::alloc<double>(i_num_arrays*physical_array_data_number_of_elements*sizeof(double));
+				std::complex<double> *data_spectral = MemBlockAlloc::alloc< std::complex<double> >(i_num_arrays*spectral_array_data_number_of_elements*sizeof(std::complex<double>));
+
+				plans.backward =
+						fftw_plan_many_dft_c2r(
+							2, n, howmany,
+							(fftw_complex*)data_spectral, nullptr, 1, spectral_dist,
+							data_physical, nullptr, 1, physical_dist,
+							(!fftw_wisdom_loaded ? fftw_estimate_plan : FFTW_WISDOM_ONLY)
+						);
+
+				if (plans.backward == nullptr)
+					plans.backward =
+							fftw_plan_many_dft_c2r(
+								2, n, howmany,
+								(fftw_complex*)data_spectral, nullptr, 1, spectral_dist,
+								data_physical, nullptr, 1, physical_dist,
+								FFTW_ESTIMATE
+							);
+
+				plans.forward =
+						fftw_plan_many_dft_r2c(
+							2, n, howmany,
+							data_physical, nullptr, 1, physical_dist,
+							(fftw_complex*)data_spectral, nullptr, 1, spectral_dist,
+							(!fftw_wisdom_loaded ? fftw_estimate_plan : FFTW_WISDOM_ONLY)
+						);
+
+				if (plans.forward == nullptr)
+					plans.forward =
+							fftw_plan_many_dft_r2c(
+								2, n, howmany,
+								data_physical, nullptr, 1, physical_dist,
+								(fftw_complex*)data_spectral, nullptr, 1, spectral_dist,
+								FFTW_ESTIMATE
+							);
+
+				if (plans.forward == nullptr || plans.backward == nullptr)
+				{
+					std::cerr << "Failed to create batch plans for fftw" << std::endl;
+					std::cerr << "batch of " << i_num_arrays << " arrays " << physical_res[0] << " x " << physical_res[1] << std::endl;
+					exit(-1);
+				}
+
+				MemBlockAlloc::free(data_physical, i_num_arrays*physical_array_data_number_of_elements*sizeof(double));
+				MemBlockAlloc::free(data_spectral, i_num_arrays*spectral_array_data_number_of_elements*sizeof(std::complex<double>));
+
+				fftw_plans_batch[i_num_arrays] = plans;
+			}
+		}
+
+		return plans;
+	}
+
+
+public:
+	/**
+	 * Transform several arrays to spectral space with a single FFTW call.
+	 *
+	 * The arrays are gathered in one buffer which is transformed
+	 * with a plan for all arrays. This utilizes the cores better
+	 * than a sequence of threaded transformations for small resolutions.
+	 */
+	void fft_physical_to_spectral_batch(
+			std::size_t i_num_arrays,
+			double * const *i_physical_data,
+			std::complex<double> * const *o_spectral_data
+	)
+	{
+		BatchPlans plans = p_get_batch_plans(i_num_arrays);
+
+		std::size_t np = physical_array_data_number_of_elements;
+		std::size_t ns = spectral_array_data_number_of_elements;
+
+		// buffers are allocated for each call since the config might be shared by several threads
+		double *batch_physical = MemBlockAlloc::alloc<double>(i_num_arrays*np*sizeof(double));
+		std::complex<double> *batch_spectral = MemBlockAlloc::alloc< std::complex<double> >(i_num_arrays*ns*sizeof(std::complex<double>));
+
+		for (std::size_t n = 0; n < i_num_arrays; n++)
+		{
+			double *src = i_physical_data[n];
+			double *dst = batch_physical + n*np;
+
+#if SWEET_THREADING
+#pragma omp parallel for OPENMP_PAR_SIMD
+#endif
+			for (std::size_t i = 0; i < np; i++)
+				dst[i] = src[i];
+		}
+
+		fftw_execute_dft_r2c(plans.forward, batch_physical, (fftw_complex*)batch_spectral);
+
+		for (std::size_t n = 0; n < i_num_arrays; n++)
+		{
+			std::complex<double> *src = batch_spectral + n*ns;
+			std::complex<double> *dst = o_spectral_data[n];
+
+#if SWEET_THREADING
+#pragma omp parallel for OPENMP_PAR_SIMD
+#endif
+			for (std::size_t i = 0; i < ns; i++)
+				dst[i] = src[i];
+		}
+
+		MemBlockAlloc::free(batch_physical, i_num_arrays*np*sizeof(double));
+		MemBlockAlloc::free(batch_spectral, i_num_arrays*ns*sizeof(std::complex<double>));
+	}
+
+
+
+	/**
+	 * Transform several arrays to physical space with a single FFTW call,
+	 * see fft_physical_to_spectral_batch()
+	 */
+	void fft_spectral_to_physical_batch(
+			std::size_t i_num_arrays,
+			std::complex<double> * const *i_spectral_data,
+			double * const *o_physical_data
+	)
+	{
+		BatchPlans plans = p_get_batch_plans(i_num_arrays);
+
+		std::size_t np = physical_array_data_number_of_elements;
+		std::size_t ns = spectral_array_data_number_of_elements;
+
+		double *batch_physical = MemBlockAlloc::alloc<double>(i_num_arrays*np*sizeof(double));
+		std::complex<double> *batch_spectral = MemBlockAlloc::alloc< std::complex<double> >(i_num_arrays*ns*sizeof(std::complex<double>));
+
+		for (std::size_t n = 0; n < i_num_arrays; n++)
+		{
+			std::complex<double> *src = i_spectral_data[n];
+			std::complex<double> *dst = batch_spectral + n*ns;
+
+#if SWEET_THREADING
+#pragma omp parallel for OPENMP_PAR_SIMD
+#endif
+			for (std::size_t i = 0; i < ns; i++)
+				dst[i] = src[i];
+		}
+
+		fftw_execute_dft_c2r(plans.backward, (fftw_complex*)batch_spectral, batch_physical);
+
+		// scaling is done while copying the data back
+		for (std::size_t n = 0; n < i_num_arrays; n++)
+		{
+			double *src = batch_physical + n*np;
+			double *dst = o_physical_data[n];
+
+#if SWEET_THREADING
+#pragma omp parallel for OPENMP_PAR_SIMD
+#endif
+			for (std::size_t i = 0; i < np; i++)
+				dst[i] = src[i]*fftw_backward_scale_factor;
+		}
+
+		MemBlockAlloc::free(batch_physical, i_num_arrays*np*sizeof(double));
+		MemBlockAlloc::free(batch_spectral, i_num_arrays*ns*sizeof(std::complex<double>));
+	}
+
+
+
 	void fft_complex_physical_to_spectral(
 			std::complex<double> *i_physical_data,
 			std::complex<double> *o_spectral_data
@@ -838,6 +1071,13 @@ public:
 			fftw_destroy_plan(fftw_plan_forward);
 			fftw_destroy_plan(fftw_plan_backward);
 
+			for (std::map<std::size_t, BatchPlans>::iterator iter = fftw_plans_batch.begin(); iter != fftw_plans_batch.end(); iter++)
+			{
+				fftw_destroy_plan(iter->second.forward);
+				fftw_destroy_plan(iter->second.backward);
+			}
+			fftw_plans_batch.clear();
+
 			fftw_destroy_plan(fftw_plan_complex_forward);
 			fftw_destroy_plan(fftw_plan_complex_backward);
 
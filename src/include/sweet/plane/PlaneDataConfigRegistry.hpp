@@ -0,0 +1,302 @@
+/*
+ * PlaneDataConfigRegistry.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEDATACONFIGREGISTRY_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEDATACONFIGREGISTRY_HPP_
+
+#include <vector>
+#include <cassert>
+#include <sweet/FatalError.hpp>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/plane/PlaneDataConfig.hpp>
+
+
+
+/**
+ * Process-wide registry of PlaneDataConfig instances.
+ *
+ * Configs are created on demand and shared by all solver instances and threads
+ * which request the same (resolution, modes, number of FFTW threads).
+ * This avoids creating identical FFTW plans several times.
+ *
+ * Creation and destruction of configs are serialized within a named critical
+ * region, hence this can be also used inside parallel regions.
+ */
+class PlaneDataConfigRegistry
+{
+	class Entry
+	{
+	public:
+		/// requested physical resolution, <= 0 for automatic
+		int physical_res[2];
+
+		/// requested spectral modes, <= 0 for automatic
+		int spectral_modes[2];
+
+		/// number of threads for FFTW plans, <= 0 for default
+		int num_threads;
+
+		PlaneDataConfig *planeDataConfig;
+
+		int ref_counter;
+	};
+
+	std::vector<Entry> entries;
+
+
+public:
+	static
+	PlaneDataConfigRegistry& getSingletonRef()
+	{
+		static PlaneDataConfigRegistry registry;
+		return registry;
+	}
+
+
+private:
+	/**
+	 * Test whether the entry matches the requested parameters.
+	 *
+	 * Either the requested key is identical, or all parameters are given
+	 * explicitly and match the resolution of the existing config.
+	 */
+	static
+	bool p_matches(
+			const Entry &i_entry,
+			int i_physical_res_x,
+			int i_physical_res_y,
+			int i_spectral_modes_x,
+			int i_spectral_modes_y,
+			int i_num_threads
+	)
+	{
+		if (i_entry.num_threads != i_num_threads)
+			return false;
+
+		if (	i_entry.physical_res[0] == i_physical_res_x	&&
+				i_entry.physical_res[1] == i_physical_res_y	&&
+				i_entry.spectral_modes[0] == i_spectral_modes_x	&&
+				i_entry.spectral_modes[1] == i_spectral_modes_y
+		)
+			return true;
+
+		if (	i_physical_res_x <= 0 || i_physical_res_y <= 0	||
+				i_spectral_modes_x <= 0 || i_spectral_modes_y <= 0
+		)
+			return false;
+
+		const PlaneDataConfig *c = i_entry.planeDataConfig;
+
+		if (	(int)c->physical_res[0] != i_physical_res_x	||
+				(int)c->physical_res[1] != i_physical_res_y
+		)
+			return false;
+
+#if SWEET_USE_LIBFFT
+		if (	(int)c->spectral_modes[0] != i_spectral_modes_x	||
+				(int)c->spectral_modes[1] != i_spectral_modes_y
+		)
+			return false;
+#endif
+
+		return true;
+	}
+
+
+
+	static
+	PlaneDataConfig* p_createConfig(
+			int i_physical_res_x,
+			int i_physical_res_y,
+			int i_spectral_modes_x,
+			int i_spectral_modes_y,
+			int i_num_threads
+	)
+	{
+		PlaneDataConfig *c = new PlaneDataConfig;
+		c->num_fftw_threads = i_num_threads;
+
+		if (i_physical_res_x > 0 && i_spectral_modes_x > 0)
+		{
+			c->setup(i_physical_res_x, i_physical_res_y, i_spectral_modes_x, i_spectral_modes_y);
+		}
+		else if (i_physical_res_x > 0)
+		{
+			c->setupAutoSpectralSpace(i_physical_res_x, i_physical_res_y);
+		}
+		else if (i_spectral_modes_x > 0)
+		{
+#if SWEET_USE_LIBFFT
+			c->setupAutoPhysicalSpace(i_spectral_modes_x, i_spectral_modes_y);
+#else
+			FatalError("Setup with spectral modes not enabled");
+#endif
+		}
+		else
+		{
+			FatalError("No resolution/modes selected");
+		}
+
+		return c;
+	}
+
+
+
+public:
+	/**
+	 * Return a shared config for the given resolution.
+	 *
+	 * Set the physical resolution or the spectral modes to 0 to determine
+	 * them automatically, see PlaneDataConfig::setupAuto().
+	 *
+	 * Each call has to be matched by a call to releaseConfig()
+	 */
+	static
+	PlaneDataConfig* getConfig(
+			int i_physical_res_x,
+			int i_physical_res_y,
+			int i_spectral_modes_x,
+			int i_spectral_modes_y,
+			int i_num_threads = -1
+	)
+	{
+		PlaneDataConfigRegistry &r = getSingletonRef();
+		PlaneDataConfig *retval = nullptr;
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp critical (PlaneDataConfigRegistry)
+#endif
+		{
+			for (auto &e : r.entries)
+			{
+				if (!p_matches(e, i_physical_res_x, i_physical_res_y, i_spectral_modes_x, i_spectral_modes_y, i_num_threads))
+					continue;
+
+				e.ref_counter++;
+				retval = e.planeDataConfig;
+				break;
+			}
+
+			if (retval == nullptr)
+			{
+				PlaneDataConfig::serializedSetupRef() = true;
+
+				Entry e;
+				e.physical_res[0] = i_physical_res_x;
+				e.physical_res[1] = i_physical_res_y;
+				e.spectral_modes[0] = i_spectral_modes_x;
+				e.spectral_modes[1] = i_spectral_modes_y;
+				e.num_threads = i_num_threads;
+				e.planeDataConfig = p_createConfig(i_physical_res_x, i_physical_res_y, i_spectral_modes_x, i_spectral_modes_y, i_num_threads);
+				e.ref_counter = 1;
+
+				r.entries.push_back(e);
+				retval = e.planeDataConfig;
+
+				PlaneDataConfig::serializedSetupRef() = false;
+			}
+		}
+
+		return retval;
+	}
+
+
+
+#if SWEET_USE_LIBFFT
+	/**
+	 * Return a shared config with additional modes compared to the given one,
+	 * see PlaneDataConfig::setupAdditionalModes()
+	 */
+	static
+	PlaneDataConfig* getConfigAdditionalModes(
+			const PlaneDataConfig *i_planeDataConfig,
+			int i_additional_modes_x,
+			int i_additional_modes_y,
+			int i_num_threads = -1
+	)
+	{
+		return getConfig(
+				0,
+				0,
+				i_planeDataConfig->spectral_modes[0] + i_additional_modes_x,
+				i_planeDataConfig->spectral_modes[1] + i_additional_modes_y,
+				i_num_threads
+			);
+	}
+#endif
+
+
+
+	/**
+	 * Release a config which was returned by getConfig().
+	 * The config and its plans are freed if it is not used anymore.
+	 */
+	static
+	void releaseConfig(
+			PlaneDataConfig *i_planeDataConfig
+	)
+	{
+		if (i_planeDataConfig == nullptr)
+			return;
+
+		PlaneDataConfigRegistry &r = getSingletonRef();
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp critical (PlaneDataConfigRegistry)
+#endif
+		{
+			bool found = false;
+			for (std::size_t i = 0; i < r.entries.size(); i++)
+			{
+				Entry &e = r.entries[i];
+				if (e.planeDataConfig != i_planeDataConfig)
+					continue;
+
+				found = true;
+				e.ref_counter--;
+				assert(e.ref_counter >= 0);
+
+				if (e.ref_counter == 0)
+				{
+					PlaneDataConfig::serializedSetupRef() = true;
+					delete e.planeDataConfig;
+					PlaneDataConfig::serializedSetupRef() = false;
+
+					r.entries.erase(r.entries.begin()+i);
+				}
+				break;
+			}
+
+			if (!found)
+				FatalError("PlaneDataConfig was not created by PlaneDataConfigRegistry");
+		}
+	}
+
+
+
+	/**
+	 * Return the number of configs which are currently alive
+	 */
+	static
+	std::size_t getNumberOfConfigs()
+	{
+		return getSingletonRef().entries.size();
+	}
+
+
+
+	~PlaneDataConfigRegistry()
+	{
+		for (auto &e : entries)
+			delete e.planeDataConfig;
+
+		entries.clear();
+	}
+};
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEDATACONFIGREGISTRY_HPP_ */
@@ -0,0 +1,213 @@
+/*
+ * PlaneDataFixedResolution.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEDATAFIXEDRESOLUTION_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEDATAFIXEDRESOLUTION_HPP_
+
+#include <cstddef>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/plane/PlaneDataConfig.hpp>
+
+
+/*
+ * Loops over plane data specialized for resolutions which are known at compile time.
+ *
+ * The resolutions are given as a list of pairs of the physical resolution, e.g.
+ *
+ * 	-DSWEET_PLANE_FIXED_RESOLUTIONS=128,128,256,256
+ *
+ * (see the --plane-fixed-resolutions option of SConstruct).
+ *
+ * The loops in PlaneData and PlaneDataComplex are then dispatched at runtime
+ * to the specialized loops with compile-time trip counts if the resolution
+ * of the PlaneDataConfig matches one of these resolutions.
+ * Otherwise, the generic loops with the sizes of the PlaneDataConfig are used.
+ */
+template <std::size_t N0, std::size_t N1>
+class PlaneDataFixedResolution
+{
+public:
+	static constexpr std::size_t physical_size = N0*N1;
+
+	/*
+	 * Real-to-complex storage representation,
+	 * see PlaneDataConfig::setup_internal_data()
+	 */
+	static constexpr std::size_t spectral_size0 = N0/2+1;
+	static constexpr std::size_t spectral_size1 = N1;
+
+#if SWEET_USE_PLANE_SPECTRAL_DEALIASING
+	static constexpr std::size_t spectral_range_i_end = 2*(spectral_size0-1)/3+1;
+	static constexpr std::size_t spectral_range0_j_end = spectral_size1/3+1;
+	static constexpr std::size_t spectral_range1_j_start = spectral_size1-spectral_size1/3;
+#else
+	static constexpr std::size_t spectral_range_i_end = spectral_size0;
+	static constexpr std::size_t spectral_range0_j_end = spectral_size1/2;
+	static constexpr std::size_t spectral_range1_j_start = spectral_size1/2;
+#endif
+
+	/// number of rows in both spectral iteration ranges
+	static constexpr std::size_t spectral_num_rows = spectral_range0_j_end + (spectral_size1-spectral_range1_j_start);
+
+
+	static
+	bool match(
+			const PlaneDataConfig *i_planeDataConfig
+	)
+	{
+		return	i_planeDataConfig->physical_data_size[0] == N0 &&
+				i_planeDataConfig->physical_data_size[1] == N1;
+	}
+
+
+	template <typename T_Fun>
+	static
+	void physical_for_idx(
+			T_Fun &i_fun
+	)
+	{
+#if SWEET_THREADING
+#pragma omp parallel for OPENMP_PAR_SIMD proc_bind(close)
+#endif
+		for (std::size_t idx = 0; idx < physical_size; idx++)
+			i_fun(idx);
+	}
+
+
+	/**
+	 * Iterate over both spectral iteration ranges within a single loop
+	 */
+	template <typename T_Fun>
+	static
+	void spectral_for_idx(
+			T_Fun &i_fun
+	)
+	{
+#if SWEET_THREADING
+#pragma omp parallel for OPENMP_PAR_SIMD proc_bind(close) collapse(2)
+#endif
+		for (std::size_t r = 0; r < spectral_num_rows; r++)
+		{
+			for (std::size_t ii = 0; ii < spectral_range_i_end; ii++)
+			{
+				std::size_t jj = (r < spectral_range0_j_end ? r : r - spectral_range0_j_end + spectral_range1_j_start);
+				i_fun(jj*spectral_size0 + ii);
+			}
+		}
+	}
+
+
+	/**
+	 * The complex spectral iteration ranges cover the entire array
+	 */
+	template <typename T_Fun>
+	static
+	void spectral_complex_for_idx(
+			T_Fun &i_fun
+	)
+	{
+		physical_for_idx(i_fun);
+	}
+};
+
+
+
+/**
+ * Runtime dispatcher to the specialized loops
+ *
+ * Each function returns false if there's no specialization
+ * for the resolution of the given config.
+ */
+template <std::size_t... R>
+class PlaneDataFixedResolutionDispatcher;
+
+
+template <>
+class PlaneDataFixedResolutionDispatcher<>
+{
+public:
+	template <typename T_Fun>
+	static
+	bool physical_for_idx(const PlaneDataConfig*, T_Fun&)
+	{
+		return false;
+	}
+
+	template <typename T_Fun>
+	static
+	bool spectral_for_idx(const PlaneDataConfig*, T_Fun&)
+	{
+		return false;
+	}
+
+	template <typename T_Fun>
+	static
+	bool spectral_complex_for_idx(const PlaneDataConfig*, T_Fun&)
+	{
+		return false;
+	}
+};
+
+
+template <std::size_t N0, std::size_t N1, std::size_t... R>
+class PlaneDataFixedResolutionDispatcher<N0, N1, R...>
+{
+	typedef PlaneDataFixedResolution<N0, N1> Res;
+	typedef PlaneDataFixedResolutionDispatcher<R...> Next;
+
+public:
+	template <typename T_Fun>
+	static
+	bool physical_for_idx(
+			const PlaneDataConfig *i_planeDataConfig,
+			T_Fun &i_fun
+	)
+	{
+		if (!Res::match(i_planeDataConfig))
+			return Next::physical_for_idx(i_planeDataConfig, i_fun);
+
+		Res::physical_for_idx(i_fun);
+		return true;
+	}
+
+	template <typename T_Fun>
+	static
+	bool spectral_for_idx(
+			const PlaneDataConfig *i_planeDataConfig,
+			T_Fun &i_fun
+	)
+	{
+		if (!Res::match(i_planeDataConfig))
+			return Next::spectral_for_idx(i_planeDataConfig, i_fun);
+
+		Res::spectral_for_idx(i_fun);
+		return true;
+	}
+
+	template <typename T_Fun>
+	static
+	bool spectral_complex_for_idx(
+			const PlaneDataConfig *i_planeDataConfig,
+			T_Fun &i_fun
+	)
+	{
+		if (!Res::match(i_planeDataConfig))
+			return Next::spectral_complex_for_idx(i_planeDataConfig, i_fun);
+
+		Res::spectral_complex_for_idx(i_fun);
+		return true;
+	}
+};
+
+
+
+#ifdef SWEET_PLANE_FIXED_RESOLUTIONS
+typedef PlaneDataFixedResolutionDispatcher<SWEET_PLANE_FIXED_RESOLUTIONS> PlaneDataFixedResolutions;
+#endif
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEDATAFIXEDRESOLUTION_HPP_ */
@@ -0,0 +1,611 @@
+/*
+ * PlaneDataHelmholtzMultigrid.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEDATAHELMHOLTZMULTIGRID_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEDATAHELMHOLTZMULTIGRID_HPP_
+
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataConfig.hpp>
+#include <sweet/FatalError.hpp>
+
+
+/**
+ * Matrix-free geometric multigrid solver for the real-valued Helmholtz problem
+ *
+ * 	(kappa - gh0*D2) X = B
+ *
+ * on the doubly periodic plane, with D2 being the 5-point finite-difference Laplacian.
+ * This is the same discretization as the one of the Laplace operator
+ * of PlaneOperators without spectral space.
+ *
+ * The hierarchy of grids and all temporary arrays are allocated once in setup(),
+ * hence the solver can be kept over the whole simulation and only kappa and gh0
+ * (e.g. depending on the time step size) are provided for each solve.
+ *
+ * Features:
+ *  - vertex-centered coarsening by a factor of 2 with full weighting restriction
+ *    and bilinear prolongation,
+ *  - red-black Gauss-Seidel or Jacobi-preconditioned Chebyshev smoothers
+ *    which are applied without assembling any matrix,
+ *  - full multigrid (FMG) startup followed by V-cycles.
+ */
+class PlaneDataHelmholtzMultigrid
+{
+public:
+	enum SmootherType
+	{
+		SMOOTHER_RED_BLACK_GAUSS_SEIDEL = 0,
+		SMOOTHER_CHEBYSHEV = 1
+	};
+
+
+	/**
+	 * Configuration of each level of the hierarchy
+	 */
+	class LevelConfig
+	{
+	public:
+		SmootherType smoother = SMOOTHER_RED_BLACK_GAUSS_SEIDEL;
+
+		// number of smoothing iterations before and after the coarse grid correction
+		int pre_smoothing = 2;
+		int post_smoothing = 2;
+	};
+
+
+private:
+	class Level
+	{
+	public:
+		int nx, ny;
+
+		// 1/h^2 in each dimension
+		double inv_hx2, inv_hy2;
+
+		// solution (or correction on coarse levels), right hand side, residual and search direction (Chebyshev)
+		std::vector<double> x, b, r, d;
+
+		LevelConfig config;
+	};
+
+	std::vector<Level> levels;
+
+	// parameters of current solve
+	double kappa;
+	double gh0;
+
+
+public:
+	/**
+	 * Number of smoothing iterations on the coarsest level
+	 */
+	int coarse_smoothing_iterations = 64;
+
+	/**
+	 * Use full multigrid to compute the initial guess.
+	 * Otherwise, the data of io_x given to solve() is used.
+	 */
+	bool use_fmg = true;
+
+	/**
+	 * Statistics of the last solve
+	 */
+	int last_num_vcycles = 0;
+	double last_residual_rms = 0;
+
+
+	PlaneDataHelmholtzMultigrid()	:
+		kappa(0),
+		gh0(0)
+	{
+	}
+
+
+	/**
+	 * Setup the hierarchy of grids.
+	 *
+	 * The grid is coarsened as long as both resolutions are even
+	 * and not smaller than i_min_coarse_resolution.
+	 */
+	void setup(
+			PlaneDataConfig *i_planeDataConfig,
+			const double *i_domain_size,
+			SmootherType i_smoother = SMOOTHER_RED_BLACK_GAUSS_SEIDEL,
+			int i_min_coarse_resolution = 4		///< going to 2x2 results in an unstable solver
+	)
+	{
+		levels.clear();
+
+		int nx = i_planeDataConfig->physical_data_size[0];
+		int ny = i_planeDataConfig->physical_data_size[1];
+
+		while (true)
+		{
+			levels.emplace_back();
+			Level &l = levels.back();
+
+			l.nx = nx;
+			l.ny = ny;
+
+			double hx = i_domain_size[0]/(double)nx;
+			double hy = i_domain_size[1]/(double)ny;
+			l.inv_hx2 = 1.0/(hx*hx);
+			l.inv_hy2 = 1.0/(hy*hy);
+
+			std::size_t n = (std::size_t)nx*ny;
+			l.x.resize(n);
+			l.b.resize(n);
+			l.r.resize(n);
+
+			l.config.smoother = i_smoother;
+
+			if (nx % 2 != 0 || ny % 2 != 0 || nx/2 < i_min_coarse_resolution || ny/2 < i_min_coarse_resolution)
+				break;
+
+			nx /= 2;
+			ny /= 2;
+		}
+
+		for (auto &l : levels)
+		{
+			// red-black ordering requires an even number of grid points with periodic boundaries
+			if (l.nx % 2 != 0 || l.ny % 2 != 0)
+				l.config.smoother = SMOOTHER_CHEBYSHEV;
+
+			if (l.config.smoother == SMOOTHER_CHEBYSHEV)
+				l.d.resize(l.x.size());
+		}
+	}
+
+
+	int getNumLevels()	const
+	{
+		return levels.size();
+	}
+
+
+	/**
+	 * Change the configuration of a level, level 0 is the finest one
+	 */
+	void setLevelConfig(
+			int i_level,
+			const LevelConfig &i_config
+	)
+	{
+		Level &l = levels.at(i_level);
+		l.config = i_config;
+
+		if (l.nx % 2 != 0 || l.ny % 2 != 0)
+			l.config.smoother = SMOOTHER_CHEBYSHEV;
+
+		if (l.config.smoother == SMOOTHER_CHEBYSHEV)
+			l.d.resize(l.x.size());
+	}
+
+
+
+private:
+	/**
+	 * r = b - (kappa - gh0*D2) x
+	 */
+	void p_residual(
+			Level &l
+	)
+	{
+		const int nx = l.nx;
+		const int ny = l.ny;
+		const double cx = gh0*l.inv_hx2;
+		const double cy = gh0*l.inv_hy2;
+		const double cd = kappa + 2.0*cx + 2.0*cy;
+
+		const double *x = l.x.data();
+		const double *b = l.b.data();
+		double *r = l.r.data();
+
+#if SWEET_THREADING
+#	pragma omp parallel for schedule(static)
+#endif
+		for (int j = 0; j < ny; j++)
+		{
+			const double *xc = x + (std::size_t)j*nx;
+			const double *xs = x + (std::size_t)(j == 0 ? ny-1 : j-1)*nx;
+			const double *xn = x + (std::size_t)(j == ny-1 ? 0 : j+1)*nx;
+			const double *bc = b + (std::size_t)j*nx;
+			double *rc = r + (std::size_t)j*nx;
+
+			rc[0] = bc[0] - (cd*xc[0] - cx*(xc[nx-1]+xc[1]) - cy*(xs[0]+xn[0]));
+
+#if SWEET_SIMD_ENABLE
+#	pragma omp simd
+#endif
+			for (int i = 1; i < nx-1; i++)
+				rc[i] = bc[i] - (cd*xc[i] - cx*(xc[i-1]+xc[i+1]) - cy*(xs[i]+xn[i]));
+
+			rc[nx-1] = bc[nx-1] - (cd*xc[nx-1] - cx*(xc[nx-2]+xc[0]) - cy*(xs[nx-1]+xn[nx-1]));
+		}
+	}
+
+
+	double p_rms(
+			const std::vector<double> &i_data
+	)
+	{
+		double sum = 0;
+
+#if SWEET_THREADING
+#	pragma omp parallel for schedule(static) reduction(+:sum)
+#endif
+		for (std::size_t i = 0; i < i_data.size(); i++)
+			sum += i_data[i]*i_data[i];
+
+		return std::sqrt(sum/(double)i_data.size());
+	}
+
+
+	/**
+	 * Red-black Gauss-Seidel iterations.
+	 *
+	 * All points of one color only depend on points of the other color,
+	 * hence each half-sweep is fully parallel and each row can be vectorized.
+	 */
+	void p_smooth_red_black_gauss_seidel(
+			Level &l,
+			int i_iterations
+	)
+	{
+		const int nx = l.nx;
+		const int ny = l.ny;
+		const double cx = gh0*l.inv_hx2;
+		const double cy = gh0*l.inv_hy2;
+		const double inv_cd = 1.0/(kappa + 2.0*cx + 2.0*cy);
+
+		double *x = l.x.data();
+		const double *b = l.b.data();
+
+		for (int it = 0; it < i_iterations; it++)
+		{
+			for (int color = 0; color < 2; color++)
+			{
+#if SWEET_THREADING
+#	pragma omp parallel for schedule(static)
+#endif
+				for (int j = 0; j < ny; j++)
+				{
+					double *xc = x + (std::size_t)j*nx;
+					const double *xs = x + (std::size_t)(j == 0 ? ny-1 : j-1)*nx;
+					const double *xn = x + (std::size_t)(j == ny-1 ? 0 : j+1)*nx;
+					const double *bc = b + (std::size_t)j*nx;
+
+					// first point of this color in this row
+					int i0 = (j+color) & 1;
+
+					if (i0 == 0)
+					{
+						xc[0] = (bc[0] + cx*(xc[nx-1]+xc[1]) + cy*(xs[0]+xn[0]))*inv_cd;
+						i0 = 2;
+					}
+
+#if SWEET_SIMD_ENABLE
+#	pragma omp simd
+#endif
+					for (int i = i0; i < nx-1; i += 2)
+						xc[i] = (bc[i] + cx*(xc[i-1]+xc[i+1]) + cy*(xs[i]+xn[i]))*inv_cd;
+
+					// nx is even, hence the last point has the color of i0 == 1
+					if (((j+color) & 1) == 1)
+						xc[nx-1] = (bc[nx-1] + cx*(xc[nx-2]+xc[0]) + cy*(xs[nx-1]+xn[nx-1]))*inv_cd;
+				}
+			}
+		}
+	}
+
+
+	/**
+	 * Chebyshev iterations preconditioned with the (constant) diagonal.
+	 *
+	 * The eigenvalues of D^{-1}A are in [kappa/cd, (kappa+4cx+4cy)/cd],
+	 * only the upper quarter of this spectrum (the high frequencies) is damped.
+	 */
+	void p_smooth_chebyshev(
+			Level &l,
+			int i_iterations
+	)
+	{
+		const double cx = gh0*l.inv_hx2;
+		const double cy = gh0*l.inv_hy2;
+		const double cd = kappa + 2.0*cx + 2.0*cy;
+		const double inv_cd = 1.0/cd;
+
+		double lambda_max = (kappa + 4.0*cx + 4.0*cy)*inv_cd;
+		double lambda_min = 0.25*lambda_max;
+
+		double theta = 0.5*(lambda_max+lambda_min);
+		double delta = 0.5*(lambda_max-lambda_min);
+		double sigma = theta/delta;
+		double rho = 1.0/sigma;
+
+		std::size_t n = l.x.size();
+		double *x = l.x.data();
+		double *r = l.r.data();
+		double *d = l.d.data();
+
+		p_residual(l);
+
+		double s = inv_cd/theta;
+#if SWEET_THREADING
+#	pragma omp parallel for OPENMP_PAR_SIMD
+#endif
+		for (std::size_t i = 0; i < n; i++)
+			d[i] = r[i]*s;
+
+		for (int it = 0; it < i_iterations; it++)
+		{
+#if SWEET_THREADING
+#	pragma omp parallel for OPENMP_PAR_SIMD
+#endif
+			for (std::size_t i = 0; i < n; i++)
+				x[i] += d[i];
+
+			if (it == i_iterations-1)
+				break;
+
+			p_residual(l);
+
+			double rho_new = 1.0/(2.0*sigma - rho);
+			double sd = rho_new*rho;
+			double sr = 2.0*rho_new/delta*inv_cd;
+
+#if SWEET_THREADING
+#	pragma omp parallel for OPENMP_PAR_SIMD
+#endif
+			for (std::size_t i = 0; i < n; i++)
+				d[i] = sd*d[i] + sr*r[i];
+
+			rho = rho_new;
+		}
+	}
+
+
+	void p_smooth(
+			Level &l,
+			int i_iterations
+	)
+	{
+		if (l.config.smoother == SMOOTHER_RED_BLACK_GAUSS_SEIDEL)
+			p_smooth_red_black_gauss_seidel(l, i_iterations);
+		else
+			p_smooth_chebyshev(l, i_iterations);
+	}
+
+
+	/**
+	 * Full weighting restriction of i_fine to o_coarse
+	 */
+	void p_restrict(
+			const Level &i_fine,
+			const std::vector<double> &i_fine_data,
+			Level &i_coarse,
+			std::vector<double> &o_coarse_data
+	)
+	{
+		const int fnx = i_fine.nx;
+		const int fny = i_fine.ny;
+		const int cnx = i_coarse.nx;
+		const int cny = i_coarse.ny;
+
+		const double *f = i_fine_data.data();
+		double *c = o_coarse_data.data();
+
+#if SWEET_THREADING
+#	pragma omp parallel for schedule(static)
+#endif
+		for (int J = 0; J < cny; J++)
+		{
+			int j = 2*J;
+			const double *fc = f + (std::size_t)j*fnx;
+			const double *fs = f + (std::size_t)(j == 0 ? fny-1 : j-1)*fnx;
+			const double *fn = f + (std::size_t)(j+1)*fnx;
+
+			for (int I = 0; I < cnx; I++)
+			{
+				int i = 2*I;
+				int im = (i == 0 ? fnx-1 : i-1);
+				int ip = i+1;
+
+				c[(std::size_t)J*cnx+I] = (1.0/16.0)*(
+						4.0*fc[i]
+						+ 2.0*(fc[im] + fc[ip] + fs[i] + fn[i])
+						+ fs[im] + fs[ip] + fn[im] + fn[ip]
+					);
+			}
+		}
+	}
+
+
+	/**
+	 * Bilinear interpolation of i_coarse.x added to io_fine.x
+	 */
+	void p_prolongate_add(
+			const Level &i_coarse,
+			Level &io_fine
+	)
+	{
+		const int fnx = io_fine.nx;
+		const int cnx = i_coarse.nx;
+		const int cny = i_coarse.ny;
+
+		const double *c = i_coarse.x.data();
+		double *f = io_fine.x.data();
+
+#if SWEET_THREADING
+#	pragma omp parallel for schedule(static)
+#endif
+		for (int J = 0; J < cny; J++)
+		{
+			const double *cc = c + (std::size_t)J*cnx;
+			const double *cn = c + (std::size_t)(J == cny-1 ? 0 : J+1)*cnx;
+
+			double *f0 = f + (std::size_t)(2*J)*fnx;
+			double *f1 = f + (std::size_t)(2*J+1)*fnx;
+
+			for (int I = 0; I < cnx; I++)
+			{
+				int Ip = (I == cnx-1 ? 0 : I+1);
+
+				f0[2*I] += cc[I];
+				f0[2*I+1] += 0.5*(cc[I] + cc[Ip]);
+				f1[2*I] += 0.5*(cc[I] + cn[I]);
+				f1[2*I+1] += 0.25*(cc[I] + cc[Ip] + cn[I] + cn[Ip]);
+			}
+		}
+	}
+
+
+	void p_vcycle(
+			int i_level
+	)
+	{
+		Level &l = levels[i_level];
+
+		if (i_level == (int)levels.size()-1)
+		{
+			p_smooth(l, coarse_smoothing_iterations);
+			return;
+		}
+
+		Level &c = levels[i_level+1];
+
+		p_smooth(l, l.config.pre_smoothing);
+
+		p_residual(l);
+		p_restrict(l, l.r, c, c.b);
+		std::fill(c.x.begin(), c.x.end(), 0.0);
+
+		p_vcycle(i_level+1);
+
+		p_prolongate_add(c, l);
+
+		p_smooth(l, l.config.post_smoothing);
+	}
+
+
+	/**
+	 * Full multigrid: solve on the coarsest level and use the
+	 * interpolated solution as initial guess for a V-cycle on the next finer level
+	 */
+	void p_fmg()
+	{
+		int num_levels = levels.size();
+
+		for (int i = 0; i < num_levels-1; i++)
+			p_restrict(levels[i], levels[i].b, levels[i+1], levels[i+1].b);
+
+		std::fill(levels.back().x.begin(), levels.back().x.end(), 0.0);
+		p_vcycle(num_levels-1);
+
+		for (int i = num_levels-2; i >= 0; i--)
+		{
+			std::fill(levels[i].x.begin(), levels[i].x.end(), 0.0);
+			p_prolongate_add(levels[i+1], levels[i]);
+			p_vcycle(i);
+		}
+	}
+
+
+
+public:
+	/**
+	 * Solve (kappa - gh0*D2) X = B
+	 *
+	 * \return true if the RMS of the residual dropped below
+	 * i_error_threshold times the RMS of the right hand side
+	 */
+	bool solve(
+			double i_kappa,
+			double i_gh0,
+			const PlaneData &i_rhs,
+			PlaneData &io_x,
+			double i_error_threshold = 1e-10,
+			int i_max_vcycles = 100,
+			int i_verbosity = 0
+	)
+	{
+		if (levels.size() == 0)
+			FatalError("PlaneDataHelmholtzMultigrid: setup() not called");
+
+		assert(i_kappa > 0);
+
+		kappa = i_kappa;
+		gh0 = i_gh0;
+
+		Level &l = levels[0];
+		std::size_t n = l.x.size();
+		assert(n == i_rhs.planeDataConfig->physical_array_data_number_of_elements);
+
+		i_rhs.request_data_physical();
+		std::copy(i_rhs.physical_space_data, i_rhs.physical_space_data+n, l.b.begin());
+
+		if (use_fmg)
+		{
+			p_fmg();
+			last_num_vcycles = 1;
+		}
+		else
+		{
+			io_x.request_data_physical();
+			std::copy(io_x.physical_space_data, io_x.physical_space_data+n, l.x.begin());
+			last_num_vcycles = 0;
+		}
+
+		double rhs_rms = p_rms(l.b);
+		bool converged = false;
+
+		while (true)
+		{
+			p_residual(l);
+			last_residual_rms = p_rms(l.r);
+
+			if (i_verbosity > 2)
+				std::cout << "MULTIGRID: V-cycle " << last_num_vcycles << ", residual RMS: " << last_residual_rms << std::endl;
+
+			if (last_residual_rms <= i_error_threshold*rhs_rms)
+			{
+				converged = true;
+				break;
+			}
+
+			if (last_num_vcycles >= i_max_vcycles)
+				break;
+
+			p_vcycle(0);
+			last_num_vcycles++;
+		}
+
+		io_x.physical_alloc_buffer();
+		std::copy(l.x.begin(), l.x.end(), io_x.physical_space_data);
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		io_x.physical_space_data_valid = true;
+		io_x.spectral_space_data_valid = false;
+#endif
+
+		if (i_verbosity > 1)
+			std::cout << "MULTIGRID: " << last_num_vcycles << " V-cycles, residual RMS: " << last_residual_rms << std::endl;
+
+		return converged;
+	}
+};
+
+
+
+#endif /* SRC_INCLUDE_SWEET_PLANE_PLANEDATAHELMHOLTZMULTIGRID_HPP_ */
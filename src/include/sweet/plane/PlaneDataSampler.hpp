@@ -118,6 +118,7 @@ public:
 		assert(i_pos_x.number_of_elements == o_data.planeDataConfig->physical_array_data_number_of_elements);
 
 		i_data.request_data_physical();
+		o_data.physical_alloc_buffer();
 
 		// iterate over all positions in parallel
 #pragma omp parallel for
@@ -418,6 +419,7 @@ public:
 		assert(i_pos_x.number_of_elements == o_data.planeDataConfig->physical_array_data_number_of_elements);
 
 		i_data.request_data_physical();
+		o_data.physical_alloc_buffer();
 
 		std::size_t size = i_pos_x.number_of_elements;
 
@@ -30,7 +30,17 @@ public:
 	)
 	{
 		if (RK_h_t != nullptr)	///< already allocated?
-			return;
+		{
+			/*
+			 * Reuse the buffers if they are sufficient for the requested order.
+			 * Otherwise, e.g. for a coarse RK1 followed by a fine RK4 time step
+			 * with the same object, they have to be reallocated.
+			 */
+			if (i_rk_order <= runge_kutta_order)
+				return;
+
+			cleanupBuffers();
+		}
 
 		runge_kutta_order = i_rk_order;
 		int N = i_rk_order;
@@ -52,7 +62,7 @@ public:
 
 
 
-	~PlaneDataTimesteppingRK()
+	void cleanupBuffers()
 	{
 		int N = runge_kutta_order;
 
@@ -73,6 +83,15 @@ public:
 			RK_u_t = nullptr;
 			RK_v_t = nullptr;
 		}
+
+		runge_kutta_order = -1;
+	}
+
+
+
+	~PlaneDataTimesteppingRK()
+	{
+		cleanupBuffers();
 	}
 
 
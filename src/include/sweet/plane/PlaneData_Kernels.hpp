@@ -8,6 +8,9 @@
 #ifndef SRC_INCLUDE_SWEET_PLANE_PLANEDATA_KERNELS_HPP_
 #define SRC_INCLUDE_SWEET_PLANE_PLANEDATA_KERNELS_HPP_
 
+#include <algorithm>
+#include <sweet/openmp_helper.hpp>
+
 
 class PlaneData_Kernels
 {
@@ -193,242 +196,255 @@ public:
 
 #if !SWEET_USE_PLANE_SPECTRAL_SPACE
 
-public:
-	void kernel_apply(
-			int res_x,
-			int res_y,
-			double *i_data,
+	/**
+	 * Tile sizes for the stencil application.
+	 *
+	 * The three input rows and the output row of a tile
+	 * (4*8 KByte with 1024 doubles) fit into the L1 cache.
+	 * Consecutive rows of a tile reuse two of the input rows.
+	 */
+	static const int kernel_tile_size_x = 1024;
+	static const int kernel_tile_size_y = 16;
+
+
+	/**
+	 * Apply 3x3 stencil to a single point with periodic boundaries.
+	 *
+	 * Only the stencil entries given by MASK are evaluated.
+	 */
+	template <int MASK>
+	inline
+	static
+	double p_kernel3x3_point(
+			const double *i_kernel,		///< 3x3 stencil
+			const double *i_row_m,		///< row y-1
+			const double *i_row_0,		///< row y
+			const double *i_row_p,		///< row y+1
+			int x_m,					///< x-1 (periodic)
+			int x,
+			int x_p						///< x+1 (periodic)
+	)
+	{
+		double v = 0;
+
+		if (MASK & (1 << 0))	v += i_kernel[0]*i_row_m[x_m];
+		if (MASK & (1 << 1))	v += i_kernel[1]*i_row_m[x];
+		if (MASK & (1 << 2))	v += i_kernel[2]*i_row_m[x_p];
+		if (MASK & (1 << 3))	v += i_kernel[3]*i_row_0[x_m];
+		if (MASK & (1 << 4))	v += i_kernel[4]*i_row_0[x];
+		if (MASK & (1 << 5))	v += i_kernel[5]*i_row_0[x_p];
+		if (MASK & (1 << 6))	v += i_kernel[6]*i_row_p[x_m];
+		if (MASK & (1 << 7))	v += i_kernel[7]*i_row_p[x];
+		if (MASK & (1 << 8))	v += i_kernel[8]*i_row_p[x_p];
+
+		return v;
+	}
 
-			double *o_data
-	)	const
+
+	/**
+	 * Apply 3x3 stencil to the points [i_x_start, i_x_end) of a row.
+	 *
+	 * The periodic boundary points are peeled off,
+	 * hence the inner loop is free of branches.
+	 */
+	template <int MASK>
+	static
+	void p_kernel3x3_row(
+			const double *i_kernel,		///< 3x3 stencil
+			const double *i_row_m,		///< row y-1
+			const double *i_row_0,		///< row y
+			const double *i_row_p,		///< row y+1
+			double *o_row,				///< output row y
+			int i_x_start,
+			int i_x_end,
+			int i_res_x
+	)
 	{
+		int x_start = i_x_start;
+		int x_end = i_x_end;
 
-		/**
-		 * TODO: optimize this!!!
-		 *
-		 *  - cache blocking
-		 *  - if branching elimination
-		 *  - etc.....
-		 */
+		if (x_start == 0)
+		{
+			o_row[0] = p_kernel3x3_point<MASK>(i_kernel, i_row_m, i_row_0, i_row_p, i_res_x-1, 0, (i_res_x > 1 ? 1 : 0));
+			x_start++;
+		}
 
-		if (kernel_size == 3)
+		if (x_end == i_res_x && x_end > x_start)
 		{
-			switch (kernel_id)
-			{
-			case get_kernel_mask3x3(0, 0, 0, 1, 0, 1, 0, 0, 0):	// (X, 0, X)
-#if SWEET_THREADING
-#pragma omp parallel for OPENMP_PAR_SIMD collapse(2)
+			o_row[i_res_x-1] = p_kernel3x3_point<MASK>(i_kernel, i_row_m, i_row_0, i_row_p, i_res_x-2, i_res_x-1, 0);
+			x_end--;
+		}
+
+#if SWEET_THREADING && SWEET_SIMD_ENABLE
+#pragma omp simd
 #endif
-				for (int y = 0; y < res_y; y++)
-				{
-					for (int x = 0; x < res_x; x++)
-					{
-						double &data_out = o_data[y*res_x+x];
-						data_out = 0;
-
-						int pos_y = y;
-						assert(pos_y >= 0 && pos_y < res_y);
-
-						if (x > 0 && x < res_x-1)
-						{
-							double *kernel_scalar_ptr = &kernel_data[3];
-							double *data_scalar_ptr = &i_data[pos_y*res_x+x-1];
-
-							data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-							data_out += kernel_scalar_ptr[2]*data_scalar_ptr[2];
-						}
-						else
-						{
-							for (int i = -1; i <= 1; i+=2)
-							{
-								int pos_x = x+i;
-								pos_x -= (pos_x >= res_x ? res_x : 0);
-								pos_x += (pos_x < 0 ? res_x : 0);
-								int idx = i+4;
-								double kernel_scalar = kernel_data[idx];
-								double data_scalar = i_data[pos_y*res_x+pos_x];
-
-								data_out += kernel_scalar*data_scalar;
-							}
-						}
-					}
-				}
-				break;
+		for (int x = x_start; x < x_end; x++)
+			o_row[x] = p_kernel3x3_point<MASK>(i_kernel, i_row_m, i_row_0, i_row_p, x-1, x, x+1);
+	}
 
 
+	typedef void (*kernel3x3_row_fun)(const double*, const double*, const double*, const double*, double*, int, int, int);
 
-			case get_kernel_mask3x3(0, 0, 0, 1, 1, 1, 0, 0, 0):	// (X, X, X)
-#if SWEET_THREADING
-#pragma omp parallel for OPENMP_PAR_SIMD collapse(2)
-#endif
-					for (int y = 0; y < res_y; y++)
-					{
-						for (int x = 0; x < res_x; x++)
-						{
-							double &data_out = o_data[y*res_x+x];
-							data_out = 0;
-
-							int pos_y = y+res_y;
-							pos_y -= (pos_y >= res_y ? res_y : 0);
-							pos_y += (pos_y < 0 ? res_y : 0);
-
-							assert(pos_y >= 0 && pos_y < res_y);
-
-							if (x > 0 && x < res_x-1)
-							{
-								double *kernel_scalar_ptr = &kernel_data[3];
-								double *data_scalar_ptr = &i_data[pos_y*res_x+x-1];
-
-								data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-								data_out += kernel_scalar_ptr[1]*data_scalar_ptr[1];
-								data_out += kernel_scalar_ptr[2]*data_scalar_ptr[2];
-							}
-							else
-							{
-								for (int i = -1; i <= 1; i++)
-								{
-									int pos_x = (x+i);
-									pos_x -= (pos_x >= res_x ? res_x : 0);
-									pos_x += (pos_x < 0 ? res_x : 0);
-									int idx = i+4;
-									double kernel_scalar = kernel_data[idx];
-									double data_scalar = i_data[pos_y*res_x+pos_x];
-
-									data_out += kernel_scalar*data_scalar;
-								}
-							}
-						}
-					}
-					break;
-
-			case get_kernel_mask3x3(0, 1, 0, 0, 0, 0, 0, 1, 0):	// (X, 0, X)^T
-#if SWEET_THREADING
-#pragma omp parallel for OPENMP_PAR_SIMD collapse(2)
-#endif
-					for (int y = 0; y < res_y; y++)
-					{
-						for (int x = 0; x < res_x; x++)
-						{
-							double &data_out = o_data[y*res_x+x];
-							data_out = 0;
-
-							if (y > 0 && y < res_y-1)
-							{
-								double *kernel_scalar_ptr = &kernel_data[1];
-								double *data_scalar_ptr = &i_data[(y-1)*res_x+x];
-
-								data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-								data_out += kernel_scalar_ptr[6]*data_scalar_ptr[2*res_x];
-							}
-							else
-							{
-								for (int j = -1; j <= 1; j+=2)
-								{
-									int pos_y = y+j;
-
-									pos_y -= (pos_y >= res_y ? res_y : 0);
-									pos_y += (pos_y < 0 ? res_y : 0);
-
-									int idx = (j+1)*3+1;
-
-									double kernel_scalar = kernel_data[idx];
-									double data_scalar = i_data[pos_y*res_x+x];
-
-									data_out += kernel_scalar*data_scalar;
-								}
-							}
-						}
-					}
-					break;
-
-			case get_kernel_mask3x3(0, 1, 0, 0, 1, 0, 0, 1, 0):	// (X, 0, X)^T
-#if SWEET_THREADING
-#pragma omp parallel for OPENMP_PAR_SIMD collapse(2)
-#endif
-					for (int y = 0; y < res_y; y++)
-					{
-						for (int x = 0; x < res_x; x++)
-						{
-							double &data_out = o_data[y*res_x+x];
-							data_out = 0;
-
-							if (y > 0 && y < res_y-1)
-							{
-								double *kernel_scalar_ptr = &kernel_data[1];
-								double *data_scalar_ptr = &i_data[(y-1)*res_x+x];
-
-								data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-								data_out += kernel_scalar_ptr[3]*data_scalar_ptr[res_x];
-								data_out += kernel_scalar_ptr[6]*data_scalar_ptr[2*res_x];
-							}
-							else
-							{
-								for (int j = -1; j <= 1; j++)
-								{
-									int pos_y = y+j;
-
-									pos_y -= (pos_y >= res_y ? res_y : 0);
-									pos_y += (pos_y < 0 ? res_y : 0);
-
-									int idx = (j+1)*3+1;
-
-									double kernel_scalar = kernel_data[idx];
-									double data_scalar = i_data[pos_y*res_x+x];
-
-									data_out += kernel_scalar*data_scalar;
-								}
-							}
-						}
-					}
-					break;
-
-			default:
-#if SWEET_THREADING
-#pragma omp parallel for OPENMP_PAR_SIMD collapse(2)
-#endif
-				for (int y = 0; y < res_y; y++)
-				{
-					for (int x = 0; x < res_x; x++)
-					{
-						double &data_out = o_data[y*res_x+x];
-						data_out = 0;
 
-						for (int j = -1; j <= 1; j++)
-						{
-							int pos_y = y+j;
+	/**
+	 * Return the row kernel specialized for the mask of this stencil
+	 */
+	kernel3x3_row_fun p_kernel3x3_get_row_fun()	const
+	{
+		switch (kernel_id)
+		{
+		case get_kernel_mask3x3(0, 0, 0, 1, 0, 1, 0, 0, 0):	// (X, 0, X)
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 1, 0, 1, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 0, 0, 1, 1, 0, 0, 0, 0):	// (X, X, 0)
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 1, 1, 0, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 0, 0, 0, 1, 1, 0, 0, 0):	// (0, X, X)
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 0, 1, 1, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 0, 0, 1, 1, 1, 0, 0, 0):	// (X, X, X)
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 1, 1, 1, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 1, 0, 0, 0, 0, 0, 1, 0):	// (X, 0, X)^T
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 1, 0, 0, 0, 0, 0, 1, 0)>;
+
+		case get_kernel_mask3x3(0, 1, 0, 0, 1, 0, 0, 0, 0):	// (X, X, 0)^T
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 1, 0, 0, 1, 0, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 0, 0, 0, 1, 0, 0, 1, 0):	// (0, X, X)^T
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 0, 1, 0, 0, 1, 0)>;
+
+		case get_kernel_mask3x3(0, 1, 0, 0, 1, 0, 0, 1, 0):	// (X, X, X)^T
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 1, 0, 0, 1, 0, 0, 1, 0)>;
+
+		case get_kernel_mask3x3(0, 0, 0, 1, 0, 0, 0, 0, 0):	// shift
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 1, 0, 0, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 0, 0, 0, 0, 1, 0, 0, 0):	// shift
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 0, 0, 1, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 1, 0, 0, 0, 0, 0, 0, 0):	// shift
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 1, 0, 0, 0, 0, 0, 0, 0)>;
+
+		case get_kernel_mask3x3(0, 0, 0, 0, 0, 0, 0, 1, 0):	// shift
+			return &p_kernel3x3_row<get_kernel_mask3x3(0, 0, 0, 0, 0, 0, 0, 1, 0)>;
 
-							pos_y -= (pos_y >= res_y ? res_y : 0);
-							pos_y += (pos_y < 0 ? res_y : 0);
+		default:
+			return &p_kernel3x3_row<get_kernel_mask3x3(1, 1, 1, 1, 1, 1, 1, 1, 1)>;
+		}
+	}
+
+
+	/**
+	 * Apply up to two 3x3 stencils to the same input data.
+	 *
+	 * The domain is processed in tiles and the rows of each tile are
+	 * processed for both stencils while the input rows are still in cache.
+	 */
+	static
+	void p_kernel3x3_apply_tiled(
+			int res_x,
+			int res_y,
+			const double *i_data,
+
+			const double *i_kernel_a,
+			kernel3x3_row_fun i_row_fun_a,
+			double *o_data_a,
 
-							assert(pos_y >= 0 && pos_y < res_y);
+			const double *i_kernel_b,		///< second stencil, nullptr if not used
+			kernel3x3_row_fun i_row_fun_b,
+			double *o_data_b
+	)
+	{
+		int num_tiles_x = (res_x+kernel_tile_size_x-1)/kernel_tile_size_x;
+		int num_tiles_y = (res_y+kernel_tile_size_y-1)/kernel_tile_size_y;
 
-							for (int i = -1; i <= 1; i++)
-							{
-								int pos_x = x+i;
+#if SWEET_THREADING
+#pragma omp parallel for collapse(2) OMP_SCHEDULE
+#endif
+		for (int ty = 0; ty < num_tiles_y; ty++)
+		{
+			for (int tx = 0; tx < num_tiles_x; tx++)
+			{
+				int x_start = tx*kernel_tile_size_x;
+				int x_end = std::min(x_start+kernel_tile_size_x, res_x);
 
-								pos_x -= (pos_x >= res_x ? res_x : 0);
-								pos_x += (pos_x < 0 ? res_x : 0);
+				int y_start = ty*kernel_tile_size_y;
+				int y_end = std::min(y_start+kernel_tile_size_y, res_y);
 
-								assert(pos_x >= 0 && pos_x < res_x);
+				for (int y = y_start; y < y_end; y++)
+				{
+					// periodic halo rows
+					int y_m = (y == 0 ? res_y-1 : y-1);
+					int y_p = (y == res_y-1 ? 0 : y+1);
 
-								int idx = (j+1)*3+(i+1);
-								assert(idx >= 0 && idx < 9);
+					const double *row_m = &i_data[(std::size_t)y_m*res_x];
+					const double *row_0 = &i_data[(std::size_t)y*res_x];
+					const double *row_p = &i_data[(std::size_t)y_p*res_x];
 
-								double kernel_scalar = kernel_data[idx];
-								double data_scalar = i_data[pos_y*res_x+pos_x];
+					i_row_fun_a(i_kernel_a, row_m, row_0, row_p, &o_data_a[(std::size_t)y*res_x], x_start, x_end, res_x);
 
-								data_out += kernel_scalar*data_scalar;
-							}
-						}
-					}
+					if (i_kernel_b != nullptr)
+						i_row_fun_b(i_kernel_b, row_m, row_0, row_p, &o_data_b[(std::size_t)y*res_x], x_start, x_end, res_x);
 				}
 			}
 		}
+	}
+
+
+public:
+	void kernel_apply(
+			int res_x,
+			int res_y,
+			double *i_data,
+
+			double *o_data
+	)	const
+	{
+		if (kernel_size == 3)
+		{
+			p_kernel3x3_apply_tiled(
+					res_x, res_y, i_data,
+					kernel_data, p_kernel3x3_get_row_fun(), o_data,
+					nullptr, nullptr, nullptr
+				);
+		}
 		else
 		{
 			std::cerr << "Not yet implemented" << std::endl;
 		}
 	}
+
+
+	/**
+	 * Apply this and a second stencil to the same input data in a single sweep,
+	 * e.g. to compute the x and y derivatives of a field.
+	 */
+	void kernel_apply_fused(
+			const PlaneData_Kernels &i_kernel_b,	///< second stencil
+
+			int res_x,
+			int res_y,
+			double *i_data,
+
+			double *o_data_a,	///< output of this stencil
+			double *o_data_b	///< output of second stencil
+	)	const
+	{
+		if (kernel_size == 3 && i_kernel_b.kernel_size == 3)
+		{
+			p_kernel3x3_apply_tiled(
+					res_x, res_y, i_data,
+					kernel_data, p_kernel3x3_get_row_fun(), o_data_a,
+					i_kernel_b.kernel_data, i_kernel_b.p_kernel3x3_get_row_fun(), o_data_b
+				);
+		}
+		else
+		{
+			kernel_apply(res_x, res_y, i_data, o_data_a);
+			i_kernel_b.kernel_apply(res_x, res_y, i_data, o_data_b);
+		}
+	}
 #endif
 
 
@@ -44,7 +44,7 @@ public:
 			const PlaneData &i_dataArray
 	)
 	{
-		return diff2_c_x(i_dataArray) + diff2_c_y(i_dataArray);
+		return laplace(i_dataArray);
 	}
 
 
@@ -57,7 +57,14 @@ public:
 			const PlaneData &i_a
 	)
 	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
 		return diff2_c_x(i_a)+diff2_c_y(i_a);
+#else
+		PlaneData dx(planeDataConfig), dy(planeDataConfig);
+		PlaneData::apply_fused(diff2_c_x, diff2_c_y, i_a, dx, dy);
+
+		return dx+dy;
+#endif
 	}
 
 
@@ -69,7 +76,28 @@ public:
 			const PlaneData &i_a
 	)
 	{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
 		return diff_c_x(i_a)+diff_c_y(i_a);
+#else
+		PlaneData dx(planeDataConfig), dy(planeDataConfig);
+		PlaneData::apply_fused(diff_c_x, diff_c_y, i_a, dx, dy);
+
+		return dx+dy;
+#endif
+	}
+
+
+
+	/**
+	 * Compute the central differences in x and y direction in a single sweep
+	 */
+	inline void diff_c_xy(
+			const PlaneData &i_a,
+			PlaneData &o_dx,
+			PlaneData &o_dy
+	)
+	{
+		PlaneData::apply_fused(diff_c_x, diff_c_y, i_a, o_dx, o_dy);
 	}
 
 
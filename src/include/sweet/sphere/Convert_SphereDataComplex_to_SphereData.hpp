@@ -23,6 +23,7 @@ public:
 		i_sphereData.request_data_physical();
 
 		SphereData out(i_sphereData.sphereDataConfig);
+		out.physical_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -33,6 +33,10 @@ public:
 	const SphereDataConfig *sphereDataConfig;
 
 public:
+	/**
+	 * The buffers of both representations are allocated on first use,
+	 * see physical_alloc_buffer() and spectral_alloc_buffer()
+	 */
 	double *physical_space_data;
 	std::complex<double> *spectral_space_data;
 
@@ -57,7 +61,9 @@ public:
 	SphereData()	:
 		sphereDataConfig(nullptr),
 		physical_space_data(nullptr),
-		spectral_space_data(nullptr)
+		spectral_space_data(nullptr),
+		spectral_space_data_valid(false),
+		physical_space_data_valid(false)
 	{
 	}
 
@@ -102,10 +108,16 @@ public:
 		check(i_sph_data.sphereDataConfig);
 
 		if (i_sph_data.physical_space_data_valid)
+		{
+			physical_alloc_buffer();
 			memcpy(physical_space_data, i_sph_data.physical_space_data, sizeof(double)*sphereDataConfig->physical_array_data_number_of_elements);
+		}
 
 		if (i_sph_data.spectral_space_data_valid)
+		{
+			spectral_alloc_buffer();
 			memcpy(spectral_space_data, i_sph_data.spectral_space_data, sizeof(cplx)*sphereDataConfig->spectral_array_data_number_of_elements);
+		}
 
 		physical_space_data_valid = i_sph_data.physical_space_data_valid;
 		spectral_space_data_valid = i_sph_data.spectral_space_data_valid;
@@ -158,6 +170,7 @@ public:
 		}
 
 		request_data_spectral();
+		out.spectral_alloc_buffer();
 
 		if (scaling_mode == -1)
 		{
@@ -258,6 +271,57 @@ public:
 #endif
 
 
+	/**
+	 * Allocate the buffer for the physical space data if this wasn't done so far.
+	 *
+	 * This has to be called before writing physical data directly to physical_space_data
+	 * without calling request_data_physical() before.
+	 */
+	inline
+	void physical_alloc_buffer()	const
+	{
+		if (physical_space_data != nullptr)
+			return;
+
+		((SphereData*)this)->physical_space_data = MemBlockAlloc::alloc<double>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(double));
+	}
+
+
+	/**
+	 * Allocate the buffer for the spectral space data if this wasn't done so far,
+	 * see physical_alloc_buffer()
+	 */
+	inline
+	void spectral_alloc_buffer()	const
+	{
+		if (spectral_space_data != nullptr)
+			return;
+
+		((SphereData*)this)->spectral_space_data = MemBlockAlloc::alloc<cplx>(sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
+	}
+
+
+	/**
+	 * Return the buffers of invalid representations to the memory allocator
+	 */
+	void free_unused_buffers()	const
+	{
+		SphereData *this_var = (SphereData*)this;
+
+		if (!physical_space_data_valid)
+		{
+			MemBlockAlloc::free(physical_space_data, sphereDataConfig->physical_array_data_number_of_elements * sizeof(double));
+			this_var->physical_space_data = nullptr;
+		}
+
+		if (!spectral_space_data_valid)
+		{
+			MemBlockAlloc::free(spectral_space_data, sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
+			this_var->spectral_space_data = nullptr;
+		}
+	}
+
+
 	void request_data_spectral()	const
 	{
 		if (spectral_space_data_valid)
@@ -265,16 +329,22 @@ public:
 
 		assert(physical_space_data_valid);
 
+		spectral_alloc_buffer();
+
 		/**
 		 * Warning: This is an in-situ operation.
 		 * Therefore, the data in the source array will be destroyed.
 		 */
-		spat_to_SH(sphereDataConfig->shtns, physical_space_data, spectral_space_data);
+		if (physical_space_data != nullptr)
+			spat_to_SH(sphereDataConfig->shtns, physical_space_data, spectral_space_data);
 
 		SphereData *this_var = (SphereData*)this;
 
 		this_var->physical_space_data_valid = false;
 		this_var->spectral_space_data_valid = true;
+
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			free_unused_buffers();
 	}
 
 
@@ -285,16 +355,22 @@ public:
 
 		assert(spectral_space_data_valid);
 
+		physical_alloc_buffer();
+
 		/**
 		 * Warning: This is an in-situ operation.
 		 * Therefore, the data in the source array will be destroyed.
 		 */
-		SH_to_spat(sphereDataConfig->shtns, spectral_space_data, physical_space_data);
+		if (spectral_space_data != nullptr)
+			SH_to_spat(sphereDataConfig->shtns, spectral_space_data, physical_space_data);
 
 		SphereData *this_var = (SphereData*)this;
 
 		this_var->physical_space_data_valid = true;
 		this_var->spectral_space_data_valid = false;
+
+		if (MemBlockAlloc::getReleaseUnusedBuffers())
+			free_unused_buffers();
 	}
 
 
@@ -340,6 +416,7 @@ public:
 		i_sph_data.request_data_spectral();
 
 		SphereData out_sph_data(sphereDataConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 
 #if SWEET_THREADING
@@ -413,6 +490,7 @@ public:
 		i_sph_data.request_data_spectral();
 
 		SphereData out_sph_data(sphereDataConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -433,6 +511,7 @@ public:
 		request_data_spectral();
 
 		SphereData out_sph_data(sphereDataConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -458,6 +537,7 @@ public:
 		i_sph_data.request_data_physical();
 
 		SphereData out_sph_data(sphereDataConfig);
+		out_sph_data.physical_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -483,6 +563,7 @@ public:
 		i_sph_data.request_data_physical();
 
 		SphereData out_sph_data(sphereDataConfig);
+		out_sph_data.physical_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -505,6 +586,7 @@ public:
 		request_data_spectral();
 
 		SphereData out_sph_data(sphereDataConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -567,6 +649,7 @@ public:
 		request_data_spectral();
 
 		SphereData out_sph_data(sphereDataConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -624,13 +707,27 @@ public:
 			const SphereDataConfig *i_sphConfig
 	)
 	{
+		p_free_buffers();
+
 		sphereDataConfig = i_sphConfig;
 
 		spectral_space_data_valid = false;
 		physical_space_data_valid = false;
+	}
+
+
+
+private:
+	void p_free_buffers()
+	{
+		if (sphereDataConfig == nullptr)
+			return;
 
-		physical_space_data = MemBlockAlloc::alloc<double>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(double));
-		spectral_space_data = MemBlockAlloc::alloc<cplx>(sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
+		MemBlockAlloc::free(physical_space_data, sphereDataConfig->physical_array_data_number_of_elements * sizeof(double));
+		MemBlockAlloc::free(spectral_space_data, sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
+
+		physical_space_data = nullptr;
+		spectral_space_data = nullptr;
 	}
 
 
@@ -638,8 +735,7 @@ public:
 public:
 	~SphereData()
 	{
-		MemBlockAlloc::free(physical_space_data, sphereDataConfig->physical_array_data_number_of_elements * sizeof(double));
-		MemBlockAlloc::free(spectral_space_data, sphereDataConfig->spectral_array_data_number_of_elements * sizeof(cplx));
+		p_free_buffers();
 	}
 
 
@@ -683,6 +779,7 @@ public:
 	const SphereData& physical_truncate()
 	{
 		request_data_physical();
+		spectral_alloc_buffer();
 
 		spat_to_SH(sphereDataConfig->shtns, physical_space_data, spectral_space_data);
 		SH_to_spat(sphereDataConfig->shtns, spectral_space_data, physical_space_data);
@@ -698,6 +795,7 @@ public:
 	const SphereData& spectral_truncate()	const
 	{
 		request_data_spectral();
+		physical_alloc_buffer();
 
 		SH_to_spat(sphereDataConfig->shtns, spectral_space_data, physical_space_data);
 		spat_to_SH(sphereDataConfig->shtns, physical_space_data, spectral_space_data);
@@ -715,6 +813,8 @@ public:
 		if (physical_space_data_valid)
 			request_data_spectral();
 
+		spectral_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -737,6 +837,8 @@ public:
 
 	bool physical_isAnyNaNorInf()
 	{
+		request_data_physical();
+
 		for (int i = 0; i < sphereDataConfig->physical_array_data_number_of_elements; i++)
 		{
 			if (std::isnan(physical_space_data[i]) || std::isinf(physical_space_data[i]) != 0)
@@ -778,6 +880,8 @@ public:
 	 */
 	void spectral_set_zero()
 	{
+		spectral_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -798,6 +902,8 @@ public:
 			const std::complex<double> &i_value
 	)
 	{
+		spectral_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -822,6 +928,8 @@ public:
 		if (spectral_space_data_valid)
 			request_data_physical();
 
+		physical_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -863,6 +971,8 @@ public:
 		if (spectral_space_data_valid)
 			request_data_physical();
 
+		physical_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -899,6 +1009,8 @@ public:
 		if (spectral_space_data_valid)
 			request_data_physical();
 
+		physical_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -947,6 +1059,8 @@ public:
 	 */
 	void physical_set_zero()
 	{
+		physical_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -968,6 +1082,8 @@ public:
 			double i_value
 	)
 	{
+		physical_alloc_buffer();
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -994,6 +1110,8 @@ public:
 		if (spectral_space_data_valid)
 			request_data_physical();
 
+		physical_alloc_buffer();
+
 		physical_space_data[i_lon_idx*sphereDataConfig->physical_num_lat + i_lat_idx] = i_value;
 
 		physical_space_data_valid = true;
@@ -1139,6 +1257,7 @@ public:
 		double scale = i_new_max_abs/max_abs;
 
 		SphereData out(sphereDataConfig);
+		out.physical_alloc_buffer();
 		request_data_physical();
 
 		for (int j = 0; j < sphereDataConfig->physical_array_data_number_of_elements; j++)
@@ -1194,6 +1313,71 @@ public:
 	}
 
 
+	/**
+	 * Return the number of pages of the physical data on each NUMA node
+	 * to verify the placement of the data, see MemBlockAlloc::getNumaPlacement()
+	 */
+	std::vector<std::size_t> get_physical_numa_placement()	const
+	{
+		if (physical_space_data == nullptr)
+			return std::vector<std::size_t>();
+
+		return MemBlockAlloc::getNumaPlacement(
+				physical_space_data,
+				sphereDataConfig->physical_array_data_number_of_elements*sizeof(double)
+			);
+	}
+
+
+	/**
+	 * Write raw data for checkpointing to a binary stream.
+	 *
+	 * The spectral coefficients are stored if they are valid.
+	 * The physical data is only stored additionally if it is valid as well,
+	 * hence the restored data is bitwise identical.
+	 */
+	void file_checkpoint_write(
+			std::ostream &o_ostream
+	)	const
+	{
+		int flags = (spectral_space_data_valid ? 1 : 0) | (physical_space_data_valid ? 2 : 0);
+		o_ostream.write((const char*)&flags, sizeof(flags));
+
+		if (spectral_space_data_valid)
+			o_ostream.write((const char*)spectral_space_data, sizeof(std::complex<double>)*sphereDataConfig->spectral_array_data_number_of_elements);
+
+		if (physical_space_data_valid)
+			o_ostream.write((const char*)physical_space_data, sizeof(double)*sphereDataConfig->physical_array_data_number_of_elements);
+	}
+
+
+	/**
+	 * Read data written with file_checkpoint_write()
+	 */
+	void file_checkpoint_read(
+			std::istream &i_istream
+	)
+	{
+		int flags;
+		i_istream.read((char*)&flags, sizeof(flags));
+
+		spectral_space_data_valid = (flags & 1);
+		physical_space_data_valid = (flags & 2);
+
+		if (spectral_space_data_valid)
+		{
+			spectral_alloc_buffer();
+			i_istream.read((char*)spectral_space_data, sizeof(std::complex<double>)*sphereDataConfig->spectral_array_data_number_of_elements);
+		}
+
+		if (physical_space_data_valid)
+		{
+			physical_alloc_buffer();
+			i_istream.read((char*)physical_space_data, sizeof(double)*sphereDataConfig->physical_array_data_number_of_elements);
+		}
+	}
+
+
 	void physical_file_write(
 			const std::string &i_filename,
 			const char *i_title = "",
@@ -1327,6 +1511,8 @@ public:
 				FatalError("EXIT");
 			}
 
+			physical_alloc_buffer();
+
 			if (!file.read((char*)physical_space_data, expected_size))
 			{
 				std::cerr << "Error while loading data from file " << i_filename << std::endl;
@@ -84,6 +84,13 @@ public:
 public:
 	double *lat_cogaussian;
 
+	/**
+	 * Number of threads used by SHTns for this config.
+	 * 0 lets SHTns choose the number of threads automatically
+	 */
+public:
+	int shtns_num_threads;
+
 public:
 	SphereDataConfig()	:
 		shtns(nullptr),
@@ -98,7 +105,9 @@ public:
 
 		lat(nullptr),
 		lat_gaussian(nullptr),
-		lat_cogaussian(nullptr)
+		lat_cogaussian(nullptr),
+
+		shtns_num_threads(0)
 	{
 	}
 
@@ -351,7 +360,7 @@ public:
 
 		// enable multi-threaded transforms (if supported).
 #if SWEET_THREADING
-		shtns_use_threads(0);	// automatically choose number of threads
+		shtns_use_threads(shtns_num_threads);	// 0: automatically choose number of threads
 #else
 		shtns_use_threads(1);	// value of 1 disables threading
 #endif
@@ -391,7 +400,7 @@ public:
 	{
 		shtns_verbose(0);			// displays informations during initialization.
 #if SWEET_THREADING
-		shtns_use_threads(0);	// automatically choose number of threads
+		shtns_use_threads(shtns_num_threads);	// 0: automatically choose number of threads
 #else
 		shtns_use_threads(1);	// value of 1 disables threading
 #endif
@@ -0,0 +1,241 @@
+/*
+ * SphereDataConfigRegistry.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREDATACONFIGREGISTRY_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREDATACONFIGREGISTRY_HPP_
+
+#include <vector>
+#include <cassert>
+#include <sweet/FatalError.hpp>
+#include <sweet/sphere/SphereDataConfig.hpp>
+
+
+
+/**
+ * Process-wide registry of SphereDataConfig instances.
+ *
+ * Configs are created on demand and shared by all solver instances and threads
+ * which request the same (modes, grid, number of SHTns threads).
+ * This avoids creating the SHTns tables several times, e.g. for the
+ * configs with additional modes used by the REXI solvers.
+ *
+ * SHTns setup is not thread safe, hence creation and destruction are
+ * serialized within a named critical region.
+ */
+class SphereDataConfigRegistry
+{
+	class Entry
+	{
+	public:
+		/// spectral modes
+		int spectral_modes_m_max;
+		int spectral_modes_n_max;
+
+		/// requested physical resolution, <= 0 to determine it automatically
+		int physical_num_lon;
+		int physical_num_lat;
+
+		/// number of threads for SHTns, 0 for automatic
+		int num_threads;
+
+		SphereDataConfig *sphereDataConfig;
+
+		int ref_counter;
+	};
+
+	std::vector<Entry> entries;
+
+
+public:
+	static
+	SphereDataConfigRegistry& getSingletonRef()
+	{
+		static SphereDataConfigRegistry registry;
+		return registry;
+	}
+
+
+public:
+	/**
+	 * Return a shared config for the given modes.
+	 *
+	 * Set the physical resolution to 0 to determine it automatically,
+	 * see SphereDataConfig::setupAutoPhysicalSpace().
+	 *
+	 * Each call has to be matched by a call to releaseConfig()
+	 */
+	static
+	SphereDataConfig* getConfig(
+			int i_mmax,
+			int i_nmax,
+			int i_nphi = 0,
+			int i_nlat = 0,
+			int i_num_threads = 0
+	)
+	{
+		SphereDataConfigRegistry &r = getSingletonRef();
+		SphereDataConfig *retval = nullptr;
+
+		if (i_nphi <= 0 || i_nlat <= 0)
+		{
+			i_nphi = 0;
+			i_nlat = 0;
+		}
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp critical (SphereDataConfigRegistry)
+#endif
+		{
+			for (auto &e : r.entries)
+			{
+				if (	e.spectral_modes_m_max != i_mmax	||
+						e.spectral_modes_n_max != i_nmax	||
+						e.num_threads != i_num_threads
+				)
+					continue;
+
+				/*
+				 * Also match a config with an automatically determined
+				 * grid if it has the requested resolution
+				 */
+				if (	i_nphi != 0 &&
+						(	e.sphereDataConfig->physical_num_lon != i_nphi	||
+							e.sphereDataConfig->physical_num_lat != i_nlat
+						)
+				)
+					continue;
+
+				if (i_nphi == 0 && e.physical_num_lon != 0)
+					continue;
+
+				e.ref_counter++;
+				retval = e.sphereDataConfig;
+				break;
+			}
+
+			if (retval == nullptr)
+			{
+				Entry e;
+				e.spectral_modes_m_max = i_mmax;
+				e.spectral_modes_n_max = i_nmax;
+				e.physical_num_lon = i_nphi;
+				e.physical_num_lat = i_nlat;
+				e.num_threads = i_num_threads;
+				e.ref_counter = 1;
+
+				e.sphereDataConfig = new SphereDataConfig;
+				e.sphereDataConfig->shtns_num_threads = i_num_threads;
+
+				if (i_nphi == 0)
+				{
+					int nphi, nlat;
+					e.sphereDataConfig->setupAutoPhysicalSpace(i_mmax, i_nmax, &nphi, &nlat);
+				}
+				else
+				{
+					e.sphereDataConfig->setup(i_mmax, i_nmax, i_nphi, i_nlat);
+				}
+
+				r.entries.push_back(e);
+				retval = e.sphereDataConfig;
+			}
+		}
+
+		return retval;
+	}
+
+
+
+	/**
+	 * Return a shared config with additional modes compared to the given one,
+	 * see SphereDataConfig::setupAdditionalModes()
+	 */
+	static
+	SphereDataConfig* getConfigAdditionalModes(
+			const SphereDataConfig *i_sphereDataConfig,
+			int i_additional_modes_longitude,
+			int i_additional_modes_latitude,
+			int i_num_threads = 0
+	)
+	{
+		return getConfig(
+				i_sphereDataConfig->spectral_modes_m_max + i_additional_modes_longitude,
+				i_sphereDataConfig->spectral_modes_n_max + i_additional_modes_latitude,
+				0,
+				0,
+				i_num_threads
+			);
+	}
+
+
+
+	/**
+	 * Release a config which was returned by getConfig().
+	 * The config and its SHTns tables are freed if it is not used anymore.
+	 */
+	static
+	void releaseConfig(
+			SphereDataConfig *i_sphereDataConfig
+	)
+	{
+		if (i_sphereDataConfig == nullptr)
+			return;
+
+		SphereDataConfigRegistry &r = getSingletonRef();
+
+#if SWEET_THREADING || SWEET_REXI_THREAD_PARALLEL_SUM
+#pragma omp critical (SphereDataConfigRegistry)
+#endif
+		{
+			bool found = false;
+			for (std::size_t i = 0; i < r.entries.size(); i++)
+			{
+				Entry &e = r.entries[i];
+				if (e.sphereDataConfig != i_sphereDataConfig)
+					continue;
+
+				found = true;
+				e.ref_counter--;
+				assert(e.ref_counter >= 0);
+
+				if (e.ref_counter == 0)
+				{
+					delete e.sphereDataConfig;
+					r.entries.erase(r.entries.begin()+i);
+				}
+				break;
+			}
+
+			if (!found)
+				FatalError("SphereDataConfig was not created by SphereDataConfigRegistry");
+		}
+	}
+
+
+
+	/**
+	 * Return the number of configs which are currently alive
+	 */
+	static
+	std::size_t getNumberOfConfigs()
+	{
+		return getSingletonRef().entries.size();
+	}
+
+
+
+	~SphereDataConfigRegistry()
+	{
+		for (auto &e : entries)
+			delete e.sphereDataConfig;
+
+		entries.clear();
+	}
+};
+
+
+#endif /* SRC_INCLUDE_SWEET_SPHERE_SPHEREDATACONFIGREGISTRY_HPP_ */
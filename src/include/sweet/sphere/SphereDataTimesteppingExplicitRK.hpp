@@ -31,7 +31,13 @@ public:
 	)
 	{
 		if (RK_h_t != nullptr)	///< already allocated?
-			return;
+		{
+			// reallocate if the buffers are not sufficient for the requested order
+			if (i_rk_order <= runge_kutta_order)
+				return;
+
+			cleanupBuffers();
+		}
 
 		runge_kutta_order = i_rk_order;
 		int N = i_rk_order;
@@ -53,7 +59,7 @@ public:
 
 
 
-	~SphereDataTimesteppingExplicitRK()
+	void cleanupBuffers()
 	{
 		int N = runge_kutta_order;
 
@@ -74,6 +80,15 @@ public:
 			RK_u_t = nullptr;
 			RK_v_t = nullptr;
 		}
+
+		runge_kutta_order = -1;
+	}
+
+
+
+	~SphereDataTimesteppingExplicitRK()
+	{
+		cleanupBuffers();
 	}
 
 
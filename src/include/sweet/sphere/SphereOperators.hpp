@@ -123,6 +123,7 @@ public:
 		i_sph_data.request_data_spectral();
 
 		SphereData out_sph_data(i_sph_data.sphereDataConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 		// compute d/dlambda in spectral space
 #if SWEET_THREADING
@@ -363,6 +364,7 @@ public:
 		const SphereDataConfig *sphConfig = i_sph_data.sphereDataConfig;
 
 		SphereData out_sph_data = SphereData(sphConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 #if SWEET_THREADING
 #pragma omp parallel for
@@ -407,6 +409,7 @@ public:
 		i_sphere_data.request_data_spectral();
 
 		SphereData out_sph_data = SphereData(sphereDataConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 
 #if SWEET_THREADING
@@ -451,6 +454,7 @@ public:
 		i_sph_data.request_data_spectral();
 
 		SphereData out_sph_data = SphereData(sphConfig);
+		out_sph_data.spectral_alloc_buffer();
 
 
 #if SWEET_THREADING
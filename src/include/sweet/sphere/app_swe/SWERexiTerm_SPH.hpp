@@ -25,8 +25,8 @@ class SWERexiTerm_SPH
 	SphereDataConfig *sphereDataConfig;
 
 	/// Solver for given alpha
-	SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolverPhi;
-	SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolverVel;
+	SphBandedMatrixPhysicalComplexREXI sphSolverPhi;
+	SphBandedMatrixPhysicalComplexREXI sphSolverVel;
 
 	/// scalar infront of RHS
 	std::complex<double> rhs_scalar;
@@ -31,8 +31,8 @@ class SWERexiTerm_SPHRobert
 	SphereDataConfig *sphereDataConfigSolver;
 
 	/// Solver for given alpha
-	SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolverPhi;
-	SphBandedMatrixPhysicalComplex< std::complex<double> > sphSolverVel;
+	SphBandedMatrixPhysicalComplexREXI sphSolverPhi;
+	SphBandedMatrixPhysicalComplexREXI sphSolverVel;
 
 	/// scalar infront of RHS
 	std::complex<double> rhs_scalar;
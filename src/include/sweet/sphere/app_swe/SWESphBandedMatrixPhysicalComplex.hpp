@@ -12,13 +12,24 @@
 #include <sweet/sphere/SphereSPHIdentities.hpp>
 #include <sweet/sphere/SphereDataComplex.hpp>
 #include <libmath/LapackBandedMatrixSolver.hpp>
+#include <libmath/SmallBandedMatrixSolver.hpp>
+#include <sweet/FatalError.hpp>
+#include <vector>
+#include <type_traits>
 
 
 
 /**
  * phi(lambda,mu) denotes the solution
+ *
+ * The LU decomposition can be stored and applied in a lower precision (TSolver)
+ * than the assembled matrix. Then, the solution is improved with
+ * iterative refinement based on residuals computed in the precision T.
  */
-template < typename T = std::complex<double> >	// T: complex valued single or double precision method
+template <
+	typename T = std::complex<double>,	// T: complex valued single or double precision method
+	typename TSolver = T				// TSolver: precision of LU decomposition and triangular solves
+>
 class SphBandedMatrixPhysicalComplex	:
 		SphereSPHIdentities
 {
@@ -33,11 +44,6 @@ public:
 	 */
 	SphereDataConfig *sphereDataConfig;
 
-	/**
-	 * Solver for banded matrix
-	 */
-	LapackBandedMatrixSolver< std::complex<double> > bandedMatrixSolver;
-
 	/**
 	 * Size of buffers
 	 */
@@ -48,6 +54,46 @@ public:
 	 */
 	std::complex<double> *buffer_in, *buffer_out;
 
+	/**
+	 * LU decomposition for the small bandwidth solver.
+	 * This is computed once for the assembled lhs at the first solve.
+	 */
+	TSolver *lu_data;
+	std::size_t lu_data_size;
+
+	/**
+	 * Number of iterative refinement steps if TSolver differs from T
+	 */
+	int num_refinement_iterations;
+
+	/**
+	 * Buffers for the triangular solves in lower precision and the residual
+	 */
+	TSolver *buffer_solver_b, *buffer_solver_x;
+	T *buffer_residual;
+
+	/**
+	 * Is the LU decomposition valid for the current lhs?
+	 */
+	bool lu_valid;
+
+	/**
+	 * 2 if even and odd modes are decoupled, otherwise 1
+	 */
+	int lu_stride;
+
+	/**
+	 * Number of off-diagonals within each (even/odd) chain
+	 */
+	int lu_chain_bandwidth;
+
+	/**
+	 * LAPACK LU decomposition (band storage) for blocks which require pivoting.
+	 * Empty for blocks solved with the small bandwidth solver.
+	 */
+	std::vector< std::vector<T> > lu_lapack_data;
+	std::vector< std::vector<int> > lu_lapack_ipiv;
+
 	/**
 	 * Setup the SPH solver
 	 */
@@ -60,13 +106,19 @@ public:
 		sphereDataConfig = i_sphConfig;
 
 		lhs.setup(sphereDataConfig, i_halosize_offdiagonal);
-
-		bandedMatrixSolver.setup(i_sphConfig->spectral_modes_n_max+1, i_halosize_offdiagonal);
+		lu_valid = false;
 
 		buffer_size = (sphereDataConfig->spectral_modes_n_max+1)*sizeof(std::complex<double>);
 
 		buffer_in = MemBlockAlloc::alloc< std::complex<double> >(buffer_size);
 		buffer_out = MemBlockAlloc::alloc< std::complex<double> >(buffer_size);
+
+		if (!std::is_same<T, TSolver>::value)
+		{
+			buffer_solver_b = MemBlockAlloc::alloc<TSolver>(p_solverBufferSize());
+			buffer_solver_x = MemBlockAlloc::alloc<TSolver>(p_solverBufferSize());
+			buffer_residual = MemBlockAlloc::alloc<T>(p_residualBufferSize());
+		}
 	}
 
 
@@ -74,7 +126,16 @@ public:
 		sphereDataConfig(nullptr),
 		buffer_size(0),
 		buffer_in(nullptr),
-		buffer_out(nullptr)
+		buffer_out(nullptr),
+		lu_data(nullptr),
+		lu_data_size(0),
+		num_refinement_iterations(2),
+		buffer_solver_b(nullptr),
+		buffer_solver_x(nullptr),
+		buffer_residual(nullptr),
+		lu_valid(false),
+		lu_stride(1),
+		lu_chain_bandwidth(0)
 	{
 	}
 
@@ -86,9 +147,235 @@ public:
 			MemBlockAlloc::free(buffer_in, buffer_size);
 			MemBlockAlloc::free(buffer_out, buffer_size);
 		}
+
+		if (lu_data != nullptr)
+			MemBlockAlloc::free(lu_data, lu_data_size);
+
+		if (buffer_solver_b != nullptr)
+		{
+			MemBlockAlloc::free(buffer_solver_b, p_solverBufferSize());
+			MemBlockAlloc::free(buffer_solver_x, p_solverBufferSize());
+			MemBlockAlloc::free(buffer_residual, p_residualBufferSize());
+		}
+	}
+
+
+
+private:
+	std::size_t p_solverBufferSize()
+	{
+		return (sphereDataConfig->spectral_modes_n_max+1)*sizeof(TSolver);
+	}
+
+	std::size_t p_residualBufferSize()
+	{
+		return (sphereDataConfig->spectral_modes_n_max+1)*sizeof(T);
+	}
+
+
+
+	/**
+	 * Compute the LU decomposition of a block in the precision of the matrix
+	 */
+	bool p_factorizeBlock(
+			const typename BandedMatrixPhysicalComplex<T>::BlockView &i_block,
+			T *o_LU
+	)
+	{
+		return SmallBandedMatrixSolver<T>::factorizeBlock(
+				lu_chain_bandwidth,
+				i_block.AB,
+				i_block.LDAB,
+				i_block.kl,
+				i_block.ku,
+				i_block.size,
+				lu_stride,
+				o_LU
+			);
+	}
+
+
+
+	/**
+	 * Compute the LU decomposition of a block in the precision of the matrix
+	 * and store it in the lower precision of the solver
+	 */
+	template <typename TLU>
+	bool p_factorizeBlock(
+			const typename BandedMatrixPhysicalComplex<T>::BlockView &i_block,
+			TLU *o_LU
+	)
+	{
+		std::vector<T> lu((std::size_t)i_block.size*(2*lu_chain_bandwidth+1));
+
+		if (!p_factorizeBlock(i_block, lu.data()))
+			return false;
+
+		for (std::size_t i = 0; i < lu.size(); i++)
+			o_LU[i] = TLU(lu[i]);
+
+		return true;
+	}
+
+
+
+	/**
+	 * Solve a block with the LU decomposition in the precision of the matrix
+	 */
+	void p_solveBlock(
+			const T *i_LU,
+			int i_m,
+			int i_size,
+			const T *i_b,
+			T *o_x
+	)
+	{
+		SmallBandedMatrixSolver<T>::solveBlock(
+				lu_chain_bandwidth,
+				i_LU,
+				i_size,
+				lu_stride,
+				i_b,
+				o_x
+			);
+	}
+
+
+
+	/**
+	 * Solve a block with the LU decomposition in lower precision
+	 * and improve the solution with iterative refinement
+	 */
+	template <typename TLU>
+	void p_solveBlock(
+			const TLU *i_LU,
+			int i_m,
+			int i_size,
+			const T *i_b,
+			T *o_x
+	)
+	{
+		for (int i = 0; i < i_size; i++)
+			buffer_solver_b[i] = TLU(i_b[i]);
+
+		SmallBandedMatrixSolver<TLU>::solveBlock(lu_chain_bandwidth, i_LU, i_size, lu_stride, buffer_solver_b, buffer_solver_x);
+
+		for (int i = 0; i < i_size; i++)
+			o_x[i] = T(buffer_solver_x[i]);
+
+		typename BandedMatrixPhysicalComplex<T>::BlockView block = lhs.getBlockView(i_m);
+
+		for (int k = 0; k < num_refinement_iterations; k++)
+		{
+			SmallBandedMatrixSolver<T>::residualBlock(block.AB, block.LDAB, block.kl, block.ku, i_size, i_b, o_x, buffer_residual);
+
+			for (int i = 0; i < i_size; i++)
+				buffer_solver_b[i] = TLU(buffer_residual[i]);
+
+			SmallBandedMatrixSolver<TLU>::solveBlock(lu_chain_bandwidth, i_LU, i_size, lu_stride, buffer_solver_b, buffer_solver_x);
+
+			for (int i = 0; i < i_size; i++)
+				o_x[i] += T(buffer_solver_x[i]);
+		}
+	}
+
+
+
+	/**
+	 * Setup the small bandwidth solver for the current lhs:
+	 *
+	 * 1) Determine the bandwidth and whether even and odd modes are decoupled
+	 * 2) Compute LU decomposition of each m block
+	 */
+	void p_setupSmallBandwidthSolver()
+	{
+		int bandwidth = 0;
+		bool odd_coupling = false;
+
+		for (int m = -sphereDataConfig->spectral_modes_m_max; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			typename BandedMatrixPhysicalComplex<T>::BlockView block = lhs.getBlockView(m);
+
+			SmallBandedMatrixSolver<T>::analyzeBlock(
+					block.AB,
+					block.LDAB,
+					block.kl,
+					block.ku,
+					block.size,
+					bandwidth,
+					odd_coupling
+				);
+		}
+
+		if (odd_coupling || bandwidth == 0)
+		{
+			lu_stride = 1;
+			lu_chain_bandwidth = bandwidth;
+		}
+		else
+		{
+			lu_stride = 2;
+			lu_chain_bandwidth = bandwidth/2;
+		}
+
+		std::size_t new_size = sizeof(TSolver)*sphereDataConfig->spectral_complex_array_data_number_of_elements*(2*lu_chain_bandwidth+1);
+		if (new_size != lu_data_size)
+		{
+			if (lu_data != nullptr)
+				MemBlockAlloc::free(lu_data, lu_data_size);
+
+			lu_data_size = new_size;
+			lu_data = MemBlockAlloc::alloc<TSolver>(lu_data_size);
+		}
+
+		lu_lapack_data.resize(2*sphereDataConfig->spectral_modes_m_max+1);
+		lu_lapack_ipiv.resize(2*sphereDataConfig->spectral_modes_m_max+1);
+
+#if SWEET_THREADING
+#pragma omp parallel for
+#endif
+		for (int m = -sphereDataConfig->spectral_modes_m_max; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			int idx = sphereDataConfig->getArrayIndexByModes_Complex_NCompact(std::abs(m),m);
+			typename BandedMatrixPhysicalComplex<T>::BlockView block = lhs.getBlockView(m);
+
+			std::vector<T> &lapack_data = lu_lapack_data[m+sphereDataConfig->spectral_modes_m_max];
+			std::vector<int> &lapack_ipiv = lu_lapack_ipiv[m+sphereDataConfig->spectral_modes_m_max];
+
+			bool ok = p_factorizeBlock(block, &lu_data[idx*(2*lu_chain_bandwidth+1)]);
+
+			if (ok)
+			{
+				lapack_data.clear();
+				lapack_ipiv.clear();
+				continue;
+			}
+
+			/*
+			 * Fall back to LAPACK with pivoting.
+			 * The block is already in the band storage required by zgbtrf.
+			 */
+			lapack_data.assign(block.AB, block.AB+(std::size_t)block.LDAB*block.size);
+			lapack_ipiv.resize(block.size);
+
+			if (!LapackBandedMatrixSolver< std::complex<double> >::factorize_BandedLapackArray_inplace(
+					lapack_data.data(),
+					block.LDAB,
+					block.size,
+					block.kl,
+					block.ku,
+					lapack_ipiv.data()
+				))
+				FatalError("Singular matrix block in SphBandedMatrixPhysicalComplex");
+		}
+
+		lu_valid = true;
 	}
 
 
+public:
+
+
 	/**
 	 * Solver for
 	 * 	a*phi(lambda,mu)
@@ -97,6 +384,8 @@ public:
 			const std::complex<double> &i_value
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -121,6 +410,8 @@ public:
 			const std::complex<double> &i_scalar = 1.0
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -169,6 +460,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 		solver_component_scalar_phi(i_scalar);
 	}
 
@@ -183,6 +476,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -211,6 +506,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -240,6 +537,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -266,6 +565,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -291,6 +592,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -320,6 +623,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -349,6 +654,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -376,6 +683,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 		/*
 		 * First part
 		 */
@@ -417,6 +726,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 #if SWEET_THREADING
 #pragma omp parallel for
 #endif
@@ -440,6 +751,8 @@ public:
 			double i_r
 	)
 	{
+		lu_valid = false;
+
 		std::complex<double> fac = (1.0/(i_r*i_r))*i_scalar;
 
 #if SWEET_THREADING
@@ -524,6 +837,9 @@ public:
 
 		SphereDataComplex out(sphereDataConfig);
 
+		if (!lu_valid)
+			p_setupSmallBandwidthSolver();
+
 		for (int m = -sphereDataConfig->spectral_modes_m_max; m <= sphereDataConfig->spectral_modes_m_max; m++)
 		{
 			int idx = sphereDataConfig->getArrayIndexByModes_Complex_NCompact(std::abs(m),m);
@@ -541,12 +857,34 @@ public:
 				}
 			}
 
-			bandedMatrixSolver.solve_diagBandedInverse_Carray(
-							&lhs.data[idx*lhs.num_diagonals],
-							buffer_in,
-							buffer_out,
-							sphereDataConfig->spectral_modes_n_max+1-std::abs(m)	// size of block (same as for SPHSolver)
-					);
+			int block_size = sphereDataConfig->spectral_modes_n_max+1-std::abs(m);
+
+			const std::vector<T> &lapack_data = lu_lapack_data[m+sphereDataConfig->spectral_modes_m_max];
+
+			if (lapack_data.size() > 0)
+			{
+				std::copy(buffer_in, buffer_in+block_size, buffer_out);
+
+				LapackBandedMatrixSolver< std::complex<double> >::solve_BandedLapackArray_factorized(
+								lapack_data.data(),
+								lhs.LDAB,
+								block_size,
+								lhs.halosize_off_diagonal,
+								lhs.halosize_off_diagonal,
+								lu_lapack_ipiv[m+sphereDataConfig->spectral_modes_m_max].data(),
+								buffer_out
+						);
+			}
+			else
+			{
+				p_solveBlock(
+								&lu_data[idx*(2*lu_chain_bandwidth+1)],
+								m,
+								block_size,
+								buffer_in,
+								buffer_out
+						);
+			}
 
 
 			/*
@@ -570,4 +908,23 @@ public:
 };
 
 
+
+#ifndef SWEET_REXI_SOLVER_SINGLE_PRECISION
+#	define SWEET_REXI_SOLVER_SINGLE_PRECISION 0
+#endif
+
+/**
+ * Solver for the REXI terms.
+ *
+ * With SWEET_REXI_SOLVER_SINGLE_PRECISION, the LU decompositions are
+ * stored and applied in single precision, the matrix assembly
+ * and the REXI sum stay in double precision.
+ */
+#if SWEET_REXI_SOLVER_SINGLE_PRECISION
+typedef SphBandedMatrixPhysicalComplex< std::complex<double>, std::complex<float> > SphBandedMatrixPhysicalComplexREXI;
+#else
+typedef SphBandedMatrixPhysicalComplex< std::complex<double> > SphBandedMatrixPhysicalComplexREXI;
+#endif
+
+
 #endif /* SRC_INCLUDE_SPH_SPHSOLVER_HPP_ */
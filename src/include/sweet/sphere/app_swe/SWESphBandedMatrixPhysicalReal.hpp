@@ -477,6 +477,7 @@ public:
 	)
 	{
 		SphereData out(sphereDataConfig);
+		out.spectral_alloc_buffer();
 
 		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
 		{
@@ -510,6 +511,7 @@ public:
 		i_rhs.request_data_spectral();
 
 		SphereData out(sphereDataConfig);
+		out.spectral_alloc_buffer();
 
 		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
 		{
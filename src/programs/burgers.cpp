@@ -18,7 +18,7 @@
 #include <sweet/plane/Convert_ScalarDataArray_to_PlaneData.hpp>
 #include <sweet/FatalError.hpp>
 
-#include "burgers/burgers_HelmholtzSolver.hpp"
+#include <sweet/plane/PlaneDataHelmholtzMultigrid.hpp>
 
 #include <sweet/Stopwatch.hpp>
 #include <ostream>
@@ -36,6 +36,10 @@
 #	include <parareal/Parareal.hpp>
 #endif
 
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
+
 
 #ifndef SWEET_PARAREAL
 #error "ACTIVATE PARAREAL compile option!"
@@ -67,6 +71,14 @@ class SimulationInstance
 #endif
 {
 public:
+	/*
+	 * Each instance works on its own copy of the simulation variables
+	 * since Parareal time slices might be executed concurrently
+	 * (see Parareal_Controller_Threaded)
+	 */
+	SimulationVariables simVars = ::simVars;
+	bool param_semilagrangian = ::param_semilagrangian;
+
 	// Prognostic variables
 	PlaneData prog_u, prog_v;
 
@@ -128,6 +140,9 @@ public:
 	// Semi-Lag stuff
 	SemiLagrangian semiLagrangian;
 
+	// Helmholtz solver for implicit diffusion with finite differences
+	PlaneDataHelmholtzMultigrid helmholtzMultigrid;
+
 
 	/**
 	 * Two dimensional Burgers equation
@@ -226,6 +241,9 @@ public:
 			exit(1);
 		}
 
+		if (!simVars.disc.use_spectral_basis_diffs)
+			helmholtzMultigrid.setup(planeDataConfig, simVars.sim.domain_size);
+
 		if (param_use_staggering && param_compute_error)
 			std::cerr << "Warning: Staggered data will be interpolated to/from A-grid for exact linear solution" << std::endl;
 
@@ -507,6 +525,7 @@ public:
 
 		if (simVars.disc.use_spectral_basis_diffs) //spectral
 		{
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
 			PlaneData lhs = u;
 			if (param_semilagrangian)
 			{
@@ -514,54 +533,29 @@ public:
 			}else{
 				lhs = ((-t)*simVars.sim.viscosity*(op.diff2_c_x + op.diff2_c_y)).spectral_addScalarAll(1.0);
 			}
+#else
+			FatalError("Spectral space not available, use finite differences");
+#endif
 
 #if 1   // solving the system directly by inverting the left hand side operator
+#	if SWEET_USE_PLANE_SPECTRAL_SPACE
 			io_u = rhs_u.spectral_div_element_wise(lhs);
 			io_v = rhs_v.spectral_div_element_wise(lhs);
-		} else { //Jacobi
+#	endif
+		}
+		else
+		{
 			/*
-			 * TODO:
-			 * set these values non manually
+			 * Solve (1 - t*nu*D2) u = rhs with the finite-difference Laplacian
 			 */
+			double eps = 1e-10;
+			int max_vcycles = 100;
 
-			FatalError("NOT available");
-/*
-			bool retval=false;
-			int max_iters = 26000;
-			double eps = 1e-7;
-			double* domain_size = simVars.sim.domain_size;
-			double omega = 1.0;
-			retval = burgers_HelmholtzSolver::smoother_jacobi( // Velocity u
-										simVars.sim.viscosity*t,
-										rhs_u,
-										io_u,
-										domain_size,
-										eps,
-										max_iters,
-										omega,
-										0
-									);
-			if (!retval)
-			{
-				std::cout << "Did not converge!!!" << std::endl;
-				exit(-1);
-			}
-			retval = burgers_HelmholtzSolver::smoother_jacobi( // Velocity v
-										simVars.sim.viscosity*t,
-										rhs_v,
-										io_v,
-										domain_size,
-										eps,
-										max_iters,
-										omega,
-										0
-									);
-			if (!retval)
-			{
-				std::cout << "Did not converge!!!" << std::endl;
-				exit(-1);
-			}
-*/
+			if (!helmholtzMultigrid.solve(1.0, t*simVars.sim.viscosity, rhs_u, io_u, eps, max_vcycles, simVars.misc.verbosity))
+				FatalError("Multigrid solver for u did not converge");
+
+			if (!helmholtzMultigrid.solve(1.0, t*simVars.sim.viscosity, rhs_v, io_v, eps, max_vcycles, simVars.misc.verbosity))
+				FatalError("Multigrid solver for v did not converge");
 		}
 
 
@@ -1348,6 +1342,10 @@ int main(int i_argc, char *i_argv[])
 	std::cout << "Compiled for MIC" << std::endl;
 #endif
 
+#if SWEET_MPI
+	MPI_Init(&i_argc, &i_argv);
+#endif
+
 	MemBlockAlloc::setup();
 
 	// program specific input parameter names
@@ -1401,13 +1399,36 @@ int main(int i_argc, char *i_argv[])
 			 * Allocate parareal controller and provide class
 			 * which implement the parareal features
 			 */
-			Parareal_Controller_Serial<SimulationInstance> parareal_Controller_Serial;
+#if SWEET_PARAREAL == 2
+			Parareal_Controller_MPI<SimulationInstance> parareal_Controller_MPI;
 
-			// setup controller. This initializes several simulation instances
-			parareal_Controller_Serial.setup(&simVars.parareal);
+			// setup controller. This initializes the simulation instances of this rank
+			parareal_Controller_MPI.setup(&simVars.parareal);
 
 			// execute the simulation
-			parareal_Controller_Serial.run();
+			parareal_Controller_MPI.run();
+#else
+			if (simVars.parareal.threaded)
+			{
+				Parareal_Controller_Threaded<SimulationInstance> parareal_Controller_Threaded;
+
+				// setup controller. This initializes several simulation instances
+				parareal_Controller_Threaded.setup(&simVars.parareal);
+
+				// execute the simulation
+				parareal_Controller_Threaded.run();
+			}
+			else
+			{
+				Parareal_Controller_Serial<SimulationInstance> parareal_Controller_Serial;
+
+				// setup controller. This initializes several simulation instances
+				parareal_Controller_Serial.setup(&simVars.parareal);
+
+				// execute the simulation
+				parareal_Controller_Serial.run();
+			}
+#endif
 		}
 		else
 #endif
@@ -1423,6 +1444,7 @@ int main(int i_argc, char *i_argv[])
 #endif
 		{
 			SimulationInstance *simulationBurgers = new SimulationInstance;
+			SimulationVariables &simVars = simulationBurgers->simVars;
 			//Setting initial conditions and workspace - in case there is no GUI
 
 			simulationBurgers->reset();
@@ -1503,5 +1525,9 @@ int main(int i_argc, char *i_argv[])
 		}
 	}
 
+#if SWEET_MPI
+	MPI_Finalize();
+#endif
+
 	return 0;
 }
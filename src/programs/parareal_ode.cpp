@@ -16,6 +16,14 @@
 #include <parareal/Parareal_Data.hpp>
 #include <parareal/Parareal_Data_Scalar.hpp>
 #include <parareal/Parareal_Controller_Serial.hpp>
+#include <parareal/Parareal_Controller_Threaded.hpp>
+#if SWEET_PARAREAL == 2
+#	include <parareal/Parareal_Controller_MPI.hpp>
+#endif
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
 
 #include <sweet/sweetmath.hpp>
 #include <sweet/SimulationVariables.hpp>
@@ -336,6 +344,10 @@ public:
 
 int main(int i_argc, char *i_argv[])
 {
+#if SWEET_MPI
+	MPI_Init(&i_argc, &i_argv);
+#endif
+
 	const char *bogus_var_names[] = {
 		"parareal-fine-dt",
 		"parareal-function-param-y0",
@@ -398,15 +410,41 @@ int main(int i_argc, char *i_argv[])
 	 * Allocate parareal controller and provide class
 	 * which implement the parareal features
 	 */
+#if SWEET_PARAREAL == 2
+	Parareal_Controller_MPI<SimulationInstance> parareal_Controller_MPI;
 
-	Parareal_Controller_Serial<SimulationInstance> parareal_Controller_Serial;
+	// setup controller. This initializes the simulation instances of this rank
+	parareal_Controller_MPI.setup(&simVars.parareal);
 
-	// setup controller. This initializes several simulation instances
-	parareal_Controller_Serial.setup(&simVars.parareal);
+	// execute the simulation
+	parareal_Controller_MPI.run();
+#else
+	if (simVars.parareal.threaded)
+	{
+		Parareal_Controller_Threaded<SimulationInstance> parareal_Controller_Threaded;
 
+		// setup controller. This initializes several simulation instances
+		parareal_Controller_Threaded.setup(&simVars.parareal);
 
-	// execute the simulation
-	parareal_Controller_Serial.run();
+		// execute the simulation
+		parareal_Controller_Threaded.run();
+	}
+	else
+	{
+		Parareal_Controller_Serial<SimulationInstance> parareal_Controller_Serial;
+
+		// setup controller. This initializes several simulation instances
+		parareal_Controller_Serial.setup(&simVars.parareal);
+
+
+		// execute the simulation
+		parareal_Controller_Serial.run();
+	}
+#endif
+
+#if SWEET_MPI
+	MPI_Finalize();
+#endif
 
 	return 0;
 }
@@ -0,0 +1,84 @@
+/*
+ * rexi_gen_coefficients.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ *
+ * Offline generator for the REXI coefficient cache.
+ *
+ * Computes the REXI coefficients for the REXI parameters given on the
+ * command line and writes them to the cache directory given by --rexi-cache-dir.
+ * Simulation runs with the same parameters and cache directory then
+ * load the coefficients instead of computing them.
+ *
+ * Example:
+ *   ./build/rexi_gen_coefficients --rexi-cache-dir=./rexi_cache --rexi-h=0.2 --rexi-m=1024 --rexi-half=1 --rexi-normalization=1
+ */
+
+#include <iostream>
+#include <rexi/REXI.hpp>
+#include <rexi/REXICoefficientCache.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/Stopwatch.hpp>
+
+
+SimulationVariables simVars;
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	const char *bogus_var_names[] = {
+			"phi-id",			/// ID of phi function
+			"use-quad",			/// Use quad precision to evaluate the coefficients
+			nullptr
+	};
+
+	simVars.bogus.var[0] = 0;
+	simVars.bogus.var[1] = 0;
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, bogus_var_names))
+	{
+		std::cout << std::endl;
+		std::cout << "	--phi-id [0/1]	Phi function to approximate (default: 0)" << std::endl;
+		std::cout << "	--use-quad [0/1]	Evaluate coefficients in quad precision (default: 0)" << std::endl;
+		return -1;
+	}
+
+	int phi_id = simVars.bogus.var[0];
+	bool use_quad = simVars.bogus.var[1];
+
+	if (simVars.rexi.rexi_coefficient_cache_dir == "")
+	{
+		std::cerr << "No cache directory given, use --rexi-cache-dir" << std::endl;
+		return -1;
+	}
+
+	simVars.rexi.outputConfig();
+
+	REXICoefficientCache::setCacheDirectory(simVars.rexi.rexi_coefficient_cache_dir);
+
+	Stopwatch stopwatch;
+	stopwatch.start();
+
+	std::size_t num_poles;
+	if (use_quad)
+	{
+		REXI<__float128, double> rexi(phi_id, simVars.rexi.rexi_h, simVars.rexi.rexi_M, simVars.rexi.rexi_L, simVars.rexi.rexi_use_half_poles, simVars.rexi.rexi_normalization);
+		num_poles = rexi.alpha.size();
+	}
+	else
+	{
+		REXI<double, double> rexi(phi_id, simVars.rexi.rexi_h, simVars.rexi.rexi_M, simVars.rexi.rexi_L, simVars.rexi.rexi_use_half_poles, simVars.rexi.rexi_normalization);
+		num_poles = rexi.alpha.size();
+	}
+
+	stopwatch.stop();
+
+	std::cout << "Number of poles: " << num_poles << std::endl;
+	std::cout << "Seconds for coefficients: " << stopwatch() << std::endl;
+
+	return 0;
+}
@@ -17,6 +17,7 @@
 #include <sweet/plane/PlaneDataSemiLagrangian.hpp>
 #include <sweet/Stopwatch.hpp>
 #include <sweet/FatalError.hpp>
+#include <sweet/Checkpoint.hpp>
 #include <benchmarks_plane/SWEPlaneBenchmarks.hpp>
 #include <ostream>
 #include <algorithm>
@@ -24,13 +25,19 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <random>
+#include <vector>
 #include "swe_rexi/SWE_Plane_REXI.hpp"
+#include <sweet/plane/PlaneDataConfigRegistry.hpp>
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+#	include "swe_rexi/SWE_Plane_SDC.hpp"
+#endif
 
 
 
-// Plane data config
-PlaneDataConfig planeDataConfigInstance;
-PlaneDataConfig *planeDataConfig = &planeDataConfigInstance;
+// Plane data config, shared with the REXI solver via the registry
+PlaneDataConfig *planeDataConfig = nullptr;
 
 
 
@@ -68,6 +75,18 @@ bool param_linear_exp_analytical;
 double param_initial_freq_x_mul;
 double param_initial_freq_y_mul;
 
+// SDC / PFASST
+int param_sdc_nodes;
+int param_sdc_node_type;
+int param_sdc_iterations;
+int param_pfasst_levels;
+int param_pfasst_slices;
+double param_pfasst_tolerance;
+
+// Ensemble
+int param_ensemble_members;
+double param_ensemble_perturbation;
+
 //Diagnostic measures at initial stage
 double diagnostics_energy_start, diagnostics_mass_start, diagnostics_potential_entrophy_start;
 
@@ -80,9 +99,37 @@ class SimulationInstance
 #endif
 {
 public:
+	// Simulation variables of this instance (time control, diagnostics, etc.)
+	SimulationVariables simVars = ::simVars;
+
+	// Ensemble member id, 0 for the unperturbed member
+	int ensemble_member_id;
+
+	// Instance providing the operators and REXI solver, nullptr if owned by this instance
+	SimulationInstance *shared_instance;
+
 	// Prognostic variables
 	PlaneData prog_h, prog_u, prog_v;
 
+	/**
+	 * Statistics of h, u, v computed in a single pass over the fields.
+	 *
+	 * These are shared by the time step size control and the instability check.
+	 */
+	class FieldStatistics
+	{
+	public:
+		double max_abs_u = 0;
+		double max_abs_v = 0;
+		bool all_finite = true;
+	};
+
+	// Statistics of the prognostic variables, updated after each time step
+	FieldStatistics prog_stats;
+
+	// Update prog_stats in run_timestep(), disabled if the caller updates them for several instances at once
+	bool update_prog_stats_in_timestep = true;
+
 	// beta plane
 	PlaneData beta_plane;
 
@@ -155,13 +202,20 @@ public:
 	double benchmark_analytical_error_maxabs_v;
 
 	// Finite difference operators
-	PlaneOperators op;
+	PlaneOperators op_instance;
+	PlaneOperators &op;
 
 	// Runge-Kutta stuff
 	PlaneDataTimesteppingRK timestepping;
 
 	// Rexi stuff
-	SWE_Plane_REXI swe_plane_rexi;
+	SWE_Plane_REXI swe_plane_rexi_instance;
+	SWE_Plane_REXI &swe_plane_rexi;
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+	// SDC / PFASST stuff
+	SWE_Plane_SDC swe_plane_sdc;
+#endif
 
 	// Interpolation stuff
 	PlaneDataSampler sampler2D;
@@ -170,8 +224,18 @@ public:
 	SemiLagrangian semiLagrangian;
 
 public:
-	SimulationInstance()	:
-	// Constructor to initialize the class - all variables in the SW are setup
+	/**
+	 * Constructor to initialize the class - all variables in the SW are setup
+	 *
+	 * Members of an ensemble provide the first member as i_shared_instance
+	 * to reuse its read-only operators and REXI solver.
+	 */
+	SimulationInstance(
+			SimulationInstance *i_shared_instance = nullptr,
+			int i_ensemble_member_id = 0
+	)	:
+		ensemble_member_id(i_ensemble_member_id),
+		shared_instance(i_shared_instance),
 
 		// Variable dimensions (mem. allocation)
 		prog_h(planeDataConfig),
@@ -228,7 +292,8 @@ public:
 
 
 		// Initialises operators
-		op(planeDataConfig, simVars.sim.domain_size, simVars.disc.use_spectral_basis_diffs)
+		op(i_shared_instance == nullptr ? op_instance : i_shared_instance->op),
+		swe_plane_rexi(i_shared_instance == nullptr ? swe_plane_rexi_instance : i_shared_instance->swe_plane_rexi)
 #if SWEET_PARAREAL != 0
 		,
 		_parareal_data_start_h(planeDataConfig), _parareal_data_start_u(planeDataConfig), _parareal_data_start_v(planeDataConfig),
@@ -238,6 +303,9 @@ public:
 		_parareal_data_error_h(planeDataConfig), _parareal_data_error_u(planeDataConfig), _parareal_data_error_v(planeDataConfig)
 #endif
 	{
+		if (shared_instance == nullptr)
+			op_instance.setup(planeDataConfig, simVars.sim.domain_size, simVars.disc.use_spectral_basis_diffs);
+
 		// Calls initialisation of the run (e.g. sets u, v, h)
 		reset();
 
@@ -385,7 +453,7 @@ public:
 		) -> double
 		{
 			if (param_initial_freq_x_mul == 0)
-				return SWEPlaneBenchmarks::return_h(simVars, x, y);
+				return SWEPlaneBenchmarks::return_h(i_parameters, x, y);
 
 			// Waves scenario
 			// Remember to set up initial_freq_x_mul and initial_freq_y_mul
@@ -402,7 +470,7 @@ public:
 		) -> double
 		{
 			if (param_initial_freq_x_mul == 0)
-				return SWEPlaneBenchmarks::return_u(simVars, x, y);
+				return SWEPlaneBenchmarks::return_u(i_parameters, x, y);
 
 			double dx = x/i_parameters.sim.domain_size[0]*param_initial_freq_x_mul*M_PIl;
 			double dy = y/i_parameters.sim.domain_size[1]*param_initial_freq_y_mul*M_PIl;
@@ -417,7 +485,7 @@ public:
 		) -> double
 		{
 			if (param_initial_freq_x_mul == 0)
-				return SWEPlaneBenchmarks::return_v(simVars, x, y);
+				return SWEPlaneBenchmarks::return_v(i_parameters, x, y);
 
 			double dx = x/i_parameters.sim.domain_size[0]*param_initial_freq_x_mul*M_PIl;
 			double dy = y/i_parameters.sim.domain_size[1]*param_initial_freq_y_mul*M_PIl;
@@ -651,6 +719,28 @@ public:
 			}
 		}
 
+		// Perturb height of ensemble members with a smooth wave of random phase
+		if (ensemble_member_id > 0 && param_ensemble_perturbation != 0)
+		{
+			std::mt19937 generator(ensemble_member_id);
+			std::uniform_real_distribution<double> distribution(0, 2.0*M_PI);
+			double phase_x = distribution(generator);
+			double phase_y = distribution(generator);
+
+			PlaneData perturbation(planeDataConfig);
+			perturbation.physical_update_lambda_array_indices(
+				[&](int i, int j, double &io_data)
+				{
+					double x = ((double)i+0.5)/(double)simVars.disc.res_physical[0];
+					double y = ((double)j+0.5)/(double)simVars.disc.res_physical[1];
+					io_data = param_ensemble_perturbation*std::sin(2.0*M_PI*x + phase_x)*std::sin(2.0*M_PI*y + phase_y);
+				}
+			);
+
+			prog_h = prog_h + perturbation;
+			t0_prog_h = t0_prog_h + perturbation;
+		}
+
 
 		// Print info for REXI and setup REXI
 		if (param_timestepping_mode == 1 || param_timestepping_mode == 3 || param_timestepping_mode == 5)
@@ -661,22 +751,24 @@ public:
 				std::cout << "REXI: Using M=" << simVars.rexi.rexi_M << ", L=" << simVars.rexi.rexi_L << ", poles and sampling size h=" << simVars.rexi.rexi_h << std::endl;
 			}
 
-			if (simVars.sim.CFL >= 0)
+			if (simVars.sim.CFL >= 0 && param_timestepping_mode != 1)
 			{
-				std::cout << "Only constant time step size supported with REXI, use negative CFL to set constant time step size" << std::endl;
+				std::cout << "Only constant time step size supported with implicit time stepping, use negative CFL to set constant time step size" << std::endl;
 				exit(1);
 			}
 
-			// use REXI
-			swe_plane_rexi.setup(
-					simVars.rexi.rexi_h,
-					simVars.rexi.rexi_M,
-					simVars.rexi.rexi_L,
-					planeDataConfig,
-					simVars.sim.domain_size,
-					simVars.rexi.rexi_use_half_poles,
-					simVars.rexi.rexi_normalization
-			);
+			// use REXI, unless it's provided by another ensemble member
+			if (shared_instance == nullptr)
+				swe_plane_rexi.setup(
+						simVars.rexi.rexi_h,
+						simVars.rexi.rexi_M,
+						simVars.rexi.rexi_L,
+						planeDataConfig,
+						simVars.sim.domain_size,
+						simVars.rexi.rexi_use_half_poles,
+						simVars.rexi.rexi_normalization,
+						simVars.rexi.rexi_rebalance_ranks
+				);
 
 			if (simVars.misc.verbosity > 2)
 			{
@@ -694,6 +786,33 @@ public:
 			}
 		}
 
+		if (param_timestepping_mode == 6)
+		{
+			if (simVars.misc.use_nonlinear_equations > 0)
+				FatalError("SDC only supports the linear SWE");
+
+			if (simVars.sim.CFL >= 0)
+				FatalError("Only constant time step size supported with SDC, use negative CFL to set constant time step size");
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+			swe_plane_sdc.setup(
+					planeDataConfig,
+					simVars,
+					(simVars.sim.beta == 0.0 ? nullptr : &beta_plane),
+					param_sdc_nodes,
+					param_sdc_node_type,
+					param_sdc_iterations,
+					param_pfasst_levels,
+					param_pfasst_slices,
+					param_pfasst_tolerance
+			);
+#else
+			FatalError("SDC requires spectral space");
+#endif
+		}
+
+		p_update_prog_statistics();
+
 		// Print output info (if gui is disabled, this is done in main
 		if (simVars.misc.gui_enabled)
 			timestep_output();
@@ -843,6 +962,59 @@ public:
 		}
 	}
 
+	/**
+	 * Compute max |u|, max |v| and whether all values are finite
+	 * with a single OpenMP reduction over the physical data
+	 */
+	static
+	FieldStatistics p_compute_field_statistics(
+			const PlaneData &i_h,
+			const PlaneData &i_u,
+			const PlaneData &i_v
+	)
+	{
+		PlaneData* fields[3] = {(PlaneData*)&i_h, (PlaneData*)&i_u, (PlaneData*)&i_v};
+		PlaneData::request_data_physical_batch(fields, 3);
+
+		const double *h = i_h.physical_space_data;
+		const double *u = i_u.physical_space_data;
+		const double *v = i_v.physical_space_data;
+
+		double max_abs_u = 0;
+		double max_abs_v = 0;
+		bool all_finite = true;
+
+#if SWEET_THREADING
+#pragma omp parallel for proc_bind(close) reduction(max:max_abs_u,max_abs_v) reduction(&&:all_finite)
+#endif
+		for (std::size_t i = 0; i < i_h.planeDataConfig->physical_array_data_number_of_elements; i++)
+		{
+			all_finite = all_finite && std::isfinite(h[i]) && std::isfinite(u[i]) && std::isfinite(v[i]);
+
+			max_abs_u = std::max(max_abs_u, std::abs(u[i]));
+			max_abs_v = std::max(max_abs_v, std::abs(v[i]));
+		}
+
+		FieldStatistics stats;
+		stats.max_abs_u = max_abs_u;
+		stats.max_abs_v = max_abs_v;
+		stats.all_finite = all_finite;
+		return stats;
+	}
+
+
+	/**
+	 * Update the statistics of the prognostic variables.
+	 *
+	 * This has to be called each time the prognostic variables are
+	 * overwritten (time step, initial conditions, restart).
+	 */
+	void p_update_prog_statistics()
+	{
+		prog_stats = p_compute_field_statistics(prog_h, prog_u, prog_v);
+	}
+
+
 	// Main routine for method to be used in case of finite differences
 	void p_run_euler_timestep_update(
 			const PlaneData &i_h,	///< prognostic variables
@@ -1069,6 +1241,83 @@ public:
 	}
 
 
+	/**
+	 * Return the time step size for REXI time stepping with CFL >= 0.
+	 *
+	 * REXI integrates the linear parts exactly, hence the CFL condition
+	 * is only used for the advection of the nonlinear equations and for the
+	 * gravity waves of the linear equations. The time step size is further
+	 * limited to the range of frequencies which are approximated by REXI.
+	 *
+	 * The time step size is snapped to a few values (see --rexi-dt-snap)
+	 * so that the REXI solvers can be reused and it is shortened to hit
+	 * the next output time and the end of the simulation.
+	 */
+	double p_get_rexi_timestep_size()
+	{
+		if (simVars.sim.CFL < 0)
+			return -simVars.sim.CFL;
+
+		double min_cell_size = std::min(simVars.disc.cell_size[0], simVars.disc.cell_size[1]);
+		double gh0 = simVars.sim.gravitation*simVars.sim.h0;
+
+		// largest frequency of the linear operator: gravity waves with the largest wave number and Coriolis
+		double k0 = M_PI/simVars.disc.cell_size[0];
+		double k1 = M_PI/simVars.disc.cell_size[1];
+		double max_frequency = std::sqrt(gh0*(k0*k0 + k1*k1) + simVars.sim.f0*simVars.sim.f0);
+
+		double dt = simVars.rexi.getMaxTimestepSize(max_frequency);
+
+		if (simVars.misc.use_nonlinear_equations > 0)
+		{
+			double max_vel = std::max(prog_stats.max_abs_u, prog_stats.max_abs_v);
+
+			if (max_vel > 0)
+				dt = std::min(dt, simVars.sim.CFL*min_cell_size/max_vel);
+		}
+		else if (gh0 > 0)
+		{
+			dt = std::min(dt, simVars.sim.CFL*min_cell_size/std::sqrt(gh0));
+		}
+
+		dt = simVars.rexi.snapTimestepSize(dt);
+
+		if (simVars.misc.output_each_sim_seconds > 0)
+			dt = std::min(dt, simVars.misc.output_next_sim_seconds-simVars.timecontrol.current_simulation_time);
+
+		if (simVars.timecontrol.max_simulation_time >= 0)
+			dt = std::min(dt, simVars.timecontrol.max_simulation_time-simVars.timecontrol.current_simulation_time);
+
+		if (!(dt > 0) || std::isinf(dt))
+			FatalError("Unable to determine REXI time step size, set max simulation time or use negative CFL to set constant time step size");
+
+		return dt;
+	}
+
+
+
+	/**
+	 * Rescale the fields of the previous time step used for the SETTLS extrapolation
+	 * if the time step size changed:
+	 * prev = cur + (prev-cur)*dt_new/dt_old
+	 */
+	void p_rescale_prev_timestep(
+			double i_dt
+	)
+	{
+		double dt_old = simVars.timecontrol.current_timestep_size;
+
+		if (dt_old <= 0 || dt_old == i_dt)
+			return;
+
+		double s = i_dt/dt_old;
+		prog_h_prev = prog_h + (prog_h_prev-prog_h)*s;
+		prog_u_prev = prog_u + (prog_u_prev-prog_u)*s;
+		prog_v_prev = prog_v + (prog_v_prev-prog_v)*s;
+	}
+
+
+
 	/**
 	 * Execute a single simulation time step
 	 */
@@ -1096,12 +1345,13 @@ public:
 		}
 		else if (param_timestepping_mode == 1) //REXI
 		{
-			assert(simVars.sim.CFL < 0);
-			o_dt = -simVars.sim.CFL;
+			o_dt = p_get_rexi_timestep_size();
 
 			// REXI time stepping for nonlinear eq - semi-lagrangian scheme (SL-REXI)
 			if (simVars.misc.use_nonlinear_equations > 0)
 			{
+				p_rescale_prev_timestep(o_dt);
+
 				swe_plane_rexi.run_timestep_slrexi(
 									prog_h, prog_u, prog_v,
 									prog_h_prev, prog_u_prev, prog_v_prev,
@@ -1207,6 +1457,23 @@ public:
 					semiLagrangian
 			);
 		}
+		else if (param_timestepping_mode == 6)
+		{	// IMEX SDC / PFASST, each call computes several time slices
+			assert(simVars.sim.CFL < 0);
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+			int iterations = swe_plane_sdc.run_timestep(
+					prog_h, prog_u, prog_v,
+					-simVars.sim.CFL,
+					simVars.timecontrol.current_simulation_time
+			);
+
+			if (simVars.misc.verbosity > 1)
+				std::cout << "SDC/PFASST iterations: " << iterations << std::endl;
+
+			o_dt = -simVars.sim.CFL*swe_plane_sdc.num_slices;
+#endif
+		}
 		else
 		{
 			std::cerr << "Invalid time stepping method" << std::endl;
@@ -1230,6 +1497,10 @@ public:
 #endif
 		}
 
+		// single pass over the new prognostic variables for the time step size control and the instability check
+		if (update_prog_stats_in_timestep)
+			p_update_prog_statistics();
+
 		// advance time step and provide information to parameters
 		simVars.timecontrol.current_timestep_size = o_dt;
 		simVars.timecontrol.current_simulation_time += o_dt;
@@ -1241,6 +1512,130 @@ public:
 	}
 
 
+
+	/**
+	 * Append the prognostic variables which are directly processed
+	 * in spectral space by the chosen time stepping method
+	 */
+	void get_spectral_prognostic_variables(
+			std::vector<PlaneData*> &o_variables
+	)
+	{
+		// the direct solution (2) and implicit time stepping (3) start with the physical data
+		bool spectral =
+				(param_timestepping_mode == 0 && simVars.disc.use_spectral_basis_diffs && simVars.misc.use_nonlinear_equations == 0) ||
+				param_timestepping_mode == 6;
+
+		if (!spectral)
+			return;
+
+		o_variables.push_back(&prog_h);
+		o_variables.push_back(&prog_u);
+		o_variables.push_back(&prog_v);
+	}
+
+
+
+	/**
+	 * Write the full state of the simulation to a checkpoint file.
+	 *
+	 * This includes the previous prognostic variables which are required
+	 * by the semi-Lagrangian methods (SETTLS), the statistics of the
+	 * prognostic variables and the output schedule.
+	 * All other variables (forcings, initial conditions for the analytical
+	 * solution, etc.) are recomputed by reset().
+	 */
+	void checkpoint_write(
+			const std::string &i_filename
+	)
+	{
+		CheckpointWriter cp(i_filename);
+
+		cp.write("res_physical", simVars.disc.res_physical);
+		cp.write("timestepping_mode", param_timestepping_mode);
+
+		cp.write("current_timestep_nr", simVars.timecontrol.current_timestep_nr);
+		cp.write("current_timestep_size", simVars.timecontrol.current_timestep_size);
+		cp.write("current_simulation_time", simVars.timecontrol.current_simulation_time);
+		cp.write("output_next_sim_seconds", simVars.misc.output_next_sim_seconds);
+
+		cp.write("diagnostics_energy_start", diagnostics_energy_start);
+		cp.write("diagnostics_mass_start", diagnostics_mass_start);
+		cp.write("diagnostics_potential_entrophy_start", diagnostics_potential_entrophy_start);
+
+		cp.write("prog_stats", prog_stats);
+
+		cp.write_data("prog_h", prog_h);
+		cp.write_data("prog_u", prog_u);
+		cp.write_data("prog_v", prog_v);
+
+		cp.write_data("prog_h_prev", prog_h_prev);
+		cp.write_data("prog_u_prev", prog_u_prev);
+		cp.write_data("prog_v_prev", prog_v_prev);
+
+		cp.close();
+	}
+
+
+
+	/**
+	 * Restore the state of the simulation from a checkpoint file.
+	 *
+	 * reset() has to be called before.
+	 */
+	void checkpoint_read(
+			const std::string &i_filename
+	)
+	{
+		CheckpointReader cp(i_filename);
+
+		int res_physical[2];
+		cp.read("res_physical", res_physical);
+		if (res_physical[0] != simVars.disc.res_physical[0] || res_physical[1] != simVars.disc.res_physical[1])
+			FatalError("Resolution of checkpoint does not match resolution of simulation");
+
+		int timestepping_mode;
+		cp.read("timestepping_mode", timestepping_mode);
+		if (timestepping_mode != param_timestepping_mode)
+			FatalError("Time stepping mode of checkpoint does not match time stepping mode of simulation");
+
+		cp.read("current_timestep_nr", simVars.timecontrol.current_timestep_nr);
+		cp.read("current_timestep_size", simVars.timecontrol.current_timestep_size);
+		cp.read("current_simulation_time", simVars.timecontrol.current_simulation_time);
+		cp.read("output_next_sim_seconds", simVars.misc.output_next_sim_seconds);
+
+		cp.read("diagnostics_energy_start", diagnostics_energy_start);
+		cp.read("diagnostics_mass_start", diagnostics_mass_start);
+		cp.read("diagnostics_potential_entrophy_start", diagnostics_potential_entrophy_start);
+
+		cp.read("prog_stats", prog_stats);
+
+		cp.read_data("prog_h", prog_h);
+		cp.read_data("prog_u", prog_u);
+		cp.read_data("prog_v", prog_v);
+
+		cp.read_data("prog_h_prev", prog_h_prev);
+		cp.read_data("prog_u_prev", prog_u_prev);
+		cp.read_data("prog_v_prev", prog_v_prev);
+
+		// force recomputation of diagnostics
+		last_timestep_nr_update_diagnostics = -1;
+	}
+
+
+
+	/**
+	 * Return true if timestep_output() writes output for the current time step
+	 */
+	bool timestep_output_required()
+	{
+		if (simVars.misc.output_each_sim_seconds < 0)
+			return false;
+
+		return simVars.misc.output_next_sim_seconds <= simVars.timecontrol.current_simulation_time;
+	}
+
+
 	/**
 	 * Write file to data and return string of file name
 	 */
@@ -1616,6 +2011,7 @@ public:
 			prog_h.file_physical_loadData("swe_rexi_dump_h.csv", simVars.setup.input_data_binary);
 			prog_u.file_physical_loadData("swe_rexi_dump_u.csv", simVars.setup.input_data_binary);
 			prog_v.file_physical_loadData("swe_rexi_dump_v.csv", simVars.setup.input_data_binary);
+			p_update_prog_statistics();
 			break;
 		}
 	}
@@ -1623,10 +2019,7 @@ public:
 
 	bool instability_detected()
 	{
-		return !(	prog_h.reduce_boolean_all_finite() &&
-					prog_u.reduce_boolean_all_finite() &&
-					prog_v.reduce_boolean_all_finite()
-				);
+		return !prog_stats.all_finite;
 	}
 
 
@@ -1782,6 +2175,7 @@ public:
 		prog_h = *parareal_data_start.data_arrays[0];
 		prog_u = *parareal_data_start.data_arrays[1];
 		prog_v = *parareal_data_start.data_arrays[2];
+		p_update_prog_statistics();
 
 		// reset simulation time
 		simVars.timecontrol.current_simulation_time = timeframe_start;
@@ -1826,6 +2220,7 @@ public:
 		prog_h = *parareal_data_start.data_arrays[0];
 		prog_u = *parareal_data_start.data_arrays[1];
 		prog_v = *parareal_data_start.data_arrays[2];
+		p_update_prog_statistics();
 
 		// run implicit time step
 //		assert(i_max_simulation_time < 0);
@@ -1975,6 +2370,157 @@ public:
 
 
 
+/**
+ * Run an ensemble of simulations with perturbed initial conditions in lockstep.
+ *
+ * All members share the operators and the REXI solver of the first member.
+ * The transformations of the prognostic variables before and after each
+ * time step and for the output are executed with a single batched FFT for
+ * all members, which utilizes the cores better for small resolutions.
+ * Transformations within the time steppers are still done for each field.
+ */
+void ensemble_run()
+{
+	if (simVars.sim.CFL >= 0)
+		FatalError("Ensembles require a constant time step size, use negative CFL to set it");
+
+	int num_members = param_ensemble_members;
+
+	std::vector<SimulationInstance*> members(num_members);
+
+	members[0] = new SimulationInstance;
+	for (int m = 1; m < num_members; m++)
+		members[m] = new SimulationInstance(members[0], m);
+
+	// the statistics for the instability check are updated for all members at once
+	for (int m = 0; m < num_members; m++)
+		members[m]->update_prog_stats_in_timestep = false;
+
+	// separate output files for each member
+	for (int m = 0; m < num_members; m++)
+	{
+		std::string &prefix = members[m]->simVars.misc.output_file_name_prefix;
+
+		std::size_t pos = prefix.find("%s");
+		if (pos != std::string::npos)
+			prefix.insert(pos+2, "_m"+std::to_string(m));
+	}
+
+	std::ostringstream buf;
+	buf << std::setprecision(14);
+
+	std::vector<PlaneData*> variables;
+
+	Stopwatch time;
+	time.reset();
+
+	bool instability = false;
+
+	// Main time loop
+	while (!instability)
+	{
+		/*
+		 * Output
+		 */
+		if (members[0]->timestep_output_required())
+		{
+			variables.clear();
+			for (int m = 0; m < num_members; m++)
+			{
+				variables.push_back(&members[m]->prog_h);
+				variables.push_back(&members[m]->prog_u);
+				variables.push_back(&members[m]->prog_v);
+			}
+			PlaneData::request_data_physical_batch(variables.data(), variables.size());
+
+			for (int m = 0; m < num_members; m++)
+			{
+				if (!members[m]->timestep_output(buf))
+					continue;
+
+				// prefix each line with the member id
+				std::istringstream lines(buf.str());
+				buf.str("");
+
+				std::string line;
+				while (std::getline(lines, line))
+					std::cout << "[" << m << "] " << line << std::endl;
+			}
+		}
+
+		// Stop simulation if requested
+		if (members[0]->should_quit())
+			break;
+
+		/*
+		 * Time step of all members
+		 */
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		variables.clear();
+		for (int m = 0; m < num_members; m++)
+			members[m]->get_spectral_prognostic_variables(variables);
+		PlaneData::request_data_spectral_batch(variables.data(), variables.size());
+#endif
+
+		for (int m = 0; m < num_members; m++)
+			members[m]->run_timestep();
+
+		variables.clear();
+		for (int m = 0; m < num_members; m++)
+		{
+			variables.push_back(&members[m]->prog_h);
+			variables.push_back(&members[m]->prog_u);
+			variables.push_back(&members[m]->prog_v);
+		}
+		PlaneData::request_data_physical_batch(variables.data(), variables.size());
+
+		for (int m = 0; m < num_members; m++)
+		{
+			members[m]->p_update_prog_statistics();
+
+			if (members[m]->instability_detected())
+			{
+				std::cout << "INSTABILITY DETECTED in ensemble member " << m << std::endl;
+				instability = true;
+				break;
+			}
+		}
+	}
+
+	time.stop();
+
+	double seconds = time();
+	SimulationVariables &simVars = members[0]->simVars;
+
+	std::cout << "Simulation time (seconds): " << seconds << std::endl;
+	std::cout << "Number of ensemble members: " << num_members << std::endl;
+	std::cout << "Number of time steps: " << simVars.timecontrol.current_timestep_nr << std::endl;
+	std::cout << "Time per time step: " << seconds/(double)simVars.timecontrol.current_timestep_nr << " sec/ts" << std::endl;
+	std::cout << "Time per time step and member: " << seconds/((double)simVars.timecontrol.current_timestep_nr*num_members) << " sec/ts" << std::endl;
+	std::cout << "Last time step size: " << simVars.timecontrol.current_timestep_size << std::endl;
+
+	if (param_compute_error && simVars.misc.use_nonlinear_equations == 0)
+	{
+		for (int m = 0; m < num_members; m++)
+		{
+			members[m]->compute_errors();
+			std::cout << "[" << m << "] DIAGNOSTICS ANALYTICAL RMS H:\t" << members[m]->benchmark_analytical_error_rms_h << std::endl;
+			std::cout << "[" << m << "] DIAGNOSTICS ANALYTICAL RMS U:\t" << members[m]->benchmark_analytical_error_rms_u << std::endl;
+			std::cout << "[" << m << "] DIAGNOSTICS ANALYTICAL RMS V:\t" << members[m]->benchmark_analytical_error_rms_v << std::endl;
+
+			std::cout << "[" << m << "] DIAGNOSTICS ANALYTICAL MAXABS H:\t" << members[m]->benchmark_analytical_error_maxabs_h << std::endl;
+			std::cout << "[" << m << "] DIAGNOSTICS ANALYTICAL MAXABS U:\t" << members[m]->benchmark_analytical_error_maxabs_u << std::endl;
+			std::cout << "[" << m << "] DIAGNOSTICS ANALYTICAL MAXABS V:\t" << members[m]->benchmark_analytical_error_maxabs_v << std::endl;
+		}
+	}
+
+	// members share data of the first one, hence delete it last
+	for (int m = num_members-1; m >= 0; m--)
+		delete members[m];
+}
+
+
+
 int main(int i_argc, char *i_argv[])
 {
 #if __MIC__
@@ -2009,6 +2555,14 @@ int main(int i_argc, char *i_argv[])
 			"initial-freq-x-mul",		/// frequency multipliers for special scenario setup
 			"initial-freq-y-mul",
 			"lin-exp-analyt",
+			"sdc-nodes",				/// SDC / PFASST parameters
+			"sdc-node-type",
+			"sdc-iterations",
+			"pfasst-levels",
+			"pfasst-slices",
+			"pfasst-tolerance",
+			"ensemble-members",			/// Ensemble parameters
+			"ensemble-perturbation",
 			nullptr
 	};
 
@@ -2020,19 +2574,38 @@ int main(int i_argc, char *i_argv[])
 	simVars.bogus.var[4] = 0;  //frequency in x for waves test case
 	simVars.bogus.var[5] = 0;  //frequency in y for waves test case
 	simVars.bogus.var[6] = 0;  // Use analytical linear operator exponential
+	simVars.bogus.var[7] = 3;	// SDC nodes
+	simVars.bogus.var[8] = 0;	// SDC node type - default is Gauss-Lobatto
+	simVars.bogus.var[9] = 3;	// SDC / PFASST iterations
+	simVars.bogus.var[10] = 1;	// PFASST levels
+	simVars.bogus.var[11] = 1;	// PFASST time slices
+	simVars.bogus.var[12] = -1;	// PFASST convergence tolerance - default is disabled
+	simVars.bogus.var[13] = 1;	// Ensemble members
+	simVars.bogus.var[14] = 0;	// Amplitude of height perturbation of ensemble members
 
 	// Help menu
 	if (!simVars.setupFromMainParameters(i_argc, i_argv, bogus_var_names))
 	{
 		std::cout << std::endl;
 		std::cout << "Special parameters:" << std::endl;
-		std::cout << "	--timestepping-mode [0/1/2/3/4/5]	Timestepping method to use" << std::endl;
+		std::cout << "	--timestepping-mode [0/1/2/3/4/5/6]	Timestepping method to use" << std::endl;
 		std::cout << "	                            0: RKn with Finite-difference (default)" << std::endl;
 		std::cout << "	                            1: REXI (SL-REXI if nonlinear)" << std::endl;
 		std::cout << "	                            2: Direct solution in spectral space" << std::endl;
 		std::cout << "	                            3: Implicit Euler Spectral " << std::endl;
 		std::cout << "	                            4: Semi-Lagrangian Advection only" << std::endl;
 		std::cout << "	                            5: Semi-Lagrangian Semi-implicit Spectral" << std::endl;
+		std::cout << "	                            6: IMEX SDC / PFASST Spectral - linear only" << std::endl;
+		std::cout << "" << std::endl;
+		std::cout << "	--sdc-nodes [int]		Number of SDC nodes (default=3)" << std::endl;
+		std::cout << "	--sdc-node-type [0/1]	SDC nodes: 0: Gauss-Lobatto (default), 1: Gauss-Radau" << std::endl;
+		std::cout << "	--sdc-iterations [int]	Number of SDC / PFASST iterations after the predictor (default=3)" << std::endl;
+		std::cout << "	--pfasst-levels [int]	Number of levels, each coarser level uses half of the modes (default=1)" << std::endl;
+		std::cout << "	--pfasst-slices [int]	Number of time slices computed by each time step (default=1)" << std::endl;
+		std::cout << "	--pfasst-tolerance [float]	Stop PFASST iterations if increments are below this value (default=-1, disabled)" << std::endl;
+		std::cout << "" << std::endl;
+		std::cout << "	--ensemble-members [int]	Number of ensemble members run in lockstep (default=1)" << std::endl;
+		std::cout << "	--ensemble-perturbation [float]	Amplitude of height perturbation of ensemble members > 0 (default=0)" << std::endl;
 		std::cout << "" << std::endl;
 		std::cout << "	--compute-error [0/1]	Compute the errors" << std::endl;
 		std::cout << "" << std::endl;
@@ -2058,6 +2631,9 @@ int main(int i_argc, char *i_argv[])
 #endif
 		return -1;
 	}
+
+	REXICoefficientCache::setCacheDirectory(simVars.rexi.rexi_coefficient_cache_dir);
+
 	// Method to be used
 	param_timestepping_mode = simVars.bogus.var[0];
 
@@ -2076,7 +2652,29 @@ int main(int i_argc, char *i_argv[])
 
 	param_linear_exp_analytical = simVars.bogus.var[6];
 
-	planeDataConfigInstance.setupAuto(simVars.disc.res_physical, simVars.disc.res_spectral);
+	param_sdc_nodes = simVars.bogus.var[7];
+	param_sdc_node_type = simVars.bogus.var[8];
+	param_sdc_iterations = simVars.bogus.var[9];
+	param_pfasst_levels = simVars.bogus.var[10];
+	param_pfasst_slices = simVars.bogus.var[11];
+	param_pfasst_tolerance = simVars.bogus.var[12];
+
+	param_ensemble_members = simVars.bogus.var[13];
+	param_ensemble_perturbation = simVars.bogus.var[14];
+
+	planeDataConfig = PlaneDataConfigRegistry::getConfig(
+			simVars.disc.res_physical[0],
+			simVars.disc.res_physical[1],
+			simVars.disc.res_spectral[0],
+			simVars.disc.res_spectral[1]
+		);
+
+	simVars.disc.res_physical[0] = planeDataConfig->physical_res[0];
+	simVars.disc.res_physical[1] = planeDataConfig->physical_res[1];
+#if SWEET_USE_LIBFFT
+	simVars.disc.res_spectral[0] = planeDataConfig->spectral_modes[0];
+	simVars.disc.res_spectral[1] = planeDataConfig->spectral_modes[1];
+#endif
 
 	// Print header
 	std::cout << std::endl;
@@ -2106,6 +2704,8 @@ int main(int i_argc, char *i_argv[])
 				std::cout << " 4: Semi-Lag - pure advection " << std::endl; break;
 		case 5:
 				std::cout << " 5: Semi-Lag Semi-Implicit Spectral " << std::endl; break;
+		case 6:
+				std::cout << " 6: IMEX SDC / PFASST Spectral - Linear only" << std::endl; break;
 		default:
 			std::cerr << "Timestepping unknowkn" << std::endl;
 			return -1;
@@ -2124,6 +2724,7 @@ int main(int i_argc, char *i_argv[])
 	std::cout << "Verbosity: " << simVars.misc.verbosity << std::endl;
 	std::cout << "Parareal: " << SWEET_PARAREAL << std::endl;
 	std::cout << "Linear exponential analytical: " << param_linear_exp_analytical << std::endl;
+	std::cout << "Ensemble members: " << param_ensemble_members << std::endl;
 	std::cout << std::endl;
 	std::cout << "simVars.rexi.rexi_h: " << simVars.rexi.rexi_h << std::endl;
 	std::cout << "simVars.rexi.rexi_M: " << simVars.rexi.rexi_M << std::endl;
@@ -2178,8 +2779,15 @@ int main(int i_argc, char *i_argv[])
 		}
 		else
 #endif
+		if (param_ensemble_members > 1)
+		{
+			ensemble_run();
+		}
+		else
 		{
 			SimulationInstance *simulationSWE = new SimulationInstance;
+			SimulationVariables &simVars = simulationSWE->simVars;
+
 			//Setting initial conditions and workspace - in case there is no GUI
 
 			simulationSWE->reset();
@@ -2202,9 +2810,27 @@ int main(int i_argc, char *i_argv[])
 #if SWEET_MPI
 			MPI_Barrier(MPI_COMM_WORLD);
 #endif
+			// Restart from checkpoint, this also restores the diagnostics from the initial stage
+			if (simVars.misc.restart_file_name != "")
+			{
+				simulationSWE->checkpoint_read(simVars.misc.restart_file_name);
+				std::cout << "Restarted from checkpoint '" << simVars.misc.restart_file_name << "' at simulation time " << simVars.timecontrol.current_simulation_time << std::endl;
+			}
+
 			//Start counting time
 			time.reset();
 
+			// Wallclock time of last checkpoint
+			Stopwatch checkpoint_time;
+
+
+			/*
+			 * Set if the time loop was stopped due to an instability.
+			 * The prognostic fields are not checked again after the loop
+			 * since this might transform them and the final checkpoint
+			 * has to be the state which continues the time loop.
+			 */
+			bool instability = false;
 
 			// Main time loop
 			while(true)
@@ -2230,14 +2856,30 @@ int main(int i_argc, char *i_argv[])
 				// Instability
 				if (simulationSWE->instability_detected())
 				{
+					instability = true;
 					std::cout << "INSTABILITY DETECTED" << std::endl;
 					break;
 				}
+
+				if (simVars.misc.checkpoint_file_name != "" && simVars.misc.checkpoint_each_wallclock_seconds >= 0)
+				{
+					if (checkpoint_time.getTimeSinceStart() >= simVars.misc.checkpoint_each_wallclock_seconds)
+					{
+						simulationSWE->checkpoint_write(simVars.misc.checkpoint_file_name);
+
+						checkpoint_time.reset();
+						checkpoint_time.start();
+					}
+				}
 			}
 
 			// Stop counting time
 			time.stop();
 
+			// Final checkpoint to continue the simulation with a new job
+			if (simVars.misc.checkpoint_file_name != "" && !instability)
+				simulationSWE->checkpoint_write(simVars.misc.checkpoint_file_name);
+
 			double seconds = time();
 
 			// End of run output results
@@ -2289,14 +2931,13 @@ int main(int i_argc, char *i_argv[])
 			 */
 			rexiSWE.setup(
 					simVars.rexi.rexi_h,
-					simVars.rexi.rexi_m,
-					simVars.rexi.rexi_l,
-					simVars.disc.res_physical,
+					simVars.rexi.rexi_M,
+					simVars.rexi.rexi_L,
+					planeDataConfig,
 					simVars.sim.domain_size,
-					simVars.rexi.rexi_half,
-					simVars.rexi.rexi_use_spectral_differences_for_complex_array,
-					simVars.rexi.rexi_helmholtz_solver_id,
-					simVars.rexi.rexi_helmholtz_solver_eps
+					simVars.rexi.rexi_use_half_poles,
+					simVars.rexi.rexi_normalization,
+					simVars.rexi.rexi_rebalance_ranks
 				);
 
 			bool run = true;
@@ -2305,16 +2946,16 @@ int main(int i_argc, char *i_argv[])
 			PlaneData prog_u(planeDataConfig);
 			PlaneData prog_v(planeDataConfig);
 
-			PlaneOperators op(simVars.disc.res_physical, simVars.sim.domain_size, simVars.disc.use_spectral_basis_diffs);
+			PlaneOperators op(planeDataConfig, simVars.sim.domain_size, simVars.disc.use_spectral_basis_diffs);
 
 			MPI_Barrier(MPI_COMM_WORLD);
 
 			while (run)
 			{
-				// REXI time stepping
+				// REXI time stepping, the time step size is received from rank 0
 				run = rexiSWE.run_timestep_rexi(
 						prog_h, prog_u, prog_v,
-						-simVars.sim.CFL,
+						0,
 						op,
 						simVars
 				);
@@ -2323,13 +2964,16 @@ int main(int i_argc, char *i_argv[])
 	}
 #endif
 
+	PlaneDataConfigRegistry::releaseConfig(planeDataConfig);
+	planeDataConfig = nullptr;
+
 
 #if SWEET_MPI
-	if (param_timestepping_mode > 0)
+	if (param_timestepping_mode == 1)
 	{
 		// synchronize REXI
 		if (mpi_rank == 0)
-			SWE_Plane_REXI::MPI_quitWorkers(planeDataConfig);
+			SWE_Plane_REXI::MPI_quitWorkers();
 	}
 
 	MPI_Finalize();
@@ -0,0 +1,411 @@
+/*
+ * SWE_Plane_SDC.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ */
+
+#ifndef SRC_PROGRAMS_SWE_REXI_SWE_PLANE_SDC_HPP_
+#define SRC_PROGRAMS_SWE_REXI_SWE_PLANE_SDC_HPP_
+
+#include <vector>
+#include <algorithm>
+#include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneOperators.hpp>
+#include <sweet/plane/PlaneDataConfigRegistry.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/FatalError.hpp>
+#include <sdc/SDC_Nodes.hpp>
+#include <sdc/SDC_Problem.hpp>
+#include <sdc/SDC_Sweeper.hpp>
+#include <sdc/PFASST_Controller_Serial.hpp>
+#include "SWE_Plane_REXI.hpp"
+
+
+
+/**
+ * Prognostic variables of the SWE on the plane
+ */
+class SWE_Plane_SDC_State
+{
+public:
+	PlaneData h;
+	PlaneData u;
+	PlaneData v;
+
+	SWE_Plane_SDC_State(
+			PlaneDataConfig *i_planeDataConfig
+	)	:
+		h(i_planeDataConfig),
+		u(i_planeDataConfig),
+		v(i_planeDataConfig)
+	{
+	}
+};
+
+
+
+/**
+ * IMEX splitting of the linear SWE on one level for SDC:
+ *
+ * The linear operator L with constant Coriolis parameter f0 is treated implicitly
+ * with the backward Euler solver of SWE_Plane_REXI.
+ * For the beta-plane, the deviation of the Coriolis parameter from f0
+ * is treated explicitly.
+ */
+class SWE_Plane_SDC_Problem	:
+		public SDC_Problem<SWE_Plane_SDC_State>
+{
+public:
+	PlaneDataConfig *planeDataConfig;
+	const SimulationVariables *simVars;
+
+	PlaneOperators op;
+	SWE_Plane_REXI swe_plane_rexi;
+
+	/// f(y) - f0 for the beta plane
+	PlaneData beta_plane_deviation;
+	bool use_beta_plane;
+
+
+public:
+	SWE_Plane_SDC_Problem(
+			PlaneDataConfig *i_planeDataConfig,
+			const SimulationVariables &i_simVars,
+			const PlaneData *i_beta_plane		///< Coriolis parameter on this level or nullptr for f-plane
+	)	:
+		planeDataConfig(i_planeDataConfig),
+		simVars(&i_simVars),
+		op(i_planeDataConfig, i_simVars.sim.domain_size, i_simVars.disc.use_spectral_basis_diffs),
+		beta_plane_deviation(i_planeDataConfig),
+		use_beta_plane(i_beta_plane != nullptr)
+	{
+		swe_plane_rexi.setup(
+				i_simVars.rexi.rexi_h,
+				i_simVars.rexi.rexi_M,
+				i_simVars.rexi.rexi_L,
+				planeDataConfig,
+				i_simVars.sim.domain_size,
+				i_simVars.rexi.rexi_use_half_poles,
+				i_simVars.rexi.rexi_normalization
+			);
+
+		if (use_beta_plane)
+			beta_plane_deviation = *i_beta_plane - i_simVars.sim.f0;
+	}
+
+
+
+	void eval_explicit(
+			const SWE_Plane_SDC_State &i_u,
+			double i_time,
+			SWE_Plane_SDC_State &o_f
+	)
+	{
+		o_f.h.physical_set_all(0);
+
+		if (!use_beta_plane)
+		{
+			o_f.u.physical_set_all(0);
+			o_f.v.physical_set_all(0);
+			return;
+		}
+
+		o_f.u = beta_plane_deviation*i_u.v;
+		o_f.v = -(beta_plane_deviation*i_u.u);
+	}
+
+
+
+	void eval_implicit(
+			const SWE_Plane_SDC_State &i_u,
+			double i_time,
+			SWE_Plane_SDC_State &o_f
+	)
+	{
+		double g = simVars->sim.gravitation;
+		double f0 = simVars->sim.f0;
+
+		o_f.u = -g*op.diff_c_x(i_u.h) + f0*i_u.v;
+		o_f.v = -g*op.diff_c_y(i_u.h) - f0*i_u.u;
+		o_f.h = -(op.diff_c_x(i_u.u) + op.diff_c_y(i_u.v))*simVars->sim.h0;
+	}
+
+
+
+	void solve_implicit(
+			const SWE_Plane_SDC_State &i_rhs,
+			double i_dt,
+			double i_time,
+			SWE_Plane_SDC_State &o_u,
+			SWE_Plane_SDC_State &o_f
+	)
+	{
+		o_u.h = i_rhs.h;
+		o_u.u = i_rhs.u;
+		o_u.v = i_rhs.v;
+
+		swe_plane_rexi.run_timestep_implicit_ts(
+				o_u.h, o_u.u, o_u.v,
+				i_dt,
+				op,
+				*simVars
+			);
+
+		// f_I(u) = (u - rhs)/dt avoids an additional evaluation of the operator
+		double inv_dt = 1.0/i_dt;
+		o_f.h = (o_u.h - i_rhs.h)*inv_dt;
+		o_f.u = (o_u.u - i_rhs.u)*inv_dt;
+		o_f.v = (o_u.v - i_rhs.v)*inv_dt;
+	}
+
+
+
+	void set_zero(
+			SWE_Plane_SDC_State &o_u
+	)
+	{
+		o_u.h.physical_set_all(0);
+		o_u.u.physical_set_all(0);
+		o_u.v.physical_set_all(0);
+	}
+
+
+
+	void axpy(
+			double i_a,
+			const SWE_Plane_SDC_State &i_x,
+			SWE_Plane_SDC_State &io_y
+	)
+	{
+		io_y.h += i_a*i_x.h;
+		io_y.u += i_a*i_x.u;
+		io_y.v += i_a*i_x.v;
+	}
+
+
+
+	double norm(
+			const SWE_Plane_SDC_State &i_u
+	)
+	{
+		return std::max(i_u.h.reduce_maxAbs(), std::max(i_u.u.reduce_maxAbs(), i_u.v.reduce_maxAbs()));
+	}
+};
+
+
+
+/**
+ * Transfer between two levels by truncation / zero padding of the spectral modes
+ */
+class SWE_Plane_SDC_Transfer	:
+		public SDC_Transfer<SWE_Plane_SDC_State>
+{
+public:
+	PlaneDataConfig *planeDataConfigFine;
+	PlaneDataConfig *planeDataConfigCoarse;
+
+	SWE_Plane_SDC_Transfer(
+			PlaneDataConfig *i_planeDataConfigFine,
+			PlaneDataConfig *i_planeDataConfigCoarse
+	)	:
+		planeDataConfigFine(i_planeDataConfigFine),
+		planeDataConfigCoarse(i_planeDataConfigCoarse)
+	{
+	}
+
+
+	void restrict(
+			const SWE_Plane_SDC_State &i_fine,
+			SWE_Plane_SDC_State &o_coarse
+	)
+	{
+		o_coarse.h = i_fine.h.spectral_returnWithDifferentModes(planeDataConfigCoarse);
+		o_coarse.u = i_fine.u.spectral_returnWithDifferentModes(planeDataConfigCoarse);
+		o_coarse.v = i_fine.v.spectral_returnWithDifferentModes(planeDataConfigCoarse);
+	}
+
+
+	void interpolate(
+			const SWE_Plane_SDC_State &i_coarse,
+			SWE_Plane_SDC_State &o_fine
+	)
+	{
+		o_fine.h = i_coarse.h.spectral_returnWithDifferentModes(planeDataConfigFine);
+		o_fine.u = i_coarse.u.spectral_returnWithDifferentModes(planeDataConfigFine);
+		o_fine.v = i_coarse.v.spectral_returnWithDifferentModes(planeDataConfigFine);
+	}
+};
+
+
+
+/**
+ * Time stepping for the linear SWE with SDC and PFASST
+ *
+ * Each call of run_timestep() computes the solution for a given number of
+ * time slices with PFASST. With a single time slice and level, this is
+ * a standard SDC time step.
+ *
+ * The coarser levels use half of the spectral modes of the next finer level.
+ */
+class SWE_Plane_SDC
+{
+	std::vector<PlaneDataConfig*> planeDataConfigs;
+	std::vector<PlaneData*> beta_planes;
+
+	std::vector<SWE_Plane_SDC_Problem*> problems;
+	std::vector<SWE_Plane_SDC_Transfer*> transfers;
+	std::vector<SWE_Plane_SDC_State*> states;
+
+	SDC_Nodes nodes;
+
+	PFASST_Controller_Serial<SWE_Plane_SDC_State> pfasst;
+
+	SWE_Plane_SDC_State *state;
+
+public:
+	int num_slices;
+
+
+public:
+	SWE_Plane_SDC()	:
+		state(nullptr),
+		num_slices(1)
+	{
+	}
+
+
+	~SWE_Plane_SDC()
+	{
+		cleanup();
+	}
+
+
+	void cleanup()
+	{
+		pfasst.cleanup();
+
+		for (auto p : problems)		delete p;
+		for (auto p : transfers)	delete p;
+		for (auto p : states)		delete p;
+		for (auto p : beta_planes)	delete p;
+
+		// the config of the finest level is not owned by this class
+		for (std::size_t i = 1; i < planeDataConfigs.size(); i++)
+			PlaneDataConfigRegistry::releaseConfig(planeDataConfigs[i]);
+
+		problems.clear();
+		transfers.clear();
+		states.clear();
+		beta_planes.clear();
+		planeDataConfigs.clear();
+
+		delete state;
+		state = nullptr;
+	}
+
+
+
+	void setup(
+			PlaneDataConfig *i_planeDataConfig,		///< config of finest level
+			const SimulationVariables &i_simVars,
+			const PlaneData *i_beta_plane,			///< Coriolis parameter or nullptr for f-plane
+			int i_num_nodes,						///< number of SDC nodes
+			int i_node_type,						///< 0: Gauss-Lobatto, 1: Gauss-Radau
+			int i_num_iterations,					///< number of SDC/PFASST iterations
+			int i_num_levels,						///< number of levels
+			int i_num_slices,						///< number of time slices for PFASST
+			double i_convergence_threshold			///< stop iterating if reached, disabled if negative
+	)
+	{
+		cleanup();
+
+		if (i_num_levels < 1)
+			FatalError("SDC: At least one level required");
+
+		num_slices = i_num_slices;
+
+		nodes.setup(i_num_nodes, (SDC_Nodes::NodeType)i_node_type);
+
+		if (i_simVars.misc.verbosity > 1)
+			nodes.print();
+
+		planeDataConfigs.push_back(i_planeDataConfig);
+
+		for (int l = 1; l < i_num_levels; l++)
+		{
+			PlaneDataConfig *fine = planeDataConfigs.back();
+
+			int modes_x = fine->spectral_modes[0]/2;
+			int modes_y = fine->spectral_modes[1]/2;
+
+			if (modes_x < 4 || modes_y < 4)
+				FatalError("SDC: Too many levels for this resolution");
+
+			// configs of coarse levels are shared by all solver instances with the same modes
+			PlaneDataConfig *coarse = PlaneDataConfigRegistry::getConfigAdditionalModes(fine, modes_x-fine->spectral_modes[0], modes_y-fine->spectral_modes[1]);
+			planeDataConfigs.push_back(coarse);
+		}
+
+		for (int l = 0; l < i_num_levels; l++)
+		{
+			PlaneData *beta_plane = nullptr;
+
+			if (i_beta_plane != nullptr)
+			{
+				beta_plane = new PlaneData(i_beta_plane->spectral_returnWithDifferentModes(planeDataConfigs[l]));
+				beta_planes.push_back(beta_plane);
+			}
+
+			problems.push_back(new SWE_Plane_SDC_Problem(planeDataConfigs[l], i_simVars, beta_plane));
+			states.push_back(new SWE_Plane_SDC_State(planeDataConfigs[l]));
+
+			if (l > 0)
+				transfers.push_back(new SWE_Plane_SDC_Transfer(planeDataConfigs[l-1], planeDataConfigs[l]));
+		}
+
+		std::vector<SDC_Problem<SWE_Plane_SDC_State>*> p(problems.begin(), problems.end());
+		std::vector<SDC_Transfer<SWE_Plane_SDC_State>*> t(transfers.begin(), transfers.end());
+		std::vector<const SWE_Plane_SDC_State*> s(states.begin(), states.end());
+
+		// single sweep per iteration on the finest level, two on the coarser ones
+		std::vector<int> num_sweeps(i_num_levels, 2);
+		num_sweeps[0] = 1;
+
+		pfasst.setup(p, t, s, &nodes, num_sweeps, num_slices, i_num_iterations, i_convergence_threshold, i_simVars.misc.verbosity);
+
+		state = new SWE_Plane_SDC_State(i_planeDataConfig);
+	}
+
+
+
+	/**
+	 * Run num_slices time steps of size i_dt
+	 *
+	 * \return number of PFASST iterations
+	 */
+	int run_timestep(
+			PlaneData &io_h,
+			PlaneData &io_u,
+			PlaneData &io_v,
+			double i_dt,
+			double i_simulation_time
+	)
+	{
+		state->h = io_h;
+		state->u = io_u;
+		state->v = io_v;
+
+		int iterations = pfasst.run(*state, i_simulation_time, i_dt);
+
+		io_h = state->h;
+		io_u = state->u;
+		io_v = state->v;
+
+		return iterations;
+	}
+};
+
+
+
+#endif /* SRC_PROGRAMS_SWE_REXI_SWE_PLANE_SDC_HPP_ */
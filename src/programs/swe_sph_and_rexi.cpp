@@ -15,6 +15,7 @@
 #include <benchmarks_sphere/SphereBenchmarksCombined.hpp>
 
 #include <sweet/sphere/SphereData.hpp>
+#include <sweet/sphere/SphereDataConfigRegistry.hpp>
 
 // explicit time stepping
 #include <sweet/sphere/SphereDataTimesteppingExplicitRK.hpp>
@@ -29,9 +30,12 @@
 #include <sweet/sphere/app_swe/SWESphBandedMatrixPhysicalReal.hpp>
 #include <sweet/Stopwatch.hpp>
 #include <sweet/FatalError.hpp>
+#include <sweet/Checkpoint.hpp>
+#include <sweet/VisSweetImageWriter.hpp>
 
 
 #include <rexi/swe_sphere_rexi/SWE_Sphere_REXI.hpp>
+#include <sweet/BatchJobRunner.hpp>
 
 
 
@@ -40,13 +44,14 @@ SimulationVariables simVars;
 //Diagnostic measures at initial stage
 //double diagnostics_energy_start, diagnostics_mass_start, diagnostics_potential_entrophy_start;
 
-// Plane data config
-SphereDataConfig sphereDataConfigInstance;
-SphereDataConfig *sphereDataConfig = &sphereDataConfigInstance;
+// Sphere data config, shared with the REXI solver via the registry
+SphereDataConfig *sphereDataConfig = nullptr;
 
-// Plane data config
-SphereDataConfig sphereDataConfigExtInstance;
-SphereDataConfig *sphereDataConfigExt = &sphereDataConfigExtInstance;
+// Sphere data config with extended modes, shared with the REXI solver via the registry
+SphereDataConfig *sphereDataConfigExt = nullptr;
+
+// Operators shared by all jobs of a batch job group, nullptr if each instance sets up its own ones
+SphereOperators *sphereOperators = nullptr;
 
 
 
@@ -55,25 +60,36 @@ SphereDataConfig *sphereDataConfigExt = &sphereDataConfigExtInstance;
 	PlaneDataConfig *planeDataConfig = &planeDataConfigInstance;
 #endif
 
-/*
- * This allows running REXI including Coriolis-related terms but just by setting f to 0
- */
-bool param_rexi_use_coriolis_formulation = true;
-bool param_compute_error = false;
 double param_geostr_balance_freq_multiplier = 1.0;
 
-/**
- * ID of PDE to solve
- * 0: SWE
- * 1: advection
- */
-int param_pde_id = 0;
-
 
 class SimulationInstance
 {
 public:
-	SphereOperators op;
+	/*
+	 * Simulation variables of this instance.
+	 *
+	 * These shadow the global ones to run several simulations
+	 * with different parameters concurrently (see BatchJobRunner).
+	 */
+	SimulationVariables simVars;
+
+	/*
+	 * This allows running REXI including Coriolis-related terms but just by setting f to 0
+	 */
+	bool param_rexi_use_coriolis_formulation = simVars.bogus.var[0];
+	bool param_compute_error = simVars.bogus.var[1];
+
+	/**
+	 * ID of PDE to solve
+	 * 0: SWE
+	 * 1: advection
+	 */
+	int param_pde_id = simVars.bogus.var[2];
+
+	// Operators, shared with the other jobs of the batch job group if available
+	SphereOperators *op_instance;
+	SphereOperators &op;
 	SphereOperatorsComplex opComplex;
 
 	// Runge-Kutta stuff
@@ -93,6 +109,9 @@ public:
 
 	REXI<> rexi;
 
+	// In-situ rendering of images
+	VisSweetImageWriter imageWriter;
+
 #if SWEET_GUI
 	PlaneData viz_plane_data;
 #endif
@@ -103,7 +122,18 @@ public:
 
 public:
 	SimulationInstance()	:
-		op(sphereDataConfig),
+		SimulationInstance(::simVars)
+	{
+	}
+
+
+
+	SimulationInstance(
+			const SimulationVariables &i_simVars
+	)	:
+		simVars(i_simVars),
+		op_instance(sphereOperators == nullptr ? new SphereOperators(sphereDataConfig) : nullptr),
+		op(sphereOperators == nullptr ? *op_instance : *sphereOperators),
 		opComplex(sphereDataConfig),
 		timestepping_implicit_swe(op),
 		prog_h(sphereDataConfig),
@@ -119,6 +149,13 @@ public:
 
 
 
+	~SimulationInstance()
+	{
+		delete op_instance;
+	}
+
+
+
 
 
 	SphereData f(SphereData i_sphData)
@@ -177,6 +214,65 @@ public:
 	}
 
 
+	/**
+	 * Return the time step size for the next REXI time step.
+	 *
+	 * Only the linear equations are solved with REXI, hence the CFL condition
+	 * is based on the gravity wave speed and the smallest resolved wave length.
+	 * The time step size is further limited to the range of frequencies
+	 * which are approximated by REXI.
+	 *
+	 * The time step size is snapped to a few values (see --rexi-dt-snap)
+	 * so that the REXI solvers can be reused. With snapping, it's also
+	 * shortened to hit the next output time. Shortened time step sizes
+	 * are snapped to the ones in the solver cache.
+	 */
+	double p_get_rexi_timestep_size()
+	{
+		double dt;
+
+		if (simVars.sim.CFL < 0)
+		{
+			dt = -simVars.sim.CFL;
+		}
+		else
+		{
+			double n_max = sphereDataConfig->spectral_modes_n_max;
+			double gh0 = simVars.sim.gravitation*simVars.sim.h0;
+
+			// largest frequency of the linear operator: gravity waves with the largest wave number and Coriolis
+			double k2 = n_max*(n_max+1.0)/(simVars.sim.earth_radius*simVars.sim.earth_radius);
+			double two_omega = 2.0*simVars.sim.coriolis_omega;
+			double max_frequency = std::sqrt(gh0*k2 + two_omega*two_omega);
+
+			dt = simVars.rexi.getMaxTimestepSize(max_frequency);
+
+			if (gh0 > 0 && k2 > 0)
+				dt = std::min(dt, simVars.sim.CFL/std::sqrt(gh0*k2));
+		}
+
+		dt = simVars.rexi.snapTimestepSize(dt);
+
+		if (simVars.rexi.rexi_timestep_snap > 0)
+			if (dt + simVars.timecontrol.current_simulation_time > simVars.misc.output_next_sim_seconds)
+				if (simVars.misc.output_next_sim_seconds > simVars.timecontrol.current_simulation_time)
+					dt = simVars.misc.output_next_sim_seconds-simVars.timecontrol.current_simulation_time;
+
+		// padding to max simulation time if exceeding the maximum
+		if (simVars.timecontrol.max_simulation_time >= 0)
+			if (dt + simVars.timecontrol.current_simulation_time > simVars.timecontrol.max_simulation_time)
+				dt = simVars.timecontrol.max_simulation_time-simVars.timecontrol.current_simulation_time;
+
+		dt = swe_sphere_rexi.snapTimestepSizeToCache(dt);
+
+		if (!(dt > 0) || std::isinf(dt))
+			FatalError("Unable to determine REXI time step size, use negative CFL to set constant time step size");
+
+		return dt;
+	}
+
+
+
 	void reset()
 	{
 		// reset the RK time stepping buffers
@@ -244,6 +340,10 @@ public:
 
 		SphereBenchmarksCombined::setupInitialConditions(prog_h, prog_u, prog_v, simVars, op);
 
+		// the benchmarks might change the simulation parameters
+		if (simVars.disc.timestepping_method == simVars.disc.REXI && simVars.sim.CFL >= 0)
+			simVars.timecontrol.current_timestep_size = p_get_rexi_timestep_size();
+
 		if (simVars.setup.benchmark_scenario_id == 5 || simVars.setup.benchmark_scenario_id == 6)
 		{
 //			prog_u = prog_u;
@@ -299,8 +399,11 @@ public:
 					simVars.misc.sphere_use_robert_functions,
 					simVars.rexi.rexi_use_extended_modes,
 					simVars.rexi.rexi_normalization,
-					param_rexi_use_coriolis_formulation
+					param_rexi_use_coriolis_formulation,
+					simVars.rexi.rexi_solver_cache_size,
+					simVars.rexi.rexi_rebalance_ranks
 				);
+
 		}
 
 		if (simVars.disc.timestepping_method == simVars.disc.EULER_IMPLICIT)
@@ -411,6 +514,51 @@ public:
 
 
 
+	/**
+	 * Render data to image file in background
+	 */
+	void write_image(
+			const SphereData &i_sphereData,
+			const char* i_name	///< name of output variable
+	)
+	{
+		char buffer[1024];
+
+		const char* filename_template = simVars.misc.output_file_name_prefix.c_str();
+		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.misc.output_time_scale);
+
+		std::string filename = VisSweetImageWriter::replace_file_extension(buffer);
+
+		i_sphereData.request_data_physical();
+
+		imageWriter.push_frame(
+				filename,
+				i_sphereData.physical_space_data,
+				sphereDataConfig->physical_num_lon,
+				sphereDataConfig->physical_num_lat,
+				true
+			);
+	}
+
+
+
+	/**
+	 * Write images each simVars.misc.output_image_each_timesteps time steps
+	 */
+	void timestep_image_output()
+	{
+		if (simVars.misc.output_image_each_timesteps <= 0)
+			return;
+
+		if (simVars.timecontrol.current_timestep_nr % simVars.misc.output_image_each_timesteps != 0)
+			return;
+
+		write_image(prog_h, "h");
+		write_image(op.vort(prog_u, prog_v), "eta");
+	}
+
+
+
 	void timestep_do_output()
 	{
 		write_file_output();
@@ -610,13 +758,8 @@ public:
 		}
 		else if (simVars.disc.timestepping_method == simVars.disc.REXI)
 		{
-			o_dt = simVars.timecontrol.current_timestep_size;
-			assert(o_dt > 0);
-
-			// padding to max simulation time if exceeding the maximum
-			if (simVars.timecontrol.max_simulation_time >= 0)
-				if (o_dt + simVars.timecontrol.current_simulation_time > simVars.timecontrol.max_simulation_time)
-					o_dt = simVars.timecontrol.max_simulation_time-simVars.timecontrol.current_simulation_time;
+			// re-evaluated each time step since the simulation parameters might change
+			o_dt = p_get_rexi_timestep_size();
 
 			swe_sphere_rexi.run_timestep_rexi(
 					prog_h,
@@ -631,7 +774,7 @@ public:
 			 */
 			if (simVars.sim.viscosity != 0)
 			{
-				double scalar = simVars.sim.viscosity*simVars.timecontrol.current_timestep_size;
+				double scalar = simVars.sim.viscosity*o_dt;
 				double r = simVars.sim.earth_radius;
 
 				/*
@@ -843,6 +986,192 @@ public:
 		}
 	}
 
+
+
+	/**
+	 * Write the full state of the simulation to a checkpoint file.
+	 *
+	 * All other variables (REXI solvers, time step size for REXI, etc.)
+	 * are recomputed by reset().
+	 */
+	void checkpoint_write(
+			const std::string &i_filename
+	)
+	{
+		CheckpointWriter cp(i_filename);
+
+		cp.write("sphere_data_config", sphereDataConfig->getConfigInformationString());
+		cp.write("timestepping_method", simVars.disc.timestepping_method);
+		cp.write("pde_id", param_pde_id);
+
+		cp.write("current_timestep_nr", simVars.timecontrol.current_timestep_nr);
+		cp.write("current_timestep_size", simVars.timecontrol.current_timestep_size);
+		cp.write("current_simulation_time", simVars.timecontrol.current_simulation_time);
+		cp.write("output_next_sim_seconds", simVars.misc.output_next_sim_seconds);
+
+		cp.write_data("prog_h", prog_h);
+		cp.write_data("prog_u", prog_u);
+		cp.write_data("prog_v", prog_v);
+
+		cp.close();
+	}
+
+
+
+	/**
+	 * Restore the state of the simulation from a checkpoint file.
+	 *
+	 * reset() has to be called before.
+	 */
+	void checkpoint_read(
+			const std::string &i_filename
+	)
+	{
+		CheckpointReader cp(i_filename);
+
+		std::string config_info;
+		cp.read("sphere_data_config", config_info);
+		if (config_info != sphereDataConfig->getConfigInformationString())
+			FatalError("Resolution of checkpoint does not match resolution of simulation");
+
+		int timestepping_method;
+		cp.read("timestepping_method", timestepping_method);
+		if (timestepping_method != simVars.disc.timestepping_method)
+			FatalError("Time stepping method of checkpoint does not match time stepping method of simulation");
+
+		int pde_id;
+		cp.read("pde_id", pde_id);
+		if (pde_id != param_pde_id)
+			FatalError("PDE of checkpoint does not match PDE of simulation");
+
+		cp.read("current_timestep_nr", simVars.timecontrol.current_timestep_nr);
+		cp.read("current_timestep_size", simVars.timecontrol.current_timestep_size);
+		cp.read("current_simulation_time", simVars.timecontrol.current_simulation_time);
+		cp.read("output_next_sim_seconds", simVars.misc.output_next_sim_seconds);
+
+		cp.read_data("prog_h", prog_h);
+		cp.read_data("prog_u", prog_u);
+		cp.read_data("prog_v", prog_v);
+
+		// force recomputation of diagnostics
+		last_timestep_nr_update_diagnostics = -1;
+	}
+
+
+
+	/**
+	 * Run the time stepping until the end of the simulation
+	 * and print the summary
+	 */
+	void run()
+	{
+		//Setting initial conditions and workspace - in case there is no GUI
+
+		// reset already triggered
+		//reset();
+
+		//Time counter
+		Stopwatch time;
+
+		//Diagnostic measures at initial stage
+		//double diagnostics_energy_start, diagnostics_mass_start, diagnostics_potential_entrophy_start;
+
+		// Initialize diagnostics
+		if (simVars.misc.verbosity > 0)
+		{
+//				update_diagnostics();
+#if 0
+			diagnostics_energy_start = simVars.diag.total_energy;
+			diagnostics_mass_start = simVars.diag.total_mass;
+			diagnostics_potential_entrophy_start = simVars.diag.total_potential_enstrophy;
+#endif
+		}
+
+#if SWEET_MPI
+		MPI_Barrier(MPI_COMM_WORLD);
+#endif
+		// Restart from checkpoint
+		if (simVars.misc.restart_file_name != "")
+		{
+			checkpoint_read(simVars.misc.restart_file_name);
+			std::cout << "Restarted from checkpoint '" << simVars.misc.restart_file_name << "' at simulation time " << simVars.timecontrol.current_simulation_time << std::endl;
+		}
+
+		//Start counting time
+		time.reset();
+
+		// Wallclock time of last checkpoint
+		Stopwatch checkpoint_time;
+
+
+		bool output_written = false;
+
+		/*
+		 * Set if the time loop was stopped due to an instability.
+		 * The prognostic fields are not checked again after the loop
+		 * since this might transform them and the final checkpoint
+		 * has to be the state which continues the time loop.
+		 */
+		bool instability = false;
+
+		// Main time loop
+		while(true)
+		{
+			if (timestep_check_output())
+				output_written = true;
+			else
+				output_written = false;
+
+			timestep_image_output();
+
+			// Stop simulation if requested
+			if (should_quit())
+				break;
+
+			// Main call for timestep run
+			run_timestep();
+
+			// Instability
+			if (instability_detected())
+			{
+				instability = true;
+				std::cout << "INSTABILITY DETECTED" << std::endl;
+				break;
+			}
+
+			if (simVars.misc.checkpoint_file_name != "" && simVars.misc.checkpoint_each_wallclock_seconds >= 0)
+			{
+				if (checkpoint_time.getTimeSinceStart() >= simVars.misc.checkpoint_each_wallclock_seconds)
+				{
+					checkpoint_write(simVars.misc.checkpoint_file_name);
+
+					checkpoint_time.reset();
+					checkpoint_time.start();
+				}
+			}
+		}
+
+		// Final checkpoint to continue the simulation with a new job
+		if (simVars.misc.checkpoint_file_name != "" && !instability)
+			checkpoint_write(simVars.misc.checkpoint_file_name);
+
+		// Output final time step output!
+		if (!output_written)
+			timestep_do_output();
+
+		// Stop counting time
+		time.stop();
+
+		double seconds = time();
+
+		// End of run output results
+		std::cout << "Simulation time (seconds): " << seconds << std::endl;
+		std::cout << "Number of time steps: " << simVars.timecontrol.current_timestep_nr << std::endl;
+		std::cout << "Time per time step: " << seconds/(double)simVars.timecontrol.current_timestep_nr << " sec/ts" << std::endl;
+		std::cout << "Last time step size: " << simVars.timecontrol.current_timestep_size << std::endl;
+	}
+
+
 #if SWEET_GUI
 
 
@@ -1043,6 +1372,9 @@ int main(int i_argc, char *i_argv[])
 	simVars.bogus.var[1] = 1;
 	simVars.bogus.var[2] = 0;
 
+	// defaults of batch jobs
+	SimulationVariables defaultSimVars = simVars;
+
 	// Help menu
 	if (!simVars.setupFromMainParameters(i_argc, i_argv, bogus_var_names))
 	{
@@ -1054,22 +1386,99 @@ int main(int i_argc, char *i_argv[])
 		return -1;
 	}
 
-	param_rexi_use_coriolis_formulation = simVars.bogus.var[0];
-	assert (param_rexi_use_coriolis_formulation == 0 || param_rexi_use_coriolis_formulation == 1);
+	// the specific parameters are read by each SimulationInstance
+	assert (simVars.bogus.var[0] == 0 || simVars.bogus.var[0] == 1);
 
-	param_compute_error = simVars.bogus.var[1];
-	param_pde_id = simVars.bogus.var[2];
+	REXICoefficientCache::setCacheDirectory(simVars.rexi.rexi_coefficient_cache_dir);
 
+	if (simVars.misc.batch_job_file_name != "")
+	{
+#if SWEET_MPI
+		FatalError("Batch jobs are not supported with MPI");
+#endif
+
+		BatchJobRunner batchJobRunner;
+
+		if (!batchJobRunner.setup(
+				simVars.misc.batch_job_file_name,
+				simVars.misc.batch_num_teams,
+				defaultSimVars,
+				i_argc,
+				i_argv,
+				bogus_var_names
+			))
+			return -1;
+
+		batchJobRunner.run(
+				// jobs with the same resolution share the SPH configs (including the SHTns plans)
+				[](const SimulationVariables &i_simVars) -> std::string
+				{
+					std::ostringstream ss;
+					ss << "M" << i_simVars.disc.res_spectral[0] << "x" << i_simVars.disc.res_spectral[1];
+					ss << "_N" << i_simVars.disc.res_physical[0] << "x" << i_simVars.disc.res_physical[1];
+					ss << "_ext" << i_simVars.rexi.rexi_use_extended_modes;
+					return ss.str();
+				},
+
+				[](const SimulationVariables &i_simVars)
+				{
+					sphereDataConfig = SphereDataConfigRegistry::getConfig(
+							i_simVars.disc.res_spectral[0],
+							i_simVars.disc.res_spectral[1],
+							i_simVars.disc.res_physical[0],
+							i_simVars.disc.res_physical[1]
+						);
+
+					sphereDataConfigExt = SphereDataConfigRegistry::getConfigAdditionalModes(
+							sphereDataConfig,
+							i_simVars.rexi.rexi_use_extended_modes,
+							i_simVars.rexi.rexi_use_extended_modes
+						);
 
-	sphereDataConfigInstance.setupAutoPhysicalSpace(
-					simVars.disc.res_spectral[0],
-					simVars.disc.res_spectral[1],
-					&simVars.disc.res_physical[0],
-					&simVars.disc.res_physical[1]
+					sphereOperators = new SphereOperators(sphereDataConfig);
+
+					std::cout << "SPH config string: " << sphereDataConfig->getConfigInformationString() << std::endl;
+				},
+
+				[]()
+				{
+					delete sphereOperators;
+					sphereOperators = nullptr;
+
+					SphereDataConfigRegistry::releaseConfig(sphereDataConfigExt);
+					SphereDataConfigRegistry::releaseConfig(sphereDataConfig);
+
+					sphereDataConfig = nullptr;
+					sphereDataConfigExt = nullptr;
+				},
+
+				[](BatchJobRunner::Job &io_job)
+				{
+					io_job.simVars.disc.res_physical[0] = sphereDataConfig->physical_num_lon;
+					io_job.simVars.disc.res_physical[1] = sphereDataConfig->physical_num_lat;
+
+					SimulationInstance *simulationSWE = new SimulationInstance(io_job.simVars);
+
+					simulationSWE->run();
+
+					delete simulationSWE;
+				}
 			);
 
-	sphereDataConfigExtInstance.setupAdditionalModes(
-			&sphereDataConfigInstance,
+		return 0;
+	}
+
+
+	sphereDataConfig = SphereDataConfigRegistry::getConfig(
+			simVars.disc.res_spectral[0],
+			simVars.disc.res_spectral[1]
+		);
+
+	simVars.disc.res_physical[0] = sphereDataConfig->physical_num_lon;
+	simVars.disc.res_physical[1] = sphereDataConfig->physical_num_lat;
+
+	sphereDataConfigExt = SphereDataConfigRegistry::getConfigAdditionalModes(
+			sphereDataConfig,
 			simVars.rexi.rexi_use_extended_modes,
 			simVars.rexi.rexi_use_extended_modes
 		);
@@ -1094,7 +1503,7 @@ int main(int i_argc, char *i_argv[])
 #endif
 
 	{
-		std::cout << "SPH config string: " << sphereDataConfigInstance.getConfigInformationString() << std::endl;
+		std::cout << "SPH config string: " << sphereDataConfig->getConfigInformationString() << std::endl;
 
 #if SWEET_PARAREAL
 		if (simVars.parareal.enabled)
@@ -1125,74 +1534,8 @@ int main(int i_argc, char *i_argv[])
 #endif
 		{
 			SimulationInstance *simulationSWE = new SimulationInstance;
-			//Setting initial conditions and workspace - in case there is no GUI
 
-			// reset already triggered
-			//simulationSWE->reset();
-
-			//Time counter
-			Stopwatch time;
-
-			//Diagnostic measures at initial stage
-			//double diagnostics_energy_start, diagnostics_mass_start, diagnostics_potential_entrophy_start;
-
-			// Initialize diagnostics
-			if (simVars.misc.verbosity > 0)
-			{
-//				simulationSWE->update_diagnostics();
-#if 0
-				diagnostics_energy_start = simVars.diag.total_energy;
-				diagnostics_mass_start = simVars.diag.total_mass;
-				diagnostics_potential_entrophy_start = simVars.diag.total_potential_enstrophy;
-#endif
-			}
-
-#if SWEET_MPI
-			MPI_Barrier(MPI_COMM_WORLD);
-#endif
-			//Start counting time
-			time.reset();
-
-
-			bool output_written = false;
-
-			// Main time loop
-			while(true)
-			{
-				if (simulationSWE->timestep_check_output())
-					output_written = true;
-				else
-					output_written = false;
-
-				// Stop simulation if requested
-				if (simulationSWE->should_quit())
-					break;
-
-				// Main call for timestep run
-				simulationSWE->run_timestep();
-
-				// Instability
-				if (simulationSWE->instability_detected())
-				{
-					std::cout << "INSTABILITY DETECTED" << std::endl;
-					break;
-				}
-			}
-
-			// Output final time step output!
-			if (!output_written)
-				simulationSWE->timestep_do_output();
-
-			// Stop counting time
-			time.stop();
-
-			double seconds = time();
-
-			// End of run output results
-			std::cout << "Simulation time (seconds): " << seconds << std::endl;
-			std::cout << "Number of time steps: " << simVars.timecontrol.current_timestep_nr << std::endl;
-			std::cout << "Time per time step: " << seconds/(double)simVars.timecontrol.current_timestep_nr << " sec/ts" << std::endl;
-			std::cout << "Last time step size: " << simVars.timecontrol.current_timestep_size << std::endl;
+			simulationSWE->run();
 
 			delete simulationSWE;
 		}
@@ -1200,7 +1543,7 @@ int main(int i_argc, char *i_argv[])
 #if SWEET_MPI
 	else
 	{
-		if (simVars.rexi.use_rexi == 1)
+		if (simVars.disc.timestepping_method == simVars.disc.REXI)
 		{
 			SWE_Sphere_REXI rexiSWE;
 
@@ -1220,7 +1563,9 @@ int main(int i_argc, char *i_argv[])
 					simVars.misc.sphere_use_robert_functions,
 					simVars.rexi.rexi_use_extended_modes,
 					simVars.rexi.rexi_normalization,
-					param_rexi_use_coriolis_formulation
+					simVars.bogus.var[0],	// rexi-use-coriolis-formulation
+					simVars.rexi.rexi_solver_cache_size,
+					simVars.rexi.rexi_rebalance_ranks
 				);
 
 			bool run = true;
@@ -1238,10 +1583,10 @@ int main(int i_argc, char *i_argv[])
 
 			while (run)
 			{
-				// REXI time stepping
+				// REXI time stepping, the time step size is received from rank 0
 				run = rexiSWE.run_timestep_rexi(
 						prog_h, prog_u, prog_v,
-						-simVars.sim.CFL,
+						0,
 						simVars
 				);
 			}
@@ -1249,13 +1594,19 @@ int main(int i_argc, char *i_argv[])
 	}
 #endif
 
+	SphereDataConfigRegistry::releaseConfig(sphereDataConfigExt);
+	sphereDataConfigExt = nullptr;
+
+	SphereDataConfigRegistry::releaseConfig(sphereDataConfig);
+	sphereDataConfig = nullptr;
+
 
 #if SWEET_MPI
-	if (simVars.rexi.use_rexi == 1)
+	if (simVars.disc.timestepping_method == simVars.disc.REXI)
 	{
 		// synchronize REXI
 		if (mpi_rank == 0)
-			SWE_Sphere_REXI::MPI_quitWorkers(sphereDataConfig);
+			SWE_Sphere_REXI::MPI_quitWorkers();
 	}
 
 	MPI_Finalize();
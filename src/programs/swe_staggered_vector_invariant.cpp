@@ -16,6 +16,8 @@
 #include <unistd.h>
 #include <iomanip>
 #include <stdio.h>
+#include <vector>
+#include <algorithm>
 
 
 // Plane data config
@@ -28,6 +30,11 @@ SimulationVariables simVars;
 
 double next_timestep_output = 0;
 
+/*
+ * Compute the tendencies with the fused kernel instead of the operators
+ */
+bool param_use_fused_kernel = false;
+
 
 class SimulationSWEStaggered
 {
@@ -239,6 +246,219 @@ public:
 
 
 
+	/**
+	 * Compute the mass fluxes U, V, the Bernoulli potential H
+	 * and the potential vorticity q
+	 */
+	void p_compute_fluxes_and_potentials(
+			const PlaneData &i_h,	///< prognostic variables
+			const PlaneData &i_u,	///< prognostic variables
+			const PlaneData &i_v	///< prognostic variables
+	)
+	{
+		U = op.avg_b_x(i_h)*i_u;
+		V = op.avg_b_y(i_h)*i_v;
+
+		H = simVars.sim.gravitation*i_h + 0.5*(op.avg_f_x(i_u*i_u) + op.avg_f_y(i_v*i_v));
+
+		if (simVars.sim.beta != 0.0)
+		{
+			q = (op.diff_b_x(i_v) - op.diff_b_y(i_u) + beta_plane) / op.avg_b_x(op.avg_b_y(i_h));
+		}
+		else
+		{
+			q = (op.diff_b_x(i_v) - op.diff_b_y(i_u) + simVars.sim.f0) / op.avg_b_x(op.avg_b_y(i_h));
+		}
+	}
+
+
+
+	/**
+	 * Tile sizes of the fused kernel.
+	 *
+	 * The intermediate values U, V, H and q of a tile including
+	 * its halo ((128+2)*(16+2) values each) fit into the L2 cache.
+	 */
+	static const int fused_tile_size_x = 128;
+	static const int fused_tile_size_y = 16;
+
+
+	/**
+	 * Compute the same time updates as the operator-based formulation
+	 * in p_run_euler_timestep_update(), but in a single sweep over the data.
+	 *
+	 * For each tile, the mass fluxes U, V, the Bernoulli potential H and
+	 * the potential vorticity q are computed for the tile and a periodic
+	 * halo of one cell. These are kept in small per-thread buffers and
+	 * used to compute the tendencies of the tile.
+	 *
+	 * The maximum absolute values of the prognostic variables
+	 * (for the time step size) are computed in the same sweep.
+	 */
+	void p_compute_tendencies_fused(
+			const PlaneData &i_h,	///< prognostic variables
+			const PlaneData &i_u,	///< prognostic variables
+			const PlaneData &i_v,	///< prognostic variables
+
+			PlaneData &o_h_t,	///< time updates
+			PlaneData &o_u_t,	///< time updates
+			PlaneData &o_v_t,	///< time updates
+
+			double &o_max_abs_h,
+			double &o_max_abs_u,
+			double &o_max_abs_v
+	)
+	{
+		const int nx = planeDataConfig->physical_data_size[0];
+		const int ny = planeDataConfig->physical_data_size[1];
+
+		i_h.request_data_physical();
+		i_u.request_data_physical();
+		i_v.request_data_physical();
+
+		const double *h = i_h.physical_space_data;
+		const double *u = i_u.physical_space_data;
+		const double *v = i_v.physical_space_data;
+
+		// Coriolis parameter, either constant or beta plane
+		const double *f = nullptr;
+		if (simVars.sim.beta != 0.0)
+		{
+			beta_plane.request_data_physical();
+			f = beta_plane.physical_space_data;
+		}
+		const double f0 = simVars.sim.f0;
+
+		o_h_t.physical_alloc_buffer();
+		o_u_t.physical_alloc_buffer();
+		o_v_t.physical_alloc_buffer();
+
+		double *h_t = o_h_t.physical_space_data;
+		double *u_t = o_u_t.physical_space_data;
+		double *v_t = o_v_t.physical_space_data;
+
+		const double g = simVars.sim.gravitation;
+		const double inv_dx = 1.0/simVars.disc.cell_size[0];
+		const double inv_dy = 1.0/simVars.disc.cell_size[1];
+
+		const int num_tiles_x = (nx+fused_tile_size_x-1)/fused_tile_size_x;
+		const int num_tiles_y = (ny+fused_tile_size_y-1)/fused_tile_size_y;
+
+		// row size of the tile buffers
+		const int bx = fused_tile_size_x+2;
+
+		double max_abs_h = 0;
+		double max_abs_u = 0;
+		double max_abs_v = 0;
+
+#if SWEET_THREADING
+#pragma omp parallel reduction(max:max_abs_h,max_abs_u,max_abs_v)
+#endif
+		{
+			std::vector<double> U(bx*(fused_tile_size_y+2));
+			std::vector<double> V(U.size());
+			std::vector<double> H(U.size());
+			std::vector<double> q(U.size());
+
+#if SWEET_THREADING
+#pragma omp for collapse(2) OMP_SCHEDULE
+#endif
+			for (int ty = 0; ty < num_tiles_y; ty++)
+			{
+				for (int tx = 0; tx < num_tiles_x; tx++)
+				{
+					int x_start = tx*fused_tile_size_x;
+					int x_end = std::min(x_start+fused_tile_size_x, nx);
+
+					int y_start = ty*fused_tile_size_y;
+					int y_end = std::min(y_start+fused_tile_size_y, ny);
+
+					/*
+					 * U, V, H and q of the tile including the halo
+					 */
+					for (int by = 0; by < y_end-y_start+2; by++)
+					{
+						// periodic rows
+						int y = (y_start+by-1+ny) % ny;
+						int y_m = (y == 0 ? ny-1 : y-1);
+						int y_p = (y == ny-1 ? 0 : y+1);
+
+						const double *h_0 = &h[(std::size_t)y*nx];
+						const double *h_m = &h[(std::size_t)y_m*nx];
+						const double *u_0 = &u[(std::size_t)y*nx];
+						const double *u_m = &u[(std::size_t)y_m*nx];
+						const double *v_0 = &v[(std::size_t)y*nx];
+						const double *v_p = &v[(std::size_t)y_p*nx];
+
+						for (int b = by*bx, x = x_start-1; x < x_end+1; b++, x++)
+						{
+							// periodic columns
+							int x_0 = (x < 0 ? x+nx : (x >= nx ? x-nx : x));
+							int x_m = (x_0 == 0 ? nx-1 : x_0-1);
+							int x_p = (x_0 == nx-1 ? 0 : x_0+1);
+
+							// U = avg_b_x(h)*u, V = avg_b_y(h)*v
+							U[b] = 0.5*(h_0[x_m]+h_0[x_0])*u_0[x_0];
+							V[b] = 0.5*(h_m[x_0]+h_0[x_0])*v_0[x_0];
+
+							// H = g*h + 0.5*(avg_f_x(u*u) + avg_f_y(v*v))
+							H[b] = g*h_0[x_0] + 0.5*(
+									0.5*(u_0[x_0]*u_0[x_0] + u_0[x_p]*u_0[x_p]) +
+									0.5*(v_0[x_0]*v_0[x_0] + v_p[x_0]*v_p[x_0])
+								);
+
+							// q = (diff_b_x(v) - diff_b_y(u) + f) / avg_b_x(avg_b_y(h))
+							q[b] =	((v_0[x_0]-v_0[x_m])*inv_dx - (u_0[x_0]-u_m[x_0])*inv_dy + (f != nullptr ? f[(std::size_t)y*nx+x_0] : f0)) /
+									(0.25*(h_0[x_0] + h_m[x_0] + h_0[x_m] + h_m[x_m]));
+						}
+					}
+
+					/*
+					 * Tendencies of the tile
+					 */
+					for (int y = y_start; y < y_end; y++)
+					{
+						int b = (y-y_start+1)*bx + 1;
+						std::size_t idx = (std::size_t)y*nx + x_start;
+
+						for (int x = x_start; x < x_end; x++, b++, idx++)
+						{
+							// u_t = avg_f_y(q*avg_b_x(V)) - diff_b_x(H)
+							u_t[idx] =	0.5*(q[b]*0.5*(V[b-1]+V[b]) + q[b+bx]*0.5*(V[b+bx-1]+V[b+bx]))
+										- (H[b]-H[b-1])*inv_dx;
+
+							// v_t = -avg_f_x(q*avg_b_y(U)) - diff_b_y(H)
+							v_t[idx] =	-0.5*(q[b]*0.5*(U[b-bx]+U[b]) + q[b+1]*0.5*(U[b+1-bx]+U[b+1]))
+										- (H[b]-H[b-bx])*inv_dy;
+
+							// h_t = -diff_f_x(U) - diff_f_y(V)
+							h_t[idx] = -(U[b+1]-U[b])*inv_dx - (V[b+bx]-V[b])*inv_dy;
+
+							max_abs_h = std::max(max_abs_h, std::abs(h[idx]));
+							max_abs_u = std::max(max_abs_u, std::abs(u[idx]));
+							max_abs_v = std::max(max_abs_v, std::abs(v[idx]));
+						}
+					}
+				}
+			}
+		}
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		o_h_t.physical_space_data_valid = true;
+		o_h_t.spectral_space_data_valid = false;
+		o_u_t.physical_space_data_valid = true;
+		o_u_t.spectral_space_data_valid = false;
+		o_v_t.physical_space_data_valid = true;
+		o_v_t.spectral_space_data_valid = false;
+#endif
+
+		o_max_abs_h = max_abs_h;
+		o_max_abs_u = max_abs_u;
+		o_max_abs_v = max_abs_v;
+	}
+
+
+
 	/**
 	 * Compute derivative for time stepping and store it to
 	 * P_t, u_t and v_t
@@ -276,25 +496,27 @@ public:
 		 * V_t + q N x (P V) + grad( g P + 1/2 V*V) = 0
 		 * P_t + div(P V) = 0
 		 */
-		/*
-		 * U and V updates
-		 */
-		U = op.avg_b_x(i_h)*i_u;
-		V = op.avg_b_y(i_h)*i_v;
-
-		H = simVars.sim.gravitation*i_h + 0.5*(op.avg_f_x(i_u*i_u) + op.avg_f_y(i_v*i_v));
+		double max_abs_h = 0, max_abs_u = 0, max_abs_v = 0;
 
-		if (simVars.sim.beta != 0.0)
+		if (param_use_fused_kernel)
 		{
-			q = (op.diff_b_x(i_v) - op.diff_b_y(i_u) + beta_plane) / op.avg_b_x(op.avg_b_y(i_h));
+			// this also computes the standard P update
+			p_compute_tendencies_fused(
+					i_h, i_u, i_v,
+					o_h_t, o_u_t, o_v_t,
+					max_abs_h, max_abs_u, max_abs_v
+				);
 		}
 		else
 		{
-			q = (op.diff_b_x(i_v) - op.diff_b_y(i_u) + simVars.sim.f0) / op.avg_b_x(op.avg_b_y(i_h));
-		}
+			/*
+			 * U and V updates
+			 */
+			p_compute_fluxes_and_potentials(i_h, i_u, i_v);
 
-		o_u_t = op.avg_f_y(q*op.avg_b_x(V)) - op.diff_b_x(H);
-		o_v_t = -op.avg_f_x(q*op.avg_b_y(U)) - op.diff_b_y(H);
+			o_u_t = op.avg_f_y(q*op.avg_b_x(V)) - op.diff_b_x(H);
+			o_v_t = -op.avg_f_x(q*op.avg_b_y(U)) - op.diff_b_y(H);
+		}
 
 
 		/*
@@ -325,7 +547,14 @@ public:
 			}
 			else
 			{
-				double limit_speed = std::min(simVars.disc.cell_size[0]/i_u.reduce_maxAbs(), simVars.disc.cell_size[1]/i_v.reduce_maxAbs());
+				if (!param_use_fused_kernel)
+				{
+					max_abs_h = i_h.reduce_maxAbs();
+					max_abs_u = i_u.reduce_maxAbs();
+					max_abs_v = i_v.reduce_maxAbs();
+				}
+
+				double limit_speed = std::min(simVars.disc.cell_size[0]/max_abs_u, simVars.disc.cell_size[1]/max_abs_v);
 
 //				double hx = simVars.disc.cell_size[0];
 //				double hy = simVars.disc.cell_size[1];
@@ -340,7 +569,7 @@ public:
 #endif
 
 				// limit by gravitational acceleration
-				double limit_gh = std::min(simVars.disc.cell_size[0], simVars.disc.cell_size[1])/std::sqrt(simVars.sim.gravitation*i_h.reduce_maxAbs());
+				double limit_gh = std::min(simVars.disc.cell_size[0], simVars.disc.cell_size[1])/std::sqrt(simVars.sim.gravitation*max_abs_h);
 
 				if (simVars.misc.verbosity > 2)
 					std::cerr << "limit_speed: " << limit_speed << ", limit_visc: " << limit_visc << ", limit_gh: " << limit_gh << std::endl;
@@ -355,8 +584,9 @@ public:
 		 */
 		if (!simVars.disc.timestepping_up_and_downwinding)
 		{
-			// standard update
-			o_h_t = -op.diff_f_x(U) - op.diff_f_y(V);
+			// standard update (already computed by the fused kernel)
+			if (!param_use_fused_kernel)
+				o_h_t = -op.diff_f_x(U) - op.diff_f_y(V);
 		}
 		else
 		{
@@ -572,6 +802,11 @@ public:
 	)
 	{
 		int id = simVars.misc.vis_id % (sizeof(vis_arrays)/sizeof(*vis_arrays));
+
+		// the fused kernel only computes H, q, U and V in small per-thread buffers
+		if (param_use_fused_kernel && id >= 3)
+			p_compute_fluxes_and_potentials(prog_P, prog_u, prog_v);
+
 		*o_dataArray = vis_arrays[id].data;
 		*o_aspect_ratio = simVars.sim.domain_size[1] / simVars.sim.domain_size[0];
 	}
@@ -634,8 +869,23 @@ public:
 
 int main(int i_argc, char *i_argv[])
 {
-	if (!simVars.setupFromMainParameters(i_argc, i_argv))
+	// input parameter names (specific ones for this program)
+	const char *bogus_var_names[] = {
+			"use-fused-kernel",
+			nullptr
+	};
+
+	// default values for specific input (for general input see SimulationVariables.hpp)
+	// with spectral space, the operators are applied in spectral space including dealiasing
+	simVars.bogus.var[0] = (SWEET_USE_PLANE_SPECTRAL_SPACE ? 0 : 1);
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, bogus_var_names))
+	{
+		std::cout << "	--use-fused-kernel [0/1]	Compute tendencies with the fused kernel instead of the operators (default: 1 without plane spectral space)" << std::endl;
 		return -1;
+	}
+
+	param_use_fused_kernel = simVars.bogus.var[0];
 
 
 	planeDataConfigInstance.setupAuto(simVars.disc.res_physical, simVars.disc.res_spectral);
@@ -80,9 +80,13 @@ int main(int i_argc, char *i_argv[])
 		/////////////////////////////////////////////////////////
 		/////////////////////////////////////////////////////////
 
+		h.spectral_alloc_buffer();
 		for (std::size_t i = 0; i < planeDataConfig->spectral_array_data_number_of_elements; i++)
 			h.spectral_space_data[i] = {1.0,0.0};
 
+		h.spectral_space_data_valid = true;
+		h.physical_space_data_valid = false;
+
 		h = h.spectral_addScalarAll(1.0);
 #define PRINT_SPECCTRUM	0
 
@@ -0,0 +1,139 @@
+/*
+ * test_helmholtz_multigrid.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ *
+ * Test the matrix-free multigrid solver for the Helmholtz problem
+ *
+ * 	(kappa - gh0*D2) X = B
+ *
+ * with the 5-point finite-difference Laplacian. A single Fourier mode is an
+ * eigenfunction of the discrete Laplacian, hence the exact discrete solution is known.
+ */
+
+#if SWEET_GUI
+#	error	"GUI not supported"
+#endif
+
+#include <sweet/Stopwatch.hpp>
+#include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataHelmholtzMultigrid.hpp>
+#include <sweet/SimulationVariables.hpp>
+
+#include <cmath>
+#include <iostream>
+
+// Plane data config
+PlaneDataConfig planeDataConfigInstance;
+PlaneDataConfig *planeDataConfig = &planeDataConfigInstance;
+
+
+SimulationVariables simVars;
+
+
+int main(int i_argc, char *i_argv[])
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv))
+		return -1;
+
+	std::size_t res_x = simVars.disc.res_physical[0];
+	std::size_t res_y = simVars.disc.res_physical[1];
+
+	std::size_t max_res = 512;
+
+	if (res_x > max_res || res_y > max_res)
+		max_res = std::max(res_x, res_y);
+
+	double *domain_size = simVars.sim.domain_size;
+
+	for (; res_x <= max_res && res_y <= max_res; res_x *= 2, res_y *= 2)
+	{
+		std::cout << "*************************************************************" << std::endl;
+		std::cout << "Testing multigrid solver with resolution " << res_x << " x " << res_y << std::endl;
+		std::cout << "*************************************************************" << std::endl;
+
+		simVars.disc.res_physical[0] = res_x;
+		simVars.disc.res_physical[1] = res_y;
+		simVars.reset();
+
+		planeDataConfigInstance.setupAutoSpectralSpace(simVars.disc.res_physical);
+
+		double hx = domain_size[0]/(double)res_x;
+		double hy = domain_size[1]/(double)res_y;
+
+		// wave numbers of the Fourier mode
+		int kx = 2;
+		int ky = 3;
+
+		// eigenvalue of the 5-point Laplacian for this mode
+		double lambda =
+				-(2.0-2.0*std::cos(2.0*M_PI*kx*hx/domain_size[0]))/(hx*hx)
+				-(2.0-2.0*std::cos(2.0*M_PI*ky*hy/domain_size[1]))/(hy*hy);
+
+		PlaneData x_ana(planeDataConfig);
+		x_ana.physical_update_lambda_array_indices(
+			[&](int i, int j, double &io_data)
+			{
+				double x = (double)i*hx;
+				double y = (double)j*hy;
+				io_data = std::sin(2.0*M_PI*kx*x/domain_size[0])*std::cos(2.0*M_PI*ky*y/domain_size[1]);
+			}
+		);
+
+		/*
+		 * Test different ratios of kappa and gh0 similar to
+		 * implicit diffusion (Burgers) and implicit SWE time stepping
+		 */
+		double params[3][2] = {
+				{1.0, 1e-3},
+				{1.0, 1.0},
+				{1e2, 1e-2*domain_size[0]*domain_size[0]}
+		};
+
+		for (int smoother = 0; smoother < 2; smoother++)
+		{
+			PlaneDataHelmholtzMultigrid multigrid;
+			multigrid.setup(planeDataConfig, domain_size, (PlaneDataHelmholtzMultigrid::SmootherType)smoother);
+
+			for (int p = 0; p < 3; p++)
+			{
+				double kappa = params[p][0];
+				double gh0 = params[p][1];
+
+				PlaneData rhs = x_ana*(kappa - gh0*lambda);
+				PlaneData x(planeDataConfig);
+				x.physical_set_all(0);
+
+				Stopwatch watch;
+				watch.start();
+
+				bool converged = multigrid.solve(kappa, gh0, rhs, x, 1e-11, 50);
+
+				watch.stop();
+
+				double error = (x-x_ana).reduce_maxAbs();
+
+				std::cout << " + smoother " << smoother << ", kappa=" << kappa << ", gh0=" << gh0 << ": ";
+				std::cout << multigrid.last_num_vcycles << " V-cycles, ";
+				std::cout << "error " << error << ", " << watch() << " seconds" << std::endl;
+
+				if (!converged)
+				{
+					std::cerr << "Multigrid solver did not converge" << std::endl;
+					exit(1);
+				}
+
+				if (error > 1e-8)
+				{
+					std::cerr << "Error too large" << std::endl;
+					exit(1);
+				}
+			}
+		}
+	}
+
+	std::cout << "SUCCESSFULLY FINISHED" << std::endl;
+
+	return 0;
+}
@@ -57,5 +57,36 @@ int main(int argc, char *argv[])
 		MemBlockAlloc::free(data_a_1024[i], 1024);						// free a
 
 
+	////////////////////////////////////////////////////////////
+
+	/*
+	 * Large block which is first touched in parallel
+	 */
+	std::size_t large_size = 64*1024*1024;
+	double *data_large;
+	{
+		MemBlockAlloc::Tag tag("test_numa_memmanager/large_block");
+		data_large = MemBlockAlloc::alloc<double>(large_size);
+	}
+
+	std::vector<std::size_t> placement = MemBlockAlloc::getNumaPlacement(data_large, large_size);
+	for (std::size_t i = 0; i < placement.size(); i++)
+		std::cout << "Large block: " << placement[i] << " pages on NUMA node " << i << std::endl;
+
+	MemBlockAlloc::free(data_large, large_size);						// free large block
+
+
+	/*
+	 * All blocks are released (only available with NUMA_BLOCK_ALLOC_ACCOUNTING=1)
+	 */
+	MemBlockAlloc::printAccountingReport();
+
+	if (MemBlockAlloc::getAccountingTotal().live_bytes != 0)
+	{
+		std::cerr << "Memory accounting: live bytes after releasing all blocks" << std::endl;
+		return 1;
+	}
+
+
 	return 0;
 }
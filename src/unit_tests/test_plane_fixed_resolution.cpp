@@ -0,0 +1,136 @@
+/*
+ * test_plane_fixed_resolution.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ *
+ * Test that the loops specialized for fixed resolutions iterate
+ * over exactly the same indices as the generic loops.
+ */
+
+#if SWEET_GUI
+#	error	"GUI not supported"
+#endif
+
+// specialized resolutions for this test if not given at compile time
+#ifndef SWEET_PLANE_FIXED_RESOLUTIONS
+#	define SWEET_PLANE_FIXED_RESOLUTIONS	16,16,24,32
+#endif
+
+#include <sweet/plane/PlaneData.hpp>
+#include <sweet/plane/PlaneDataComplex.hpp>
+#include <sweet/SimulationVariables.hpp>
+
+#include <vector>
+#include <iostream>
+
+// Plane data config
+PlaneDataConfig planeDataConfigInstance;
+PlaneDataConfig *planeDataConfig = &planeDataConfigInstance;
+
+
+SimulationVariables simVars;
+
+
+/**
+ * Count the visits of each index by the dispatched and generic loops
+ */
+void check_visits(
+		const std::vector<int> &i_visits_dispatched,
+		const std::vector<int> &i_visits_generic,
+		const char *i_name
+)
+{
+	for (std::size_t i = 0; i < i_visits_generic.size(); i++)
+	{
+		if (i_visits_dispatched[i] != i_visits_generic[i] || i_visits_generic[i] > 1)
+		{
+			std::cerr << "Mismatch of " << i_name << " loops at index " << i << ": ";
+			std::cerr << i_visits_dispatched[i] << " vs. " << i_visits_generic[i] << std::endl;
+			exit(1);
+		}
+	}
+}
+
+
+
+int main(int i_argc, char *i_argv[])
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv))
+		return -1;
+
+	// specialized ones and one resolution using the generic loops
+	std::size_t resolutions[][2] = {{16, 16}, {24, 32}, {20, 20}};
+
+	for (auto &res : resolutions)
+	{
+		std::cout << "Testing resolution " << res[0] << " x " << res[1] << std::endl;
+
+		simVars.disc.res_physical[0] = res[0];
+		simVars.disc.res_physical[1] = res[1];
+		simVars.reset();
+
+		planeDataConfigInstance.setupAutoSpectralSpace(simVars.disc.res_physical);
+
+		auto dummy_fun = [](std::size_t) {};
+		bool specialized = PlaneDataFixedResolutions::physical_for_idx(planeDataConfig, dummy_fun);
+		std::cout << " + specialized: " << (specialized ? "yes" : "no") << std::endl;
+
+		{
+			std::vector<int> visits(planeDataConfig->physical_array_data_number_of_elements, 0);
+			std::vector<int> visits_generic(visits);
+
+			PLANE_DATA_PHYSICAL_FOR_IDX(visits[idx]++;);
+			PLANE_DATA_PHYSICAL_FOR_IDX_GENERIC(visits_generic[idx]++;);
+
+			check_visits(visits, visits_generic, "physical");
+		}
+
+#if SWEET_USE_PLANE_SPECTRAL_SPACE
+		{
+			std::vector<int> visits(planeDataConfig->spectral_array_data_number_of_elements, 0);
+			std::vector<int> visits_generic(visits);
+
+			PLANE_DATA_SPECTRAL_FOR_IDX(visits[idx]++;);
+			PLANE_DATA_SPECTRAL_FOR_IDX_GENERIC(visits_generic[idx]++;);
+
+			check_visits(visits, visits_generic, "spectral");
+		}
+#endif
+
+		{
+			std::vector<int> visits(planeDataConfig->spectral_complex_array_data_number_of_elements, 0);
+			std::vector<int> visits_generic(visits);
+
+			PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX(visits[idx]++;);
+			PLANE_DATA_COMPLEX_SPECTRAL_FOR_IDX_GENERIC(visits_generic[idx]++;);
+
+			check_visits(visits, visits_generic, "complex spectral");
+		}
+
+		/*
+		 * Compare results of operations
+		 */
+		PlaneData a(planeDataConfig);
+		a.physical_update_lambda_array_indices(
+			[&](int i, int j, double &io_data)
+			{
+				io_data = std::sin(2.0*M_PI*i/(double)res[0])*std::cos(4.0*M_PI*j/(double)res[1]);
+			}
+		);
+
+		PlaneData b = a*2.0 + a;
+		double error = (b - a*3.0).reduce_maxAbs();
+		std::cout << " + error of operations: " << error << std::endl;
+
+		if (error > 1e-12)
+		{
+			std::cerr << "Error too large" << std::endl;
+			exit(1);
+		}
+	}
+
+	std::cout << "SUCCESSFULLY FINISHED" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * test_sdc.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <M.Schreiber@exeter.ac.uk>
+ *
+ * Tests for the SDC sweeper and the PFASST controller based on the
+ * IMEX split scalar ODE
+ *
+ *   u_t = lambda_E u + lambda_I u
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <sdc/SDC_Nodes.hpp>
+#include <sdc/SDC_Sweeper.hpp>
+#include <sdc/PFASST_Controller_Serial.hpp>
+
+
+class ScalarProblem	:
+		public SDC_Problem<double>
+{
+public:
+	double lambda_E;
+	double lambda_I;
+
+	ScalarProblem(
+			double i_lambda_E,
+			double i_lambda_I
+	)	:
+		lambda_E(i_lambda_E),
+		lambda_I(i_lambda_I)
+	{
+	}
+
+	void eval_explicit(const double &i_u, double i_time, double &o_f)
+	{
+		o_f = lambda_E*i_u;
+	}
+
+	void eval_implicit(const double &i_u, double i_time, double &o_f)
+	{
+		o_f = lambda_I*i_u;
+	}
+
+	void solve_implicit(const double &i_rhs, double i_dt, double i_time, double &o_u, double &o_f)
+	{
+		o_u = i_rhs/(1.0 - i_dt*lambda_I);
+		o_f = lambda_I*o_u;
+	}
+
+	void set_zero(double &o_u)
+	{
+		o_u = 0;
+	}
+
+	void axpy(double i_a, const double &i_x, double &io_y)
+	{
+		io_y += i_a*i_x;
+	}
+
+	double norm(const double &i_u)
+	{
+		return std::abs(i_u);
+	}
+};
+
+
+class ScalarTransfer	:
+		public SDC_Transfer<double>
+{
+public:
+	void restrict(const double &i_fine, double &o_coarse)
+	{
+		o_coarse = i_fine;
+	}
+
+	void interpolate(const double &i_coarse, double &o_fine)
+	{
+		o_fine = i_coarse;
+	}
+};
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	double lambda_E = -0.5;
+	double lambda_I = -2.0;
+	double T = 1.0;
+
+	ScalarProblem problem(lambda_E, lambda_I);
+
+	double u_exact = std::exp((lambda_E+lambda_I)*T);
+
+	for (int node_type = 0; node_type < 2; node_type++)
+	{
+		/*
+		 * Check node-to-node integrals with polynomials of degree M-1
+		 */
+		for (int M = (node_type == 0 ? 2 : 1); M <= 7; M++)
+		{
+			SDC_Nodes nodes(M, (SDC_Nodes::NodeType)node_type);
+
+			for (int d = 0; d < M; d++)
+			{
+				double t_prev = 0;
+				for (int m = 0; m < M; m++)
+				{
+					double t = nodes.nodes[m];
+
+					double integral = 0;
+					for (int j = 0; j < M; j++)
+						integral += nodes.getS(m, j)*std::pow(nodes.nodes[j], d);
+
+					double exact = (std::pow(t, d+1) - std::pow(t_prev, d+1))/(double)(d+1);
+
+					if (std::abs(integral - exact) > 1e-13)
+					{
+						std::cerr << "Integration with " << M << " nodes of type " << node_type << " failed for degree " << d << std::endl;
+						exit(-1);
+					}
+
+					t_prev = t;
+				}
+			}
+		}
+		std::cout << "Node type " << node_type << ": integration matrices OK" << std::endl;
+
+
+		/*
+		 * Check convergence order of SDC with K sweeps
+		 */
+		int M = 3;
+		SDC_Nodes nodes(M, (SDC_Nodes::NodeType)node_type);
+
+		for (int K = 1; K <= 4; K++)
+		{
+			SDC_Sweeper<double> sweeper(0.0);
+			sweeper.setup(&problem, &nodes);
+
+			double prev_error = -1;
+			for (int num_steps = 16; num_steps <= 128; num_steps *= 2)
+			{
+				double dt = T/(double)num_steps;
+
+				double u = 1.0;
+				for (int n = 0; n < num_steps; n++)
+					sweeper.run_timestep(u, n*dt, dt, K);
+
+				double error = std::abs(u - u_exact);
+
+				if (prev_error > 0)
+				{
+					double order = std::log2(prev_error/error);
+					std::cout << "Node type " << node_type << ", sweeps " << K << ", steps " << num_steps << ": error " << error << ", order " << order << std::endl;
+
+					// Lobatto with 3 nodes has order 4 at most
+					int expected_order = std::min(K, 4);
+					if (order < (double)expected_order - 0.35)
+					{
+						std::cerr << "Convergence order of SDC too low" << std::endl;
+						exit(-1);
+					}
+				}
+
+				prev_error = error;
+			}
+		}
+
+
+		/*
+		 * Check that PFASST converges to the serial collocation solution
+		 */
+		{
+			int num_slices = 4;
+			double dt = T/(double)num_slices;
+
+			// collocation solution by running many sweeps
+			SDC_Sweeper<double> sweeper(0.0);
+			sweeper.setup(&problem, &nodes);
+
+			double u_coll = 1.0;
+			for (int n = 0; n < num_slices; n++)
+				sweeper.run_timestep(u_coll, n*dt, dt, 50);
+
+			for (int num_levels = 1; num_levels <= 2; num_levels++)
+			{
+				ScalarTransfer transfer;
+				double state = 0;
+
+				std::vector<SDC_Problem<double>*> problems(num_levels, &problem);
+				std::vector<SDC_Transfer<double>*> transfers(num_levels-1, &transfer);
+				std::vector<const double*> states(num_levels, &state);
+				std::vector<int> num_sweeps(num_levels, 1);
+
+				PFASST_Controller_Serial<double> pfasst;
+				pfasst.setup(problems, transfers, states, &nodes, num_sweeps, num_slices, 50, 1e-14);
+
+				double u = 1.0;
+				int iterations = pfasst.run(u, 0, dt);
+
+				double error = std::abs(u - u_coll);
+				std::cout << "Node type " << node_type << ", PFASST levels " << num_levels << ": " << iterations << " iterations, difference to collocation solution " << error << std::endl;
+
+				if (error > 1e-12)
+				{
+					std::cerr << "PFASST did not converge to collocation solution" << std::endl;
+					exit(-1);
+				}
+			}
+		}
+	}
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
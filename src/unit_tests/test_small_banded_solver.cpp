@@ -0,0 +1,328 @@
+/*
+ * test_small_banded_solver.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: agent <agent@local>
+ *
+ * Test the small bandwidth solver against the LAPACK solver
+ * in double and single precision and its fallback to LAPACK
+ * for blocks which require pivoting.
+ */
+
+#include <complex>
+#include <vector>
+#include <random>
+#include <limits>
+#include <cassert>
+#include <iostream>
+#include <cstdlib>
+
+#include <libmath/SmallBandedMatrixSolver.hpp>
+#include <libmath/LapackBandedMatrixSolver.hpp>
+
+
+typedef std::complex<double> complex;
+
+
+/**
+ * Banded matrix in the LAPACK band storage with KL additional rows for zgbtrf
+ */
+class TestMatrix
+{
+public:
+	int size;
+	int kl, ku;
+	int LDAB;
+	std::vector<complex> AB;
+
+	TestMatrix(int i_size, int i_halo)	:
+		size(i_size),
+		kl(i_halo),
+		ku(i_halo),
+		LDAB(2*i_halo+i_halo+1),
+		AB((std::size_t)LDAB*i_size, 0)
+	{
+	}
+
+	complex& operator()(int i, int j)
+	{
+		return AB[(kl+ku+i-j) + j*LDAB];
+	}
+};
+
+
+
+/**
+ * Setup a random diagonally dominant matrix with nonzero values
+ * only for the given offsets
+ */
+void setup_random_matrix(
+		TestMatrix &o_A,
+		const std::vector<int> &i_offsets,
+		std::mt19937 &io_gen
+)
+{
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+	for (int i = 0; i < o_A.size; i++)
+	{
+		double sum_abs = 0;
+
+		for (int d : i_offsets)
+		{
+			int j = i+d;
+			if (d == 0 || j < 0 || j >= o_A.size)
+				continue;
+
+			o_A(i,j) = complex(dist(io_gen), dist(io_gen));
+			sum_abs += std::abs(o_A(i,j));
+		}
+
+		o_A(i,i) = complex(sum_abs+1.0+std::abs(dist(io_gen)), dist(io_gen));
+	}
+}
+
+
+
+/**
+ * Solve with LAPACK as a reference
+ */
+void solve_lapack(
+		const TestMatrix &i_A,
+		const std::vector<complex> &i_b,
+		std::vector<complex> &o_x
+)
+{
+	std::vector<complex> lu(i_A.AB);
+	std::vector<int> ipiv(i_A.size);
+
+	if (!LapackBandedMatrixSolver<complex>::factorize_BandedLapackArray_inplace(lu.data(), i_A.LDAB, i_A.size, i_A.kl, i_A.ku, ipiv.data()))
+	{
+		std::cerr << "LAPACK failed to factorize matrix" << std::endl;
+		exit(1);
+	}
+
+	o_x = i_b;
+	LapackBandedMatrixSolver<complex>::solve_BandedLapackArray_factorized(lu.data(), i_A.LDAB, i_A.size, i_A.kl, i_A.ku, ipiv.data(), o_x.data());
+}
+
+
+
+/**
+ * Solve with the small bandwidth solver in the same way as
+ * SphBandedMatrixPhysicalComplex does, including the fallback to LAPACK
+ *
+ * The matrix and rhs are converted to the precision TSolver
+ * which is used for the factorization and the solve.
+ *
+ * \return true if the small bandwidth solver was used
+ */
+template <typename TSolver>
+bool solve_small(
+		const TestMatrix &i_A,
+		const std::vector<complex> &i_b,
+		std::vector<complex> &o_x
+)
+{
+	std::vector<TSolver> AB(i_A.AB.begin(), i_A.AB.end());
+	std::vector<TSolver> b(i_b.begin(), i_b.end());
+
+	int bandwidth = 0;
+	bool odd_coupling = false;
+	SmallBandedMatrixSolver<TSolver>::analyzeBlock(AB.data(), i_A.LDAB, i_A.kl, i_A.ku, i_A.size, bandwidth, odd_coupling);
+
+	int stride = (odd_coupling || bandwidth == 0) ? 1 : 2;
+	int chain_bandwidth = bandwidth/stride;
+
+	std::vector<TSolver> lu((std::size_t)i_A.size*(2*chain_bandwidth+1));
+	std::vector<TSolver> x(i_A.size);
+
+	if (!SmallBandedMatrixSolver<TSolver>::factorizeBlock(chain_bandwidth, AB.data(), i_A.LDAB, i_A.kl, i_A.ku, i_A.size, stride, lu.data()))
+	{
+		solve_lapack(i_A, i_b, o_x);
+		return false;
+	}
+
+	SmallBandedMatrixSolver<TSolver>::solveBlock(chain_bandwidth, lu.data(), i_A.size, stride, b.data(), x.data());
+
+	o_x.assign(x.begin(), x.end());
+	return true;
+}
+
+
+
+double max_rel_error(
+		const std::vector<complex> &i_x,
+		const std::vector<complex> &i_ref
+)
+{
+	double max_diff = 0;
+	double max_ref = 0;
+
+	for (std::size_t i = 0; i < i_x.size(); i++)
+	{
+		max_diff = std::max(max_diff, std::abs(i_x[i]-i_ref[i]));
+		max_ref = std::max(max_ref, std::abs(i_ref[i]));
+	}
+
+	return max_diff/max_ref;
+}
+
+
+
+double max_rel_residual(
+		const TestMatrix &i_A,
+		const std::vector<complex> &i_b,
+		const std::vector<complex> &i_x
+)
+{
+	std::vector<complex> r(i_A.size);
+	SmallBandedMatrixSolver<complex>::residualBlock(i_A.AB.data(), i_A.LDAB, i_A.kl, i_A.ku, i_A.size, i_b.data(), i_x.data(), r.data());
+
+	double max_r = 0;
+	double max_b = 0;
+	for (int i = 0; i < i_A.size; i++)
+	{
+		max_r = std::max(max_r, std::abs(r[i]));
+		max_b = std::max(max_b, std::abs(i_b[i]));
+	}
+
+	return max_r/max_b;
+}
+
+
+
+int main(int i_argc, char *i_argv[])
+{
+	std::mt19937 gen(12345);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+	double eps = 1e-12;
+	double eps_single = 1e-4;
+
+	/*
+	 * Offsets of nonzero values, e.g. {-2, 0, 2} for matrices
+	 * which only couple modes n and n+-2 (decoupled even and odd chains)
+	 */
+	std::vector<std::vector<int>> offsets_list = {
+			{0},
+			{-1, 0, 1},
+			{-2, -1, 0, 1, 2},
+			{-2, 0, 2},
+			{-4, -2, 0, 2, 4},
+			{-4, -3, -2, -1, 0, 1, 2, 3, 4},
+	};
+
+	for (int size : {1, 2, 5, 16, 63, 128})
+	{
+		for (auto &offsets : offsets_list)
+		{
+			std::cout << "Testing size " << size << " with offsets";
+			for (int d : offsets)
+				std::cout << " " << d;
+			std::cout << std::endl;
+
+			TestMatrix A(size, 4);
+			setup_random_matrix(A, offsets, gen);
+
+			std::vector<complex> b(size);
+			for (auto &v : b)
+				v = complex(dist(gen), dist(gen));
+
+			std::vector<complex> x_small, x_small_single, x_lapack;
+			bool small_used = solve_small<complex>(A, b, x_small);
+			bool small_single_used = solve_small< std::complex<float> >(A, b, x_small_single);
+			solve_lapack(A, b, x_lapack);
+
+			if (!small_used || !small_single_used)
+			{
+				std::cerr << "Small bandwidth solver failed for diagonally dominant matrix" << std::endl;
+				exit(1);
+			}
+
+			double error = max_rel_error(x_small, x_lapack);
+			std::cout << " + error to LAPACK: " << error << std::endl;
+
+			if (error > eps)
+			{
+				std::cerr << "Error too large" << std::endl;
+				exit(1);
+			}
+
+			double error_single = max_rel_error(x_small_single, x_lapack);
+			std::cout << " + error to LAPACK (single precision): " << error_single << std::endl;
+
+			if (error_single > eps_single)
+			{
+				std::cerr << "Error too large" << std::endl;
+				exit(1);
+			}
+		}
+	}
+
+
+	/*
+	 * Blocks which require pivoting: The first pivot is small, but the
+	 * matrix is well conditioned with pivoting. The small bandwidth solver
+	 * has to reject the block and the solution has to be computed by LAPACK.
+	 *
+	 * A pivot of 1e-15 is rejected as near-singular pivot.
+	 * A pivot of 1e-9 passes this test, but is rejected due to the
+	 * growth of the entries of U to about 1e9.
+	 */
+	for (double pivot : {1e-15, 1e-9})
+	for (auto &offsets : offsets_list)
+	{
+		if (offsets.size() == 1)
+			continue;
+
+		std::cout << "Testing pivot " << pivot << " with offsets";
+		for (int d : offsets)
+			std::cout << " " << d;
+		std::cout << std::endl;
+
+		int size = 32;
+		TestMatrix A(size, 4);
+		setup_random_matrix(A, offsets, gen);
+
+		// swap the role of the first row with the row coupled by the smallest offset
+		int d = offsets[offsets.size()/2+1];
+		A(0,0) = pivot;
+		A(0,d) = 1.0;
+		A(d,0) = 1.0;
+
+		std::vector<complex> b(size);
+		for (auto &v : b)
+			v = complex(dist(gen), dist(gen));
+
+		std::vector<complex> x;
+		bool small_used = solve_small<complex>(A, b, x);
+
+		if (small_used)
+		{
+			std::cerr << "Small bandwidth solver did not reject block which requires pivoting" << std::endl;
+			exit(1);
+		}
+
+		bool small_single_used = solve_small< std::complex<float> >(A, b, x);
+
+		if (small_single_used)
+		{
+			std::cerr << "Small bandwidth solver did not reject block which requires pivoting (single precision)" << std::endl;
+			exit(1);
+		}
+
+		double residual = max_rel_residual(A, b, x);
+		std::cout << " + residual of LAPACK fallback: " << residual << std::endl;
+
+		if (residual > eps)
+		{
+			std::cerr << "Residual too large" << std::endl;
+			exit(1);
+		}
+	}
+
+	std::cout << "SUCCESSFULLY FINISHED" << std::endl;
+
+	return 0;
+}
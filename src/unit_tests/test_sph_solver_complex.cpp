@@ -192,6 +192,32 @@ void run_tests()
 			errorCheck(x_numerical, x_result, "Test Zx = mu*Phi(lam,mu) + a*Phi(lam,mu)", epsilon);
 		}
 
+		/*
+		 * Test Zx = mu*Phi(lam,mu) + a*Phi(lam,mu) with LU decomposition in single precision
+		 */
+		if (true)
+		{
+			SphBandedMatrixPhysicalComplex<std::complex<double>, std::complex<float>> sphSolver;
+			sphSolver.setup(sphereDataConfig, 2);
+
+			sphSolver.solver_component_scalar_phi(alpha);
+			sphSolver.solver_component_mu_phi();
+
+			SphereDataComplex b(sphereDataConfig);
+			b.physical_update_lambda_gaussian_grid(
+					[&](double lat, double mu, std::complex<double> &io_data)
+					{
+						double fun;
+						testSolutions.test_function__grid_gaussian(lat,mu,fun);
+
+						io_data = mu*fun+alpha*fun;
+					}
+			);
+
+			SphereDataComplex x_numerical = sphSolver.solve(b);
+			errorCheck(x_numerical, x_result, "Test Zx = mu*Phi(lam,mu) + a*Phi(lam,mu) (single precision LU)", epsilon);
+		}
+
 		/*
 		 * Test Zx = (1-mu*mu)*d/dmu Phi(lam,mu) + a*Phi(lam,mu)
 		 */